@@ -0,0 +1,284 @@
+#include "BenchmarkRunner.h"
+
+#include "megaapi.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QEventLoop>
+#include <QJsonArray>
+#include <QSysInfo>
+#include <QThread>
+
+#include <algorithm>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+constexpr int WAIT_POLL_INTERVAL_MS = 1;
+constexpr double NS_PER_MS = 1000000.0;
+}
+
+GuiStallProbe::GuiStallProbe(QObject* parent):
+    QObject(parent),
+    mLastTickNs(0)
+{
+    mTimer.setTimerType(Qt::PreciseTimer);
+    mTimer.setInterval(INTERVAL_MS);
+    connect(&mTimer, &QTimer::timeout, this, &GuiStallProbe::onTimeout);
+}
+
+void GuiStallProbe::start()
+{
+    mStalls.clear();
+    mElapsedTimer.start();
+    mLastTickNs = 0;
+    mTimer.start();
+}
+
+void GuiStallProbe::stop()
+{
+    mTimer.stop();
+}
+
+const QVector<double>& GuiStallProbe::getStalls() const
+{
+    return mStalls;
+}
+
+void GuiStallProbe::onTimeout()
+{
+    const auto now(mElapsedTimer.nsecsElapsed());
+    const double delayMs(static_cast<double>(now - mLastTickNs) / NS_PER_MS - INTERVAL_MS);
+    mStalls.append(std::max(delayMs, 0.0));
+    mLastTickNs = now;
+}
+
+BenchmarkContext::BenchmarkContext(const QString& name, const QJsonObject& parameterOverrides):
+    mName(name),
+    mParameterOverrides(parameterOverrides),
+    mElapsedNs(0),
+    mEvents(0)
+{
+}
+
+int BenchmarkContext::getParameter(const QString& name, int defaultValue)
+{
+    auto value(mParameterOverrides.value(mName + QLatin1Char('.') + name));
+    if (value.isUndefined())
+    {
+        value = mParameterOverrides.value(name);
+    }
+
+    const int parameter(value.toInt(defaultValue));
+    mParameters.insert(name, parameter);
+    return parameter;
+}
+
+void BenchmarkContext::start()
+{
+    mEvents = 0;
+    mElapsedNs = 0;
+    mProbe.start();
+    mTimer.start();
+}
+
+void BenchmarkContext::stop()
+{
+    if (mTimer.isValid())
+    {
+        mElapsedNs = mTimer.nsecsElapsed();
+        mTimer.invalidate();
+        mProbe.stop();
+    }
+}
+
+void BenchmarkContext::addEvents(qint64 count)
+{
+    mEvents += count;
+}
+
+void BenchmarkContext::setMetric(const QString& name, double value)
+{
+    mMetrics.insert(name, value);
+}
+
+bool BenchmarkContext::waitUntil(const std::function<bool()>& condition, int timeoutMs)
+{
+    if (condition())
+    {
+        return true;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    bool timedOut(false);
+
+    QEventLoop loop;
+    QTimer pollTimer;
+    pollTimer.setInterval(WAIT_POLL_INTERVAL_MS);
+    QObject::connect(&pollTimer,
+                     &QTimer::timeout,
+                     &loop,
+                     [&]()
+                     {
+                         if (condition())
+                         {
+                             loop.quit();
+                         }
+                         else if (timer.hasExpired(timeoutMs))
+                         {
+                             timedOut = true;
+                             loop.quit();
+                         }
+                     });
+    pollTimer.start();
+    loop.exec();
+
+    if (timedOut)
+    {
+        fail(QString::fromLatin1("Timed out after %1 ms").arg(timeoutMs));
+    }
+
+    return !timedOut;
+}
+
+void BenchmarkContext::fail(const QString& error)
+{
+    // The first error is the meaningful one
+    if (mError.isEmpty())
+    {
+        mError = error;
+    }
+}
+
+bool BenchmarkContext::hasFailed() const
+{
+    return !mError.isEmpty();
+}
+
+QJsonObject BenchmarkContext::toJson() const
+{
+    const double elapsedMs(static_cast<double>(mElapsedNs) / NS_PER_MS);
+    const auto& stalls(mProbe.getStalls());
+
+    QJsonObject result;
+    result.insert(QLatin1String("name"), mName);
+    result.insert(QLatin1String("status"),
+                  hasFailed() ? QLatin1String("failed") : QLatin1String("passed"));
+    if (hasFailed())
+    {
+        result.insert(QLatin1String("error"), mError);
+    }
+    result.insert(QLatin1String("parameters"), mParameters);
+    result.insert(QLatin1String("events"), mEvents);
+    result.insert(QLatin1String("elapsedMs"), elapsedMs);
+    result.insert(QLatin1String("eventsPerSecond"),
+                  elapsedMs > 0.0 ? static_cast<double>(mEvents) * 1000.0 / elapsedMs : 0.0);
+    result.insert(QLatin1String("guiStallP50Ms"), percentile(stalls, 0.5));
+    result.insert(QLatin1String("guiStallP99Ms"), percentile(stalls, 0.99));
+    result.insert(QLatin1String("guiStallMaxMs"),
+                  stalls.isEmpty() ? 0.0 : *std::max_element(stalls.begin(), stalls.end()));
+    result.insert(QLatin1String("peakRssKb"), BenchmarkRunner::getPeakRssKb());
+    result.insert(QLatin1String("metrics"), mMetrics);
+
+    return result;
+}
+
+double BenchmarkContext::percentile(QVector<double> values, double fraction)
+{
+    if (values.isEmpty())
+    {
+        return 0.0;
+    }
+
+    auto position(values.begin() + static_cast<int>(fraction * (values.size() - 1) + 0.5));
+    std::nth_element(values.begin(), position, values.end());
+    return *position;
+}
+
+void BenchmarkRunner::add(const QString& name, const QString& description, Function function)
+{
+    mBenchmarks.append({name, description, std::move(function)});
+}
+
+QStringList BenchmarkRunner::getNames() const
+{
+    QStringList names;
+    for (const auto& benchmark: mBenchmarks)
+    {
+        names.append(benchmark.name);
+    }
+    return names;
+}
+
+QJsonObject BenchmarkRunner::run(const QString& filter, const QJsonObject& parameterOverrides) const
+{
+    QJsonArray results;
+    for (const auto& benchmark: mBenchmarks)
+    {
+        if (!filter.isEmpty() && !benchmark.name.contains(filter))
+        {
+            continue;
+        }
+
+        mega::MegaApi::log(mega::MegaApi::LOG_LEVEL_INFO,
+                           QString::fromUtf8("Running benchmark %1")
+                               .arg(benchmark.name)
+                               .toUtf8()
+                               .constData());
+
+        BenchmarkContext context(benchmark.name, parameterOverrides);
+        benchmark.function(context);
+        // In case the benchmark returned early
+        context.stop();
+
+        auto result(context.toJson());
+        result.insert(QLatin1String("description"), benchmark.description);
+        results.append(result);
+
+        // Objects deleted later by the benchmark are gone before the next one starts
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+
+    QJsonObject report;
+    report.insert(QLatin1String("formatVersion"), 1);
+    report.insert(QLatin1String("timestamp"),
+                  QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    report.insert(QLatin1String("platform"), QSysInfo::prettyProductName());
+    report.insert(QLatin1String("cpuArchitecture"), QSysInfo::currentCpuArchitecture());
+    report.insert(QLatin1String("cpuCount"), QThread::idealThreadCount());
+    report.insert(QLatin1String("qtVersion"), QString::fromLatin1(qVersion()));
+    report.insert(QLatin1String("benchmarks"), results);
+
+    return report;
+}
+
+long long BenchmarkRunner::getPeakRssKb()
+{
+#ifdef Q_OS_WIN
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return static_cast<long long>(counters.PeakWorkingSetSize / 1024);
+    }
+    return -1;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return -1;
+    }
+#ifdef Q_OS_MACOS
+    // In bytes on macOS
+    return static_cast<long long>(usage.ru_maxrss / 1024);
+#else
+    return static_cast<long long>(usage.ru_maxrss);
+#endif
+#endif
+}
@@ -0,0 +1,105 @@
+#ifndef BENCHMARKRUNNER_H
+#define BENCHMARKRUNNER_H
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+
+#include <functional>
+
+// Measures how late the GUI event loop serves a high frequency timer. While the GUI thread is busy
+// the timer cannot fire, so each delay is the length of a stall
+class GuiStallProbe: public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit GuiStallProbe(QObject* parent = nullptr);
+
+    void start();
+    void stop();
+    // Delays in milliseconds, one per timer tick
+    const QVector<double>& getStalls() const;
+
+    static constexpr int INTERVAL_MS = 5;
+
+private slots:
+    void onTimeout();
+
+private:
+    QTimer mTimer;
+    QElapsedTimer mElapsedTimer;
+    qint64 mLastTickNs;
+    QVector<double> mStalls;
+};
+
+// State and results of a running benchmark
+class BenchmarkContext
+{
+public:
+    BenchmarkContext(const QString& name, const QJsonObject& parameterOverrides);
+
+    // Benchmark parameters have a default value, which can be overridden from the command line
+    // as "<benchmark>.<parameter>" or just "<parameter>". The values used are part of the report
+    int getParameter(const QString& name, int defaultValue);
+
+    // Only the time between start and stop is measured
+    void start();
+    void stop();
+    void addEvents(qint64 count);
+    void setMetric(const QString& name, double value);
+
+    // Processes GUI events until the condition is true. Fails the benchmark on timeout
+    bool waitUntil(const std::function<bool()>& condition, int timeoutMs = DEFAULT_TIMEOUT_MS);
+    void fail(const QString& error);
+    bool hasFailed() const;
+
+    QJsonObject toJson() const;
+
+    static constexpr int DEFAULT_TIMEOUT_MS = 600000;
+
+private:
+    static double percentile(QVector<double> values, double fraction);
+
+    QString mName;
+    QJsonObject mParameterOverrides;
+    QJsonObject mParameters;
+    QJsonObject mMetrics;
+    GuiStallProbe mProbe;
+    QElapsedTimer mTimer;
+    qint64 mElapsedNs;
+    qint64 mEvents;
+    QString mError;
+};
+
+// Registered benchmarks, run in order
+class BenchmarkRunner
+{
+public:
+    using Function = std::function<void(BenchmarkContext&)>;
+
+    void add(const QString& name, const QString& description, Function function);
+    QStringList getNames() const;
+
+    // Runs the benchmarks whose name contains the filter and returns the report
+    QJsonObject run(const QString& filter, const QJsonObject& parameterOverrides) const;
+
+    // Process-wide, so running a single benchmark gives its own peak
+    static long long getPeakRssKb();
+
+private:
+    struct Benchmark
+    {
+        QString name;
+        QString description;
+        Function function;
+    };
+
+    QVector<Benchmark> mBenchmarks;
+};
+
+#endif // BENCHMARKRUNNER_H
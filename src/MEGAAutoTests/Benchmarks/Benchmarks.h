@@ -0,0 +1,18 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include "BenchmarkRunner.h"
+
+// Each area registers its benchmarks, which are run in this order
+void registerStartupBenchmarks(BenchmarkRunner& runner);
+void registerTokenizerBenchmarks(BenchmarkRunner& runner);
+void registerTransfersBenchmarks(BenchmarkRunner& runner);
+void registerStalledIssuesBenchmarks(BenchmarkRunner& runner);
+void registerNodeSelectorBenchmarks(BenchmarkRunner& runner);
+void registerSyncsBenchmarks(BenchmarkRunner& runner);
+void registerExtServerBenchmarks(BenchmarkRunner& runner);
+void registerHTTPServerBenchmarks(BenchmarkRunner& runner);
+void registerLoggerBenchmarks(BenchmarkRunner& runner);
+void registerBugReportBenchmarks(BenchmarkRunner& runner);
+
+#endif // BENCHMARKS_H
@@ -0,0 +1,115 @@
+#include "Benchmarks.h"
+#include "EventGenerators.h"
+#include "LogBundleBuilder.h"
+#include "MegaApplication.h"
+
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+namespace
+{
+constexpr qint64 MEGABYTE = 1024 * 1024;
+
+// Builds the staged bundle and waits for it. Returns the bundle path, null if it failed or was
+// cancelled
+QString buildBundle(BenchmarkContext& context, LogBundleBuilder& builder)
+{
+    bool finished(false);
+    QString bundlePath;
+    auto connection(QObject::connect(&builder,
+                                     &LogBundleBuilder::finished,
+                                     [&finished, &bundlePath](QString path)
+                                     {
+                                         bundlePath = path;
+                                         finished = true;
+                                     }));
+
+    builder.buildAsync();
+    if (!context.waitUntil(
+            [&finished]()
+            {
+                return finished;
+            }))
+    {
+        context.fail(QLatin1String("The log bundle was not built"));
+    }
+
+    QObject::disconnect(connection);
+    return bundlePath;
+}
+}
+
+void registerBugReportBenchmarks(BenchmarkRunner& runner)
+{
+    runner.add(QLatin1String("bug_report.log_packaging"),
+               QLatin1String("Staged log bundle for a bug report, from scratch and resumed"),
+               [](BenchmarkContext& context)
+               {
+                   const qint64 totalBytes(context.getParameter(QLatin1String("sizeMb"), 2048) *
+                                           MEGABYTE);
+                   const qint64 fileBytes(context.getParameter(QLatin1String("fileMb"), 50) *
+                                          MEGABYTE);
+                   const auto seed(
+                       static_cast<unsigned int>(context.getParameter(QLatin1String("seed"), 1)));
+
+                   QTemporaryDir logsFolder;
+                   if (!logsFolder.isValid())
+                   {
+                       context.fail(QLatin1String("Unable to create the logs folder"));
+                       return;
+                   }
+                   const auto logBytes(EventGenerators::createLogFiles(logsFolder.path(),
+                                                                       totalBytes,
+                                                                       fileBytes,
+                                                                       seed));
+
+                   LogBundleBuilder builder(MegaSyncApp->getMegaApi());
+                   builder.setLogsFolder(logsFolder.path());
+
+                   // From scratch
+                   context.start();
+                   const auto bundlePath(buildBundle(context, builder));
+                   context.stop();
+                   context.addEvents(logBytes);
+
+                   if (QFileInfo(bundlePath).size() != logBytes)
+                   {
+                       context.fail(QString::fromLatin1("Bundle of %1 bytes for %2 bytes of logs")
+                                        .arg(QFileInfo(bundlePath).size())
+                                        .arg(logBytes));
+                       return;
+                   }
+
+                   // Cancelled half way, as the user would, and resumed
+                   builder.discardStaging();
+                   const auto connection(QObject::connect(
+                       &builder,
+                       &LogBundleBuilder::progressUpdated,
+                       &builder,
+                       [&builder](int permil)
+                       {
+                           if (permil >= LogBundleBuilder::MAXIMUM_PERMIL / 2)
+                           {
+                               builder.cancel();
+                           }
+                       },
+                       Qt::DirectConnection));
+                   buildBundle(context, builder);
+                   QObject::disconnect(connection);
+
+                   QElapsedTimer resumeTimer;
+                   resumeTimer.start();
+                   const auto resumedBundlePath(buildBundle(context, builder));
+                   const auto resumeMs(resumeTimer.elapsed());
+
+                   if (QFileInfo(resumedBundlePath).size() != logBytes)
+                   {
+                       context.fail(QLatin1String("The resumed bundle is not complete"));
+                   }
+                   builder.discardStaging();
+
+                   context.setMetric(QLatin1String("logBytes"), static_cast<double>(logBytes));
+                   context.setMetric(QLatin1String("resumeMs"), static_cast<double>(resumeMs));
+               });
+}
@@ -0,0 +1,215 @@
+#include "EventGenerators.h"
+
+#include <QDir>
+#include <QFile>
+#include <QRandomGenerator>
+#include <QVector>
+
+#include <algorithm>
+
+using namespace mega;
+
+namespace
+{
+const char* const WORDS[] = {"report", "holiday", "invoice", "backup", "draft", "scan",
+                             "budget",  "photo",   "notes",   "final",  "copy",  "archive"};
+// Cover the file types the app tells apart
+const char* const EXTENSIONS[] = {"txt", "pdf", "jpg", "png", "mp4", "mp3", "docx", "xlsx",
+                                  "zip", "psd", "cpp", "7z",  "dwg", "svg", "ods"};
+constexpr int FOLDERS_PER_LEVEL = 20;
+constexpr int FOLDER_LEVELS = 3;
+// Share of the generated nodes that are folders
+constexpr int FOLDER_PERCENTAGE = 10;
+constexpr int64_t BASE_TIME = 1700000000;
+
+template<class T, size_t N>
+const T& pick(QRandomGenerator& random, const T (&values)[N])
+{
+    return values[random.bounded(static_cast<quint32>(N))];
+}
+
+std::string createFileName(QRandomGenerator& random, int index)
+{
+    return std::string(pick(random, WORDS)) + "_" + std::to_string(index) + "." +
+           pick(random, EXTENSIONS);
+}
+
+std::string createFolderPath(QRandomGenerator& random)
+{
+    std::string path;
+    for (int level = 0; level < FOLDER_LEVELS; ++level)
+    {
+        path += "/" + std::string(pick(random, WORDS)) +
+                std::to_string(random.bounded(FOLDERS_PER_LEVEL));
+    }
+    return path;
+}
+}
+
+std::vector<EventGenerators::TransferEvent>
+    EventGenerators::createTransferStorm(const TransferStormOptions& options)
+{
+    QRandomGenerator random(options.seed);
+    std::vector<TransferEvent> events;
+    events.reserve(static_cast<size_t>(options.transfers) *
+                   static_cast<size_t>(options.updatesPerTransfer + 1));
+
+    long long notificationNumber(0);
+    std::vector<std::shared_ptr<FakeTransfer>> transfers;
+    transfers.reserve(static_cast<size_t>(options.transfers));
+
+    for (int index = 0; index < options.transfers; ++index)
+    {
+        auto transfer(std::make_shared<FakeTransfer>());
+        const bool upload(static_cast<int>(random.bounded(100)) < options.uploadPercentage);
+        transfer->type = upload ? MegaTransfer::TYPE_UPLOAD : MegaTransfer::TYPE_DOWNLOAD;
+        transfer->tag = options.firstTag + index;
+        transfer->fileName = createFileName(random, index);
+        transfer->parentPath = "/home/benchmark" + createFolderPath(random) + "/";
+        transfer->path = transfer->parentPath + transfer->fileName;
+        transfer->nodeHandle = static_cast<MegaHandle>(transfer->tag);
+        transfer->parentHandle = static_cast<MegaHandle>(random.generate64() >> 16);
+        transfer->totalBytes = 1 + static_cast<long long>(random.bounded(
+                                       static_cast<double>(std::max(options.maxFileSize, 1LL))));
+        transfer->priority = static_cast<unsigned long long>(index + 1) << 16;
+        transfer->startTime = BASE_TIME + index / 100;
+        transfer->updateTime = transfer->startTime;
+        transfer->notificationNumber = ++notificationNumber;
+
+        events.push_back({TransferEvent::Type::START, std::make_shared<FakeTransfer>(*transfer)});
+        transfers.push_back(transfer);
+    }
+
+    std::vector<size_t> order(transfers.size());
+    for (size_t index = 0; index < order.size(); ++index)
+    {
+        order[index] = index;
+    }
+
+    for (int round = 1; round <= options.updatesPerTransfer; ++round)
+    {
+        std::shuffle(order.begin(), order.end(), random);
+
+        for (auto index: order)
+        {
+            auto& transfer(transfers[index]);
+            const auto transferredBytes(transfer->totalBytes * round / options.updatesPerTransfer);
+
+            transfer->state = MegaTransfer::STATE_ACTIVE;
+            transfer->deltaSize = transferredBytes - transfer->transferredBytes;
+            transfer->transferredBytes = transferredBytes;
+            transfer->speed = 1024 * (1 + static_cast<long long>(random.bounded(10 * 1024)));
+            transfer->meanSpeed = (transfer->meanSpeed * (round - 1) + transfer->speed) / round;
+            transfer->updateTime = transfer->startTime + round;
+            transfer->notificationNumber = ++notificationNumber;
+
+            events.push_back(
+                {TransferEvent::Type::UPDATE, std::make_shared<FakeTransfer>(*transfer)});
+        }
+    }
+
+    return events;
+}
+
+std::unique_ptr<FakeSyncStallMap>
+    EventGenerators::createStallMap(int syncs, int stallsPerSync, unsigned int seed)
+{
+    QRandomGenerator random(seed);
+    auto map(std::make_unique<FakeSyncStallMap>());
+
+    for (int sync = 0; sync < syncs; ++sync)
+    {
+        FakeSyncStallList list;
+        const std::string root("/home/benchmark/sync" + std::to_string(sync));
+
+        for (int index = 0; index < stallsPerSync; ++index)
+        {
+            auto stall(std::make_shared<FakeSyncStall>());
+            stall->stallReason = MegaSyncStall::FileIssue;
+            stall->localPaths.push_back(root + createFolderPath(random) + "/" +
+                                        createFileName(random, index));
+            stall->localPathProblems.push_back(MegaSyncStall::FilesystemErrorDuringOperation);
+            list.stalls.push_back(stall);
+        }
+
+        map->listsBySync.emplace_back(static_cast<MegaHandle>(sync + 1), std::move(list));
+    }
+
+    return map;
+}
+
+QList<std::shared_ptr<MegaNode>> EventGenerators::createNodes(int count, unsigned int seed)
+{
+    QRandomGenerator random(seed);
+    QList<std::shared_ptr<MegaNode>> nodes;
+    nodes.reserve(count);
+
+    for (int index = 0; index < count; ++index)
+    {
+        auto node(std::make_shared<FakeNode>());
+        const bool folder(static_cast<int>(random.bounded(100)) < FOLDER_PERCENTAGE);
+        node->type = folder ? MegaNode::TYPE_FOLDER : MegaNode::TYPE_FILE;
+        node->name = folder ? std::string(pick(random, WORDS)) + std::to_string(index) :
+                              createFileName(random, index);
+        node->handle = static_cast<MegaHandle>(index + 1);
+        node->parentHandle = static_cast<MegaHandle>(random.generate64() >> 16);
+        node->size = folder ? 0 : static_cast<int64_t>(random.bounded(1 << 30));
+        node->creationTime = BASE_TIME + static_cast<int64_t>(random.bounded(1 << 24));
+        node->modificationTime = node->creationTime;
+        nodes.append(node);
+    }
+
+    return nodes;
+}
+
+QStringList EventGenerators::createLocalPaths(const QString& root, int count, unsigned int seed)
+{
+    QRandomGenerator random(seed);
+    QStringList paths;
+    paths.reserve(count);
+
+    for (int index = 0; index < count; ++index)
+    {
+        paths.append(root +
+                     QString::fromStdString(createFolderPath(random) + "/" +
+                                            createFileName(random, index)));
+    }
+
+    return paths;
+}
+
+qint64 EventGenerators::createLogFiles(const QString& folder,
+                                       qint64 totalBytes,
+                                       qint64 fileBytes,
+                                       unsigned int seed)
+{
+    constexpr qint64 CHUNK_SIZE = 1024 * 1024;
+
+    QRandomGenerator random(seed);
+    QVector<quint32> chunk(static_cast<int>(CHUNK_SIZE / sizeof(quint32)));
+    qint64 writtenBytes(0);
+
+    for (int number = 0; writtenBytes < totalBytes && fileBytes > 0; ++number)
+    {
+        QFile logFile(QDir(folder).filePath(QString::fromLatin1("MEGAsync.%1.log").arg(number)));
+        if (!logFile.open(QIODevice::WriteOnly))
+        {
+            break;
+        }
+
+        const auto logBytes(std::min(fileBytes, totalBytes - writtenBytes));
+        for (qint64 fileWritten = 0; fileWritten < logBytes;)
+        {
+            random.fillRange(chunk.data(), chunk.size());
+            const auto bytes(std::min(CHUNK_SIZE, logBytes - fileWritten));
+            if (logFile.write(reinterpret_cast<const char*>(chunk.constData()), bytes) != bytes)
+            {
+                return writtenBytes + fileWritten;
+            }
+            fileWritten += bytes;
+        }
+        writtenBytes += logBytes;
+    }
+
+    return writtenBytes;
+}
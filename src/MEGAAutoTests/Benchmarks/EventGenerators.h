@@ -0,0 +1,62 @@
+#ifndef EVENTGENERATORS_H
+#define EVENTGENERATORS_H
+
+#include "FakeMegaObjects.h"
+
+#include <QList>
+#include <QStringList>
+
+#include <memory>
+#include <vector>
+
+// Synthetic SDK events and objects for the benchmarks. Everything is generated from a seed, so two
+// runs with the same parameters replay exactly the same script
+class EventGenerators
+{
+public:
+    struct TransferEvent
+    {
+        enum class Type
+        {
+            START,
+            UPDATE
+        };
+
+        Type type;
+        // Snapshot of the transfer as the SDK would report it in this event
+        std::shared_ptr<FakeTransfer> transfer;
+    };
+
+    struct TransferStormOptions
+    {
+        int transfers = 10000;
+        int updatesPerTransfer = 10;
+        int uploadPercentage = 50;
+        long long maxFileSize = 100 * 1024 * 1024;
+        int firstTag = 1;
+        unsigned int seed = 1;
+    };
+
+    // The transfers are started in order, then they are updated in rounds, in a different order on
+    // each round, until all of them are transferred
+    static std::vector<TransferEvent> createTransferStorm(const TransferStormOptions& options);
+
+    // File issues with one local path, spread among the syncs
+    static std::unique_ptr<FakeSyncStallMap>
+        createStallMap(int syncs, int stallsPerSync, unsigned int seed);
+
+    // Files and folders, as the SDK returns them for a search
+    static QList<std::shared_ptr<mega::MegaNode>> createNodes(int count, unsigned int seed);
+
+    // Absolute local paths of files in a few levels of folders
+    static QStringList createLocalPaths(const QString& root, int count, unsigned int seed);
+
+    // Rotated logs (MEGAsync.N.log) of random content in the folder, all of them of fileBytes
+    // but the last one. Returns the bytes written
+    static qint64 createLogFiles(const QString& folder,
+                                 qint64 totalBytes,
+                                 qint64 fileBytes,
+                                 unsigned int seed);
+};
+
+#endif // EVENTGENERATORS_H
@@ -0,0 +1,138 @@
+#include "Benchmarks.h"
+
+#ifdef Q_OS_LINUX
+#include "EventGenerators.h"
+#include "ExtServer.h"
+
+#include <QDir>
+#include <QLocalSocket>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr int REQUEST_TIMEOUT_MS = 5000;
+// Separates the path from the "force state" flag in the state requests
+constexpr char ASCII_FILE_SEP = 0x1C;
+
+// Sends state requests one after another, as a file manager showing a folder does. Returns the
+// latency of each request in microseconds, or an empty list if the connection failed
+std::vector<double> sendStateRequests(const QString& socketPath, const QStringList& paths)
+{
+    std::vector<double> latencies;
+    QLocalSocket socket;
+    socket.connectToServer(socketPath);
+    if (!socket.waitForConnected(REQUEST_TIMEOUT_MS))
+    {
+        return latencies;
+    }
+
+    latencies.reserve(static_cast<size_t>(paths.size()));
+    QElapsedTimer timer;
+    for (const auto& path: paths)
+    {
+        const auto request(QByteArray("P:") + path.toUtf8() + ASCII_FILE_SEP + "0\n");
+
+        timer.start();
+        socket.write(request);
+        if (!socket.waitForBytesWritten(REQUEST_TIMEOUT_MS))
+        {
+            return {};
+        }
+        while (!socket.canReadLine())
+        {
+            if (!socket.waitForReadyRead(REQUEST_TIMEOUT_MS))
+            {
+                return {};
+            }
+        }
+        socket.readLine();
+        latencies.push_back(static_cast<double>(timer.nsecsElapsed()) / 1000.0);
+    }
+
+    return latencies;
+}
+}
+
+void registerExtServerBenchmarks(BenchmarkRunner& runner)
+{
+    runner.add(QLatin1String("ext_server.state_requests"),
+               QLatin1String("Overlay icon state requests of concurrent clients to ExtServer"),
+               [](BenchmarkContext& context)
+               {
+                   const int clients(
+                       std::max(context.getParameter(QLatin1String("clients"), 4), 1));
+                   const int requestsPerClient(
+                       context.getParameter(QLatin1String("requestsPerClient"), 5000));
+                   const auto seed(
+                       static_cast<unsigned int>(context.getParameter(QLatin1String("seed"), 1)));
+                   const auto paths(EventGenerators::createLocalPaths(QDir::homePath(),
+                                                                      clients * requestsPerClient,
+                                                                      seed));
+
+                   ExtServer server(MegaSyncApp);
+                   const QString socketPath(MegaApplication::applicationDataPath() +
+                                            QDir::separator() +
+                                            QString::fromLatin1("mega.socket"));
+
+                   std::vector<std::vector<double>> latencies(static_cast<size_t>(clients));
+                   std::vector<std::thread> threads;
+                   std::atomic<int> finishedClients(0);
+
+                   context.start();
+                   for (int client = 0; client < clients; ++client)
+                   {
+                       threads.emplace_back(
+                           [&, client]()
+                           {
+                               latencies[static_cast<size_t>(client)] = sendStateRequests(
+                                   socketPath,
+                                   paths.mid(client * requestsPerClient, requestsPerClient));
+                               ++finishedClients;
+                           });
+                   }
+                   context.waitUntil(
+                       [&finishedClients, clients]()
+                       {
+                           return finishedClients == clients;
+                       });
+                   context.stop();
+
+                   for (auto& thread: threads)
+                   {
+                       thread.join();
+                   }
+
+                   std::vector<double> allLatencies;
+                   for (const auto& clientLatencies: latencies)
+                   {
+                       if (clientLatencies.size() != static_cast<size_t>(requestsPerClient))
+                       {
+                           context.fail(QLatin1String("A client could not complete its requests"));
+                       }
+                       allLatencies.insert(allLatencies.end(),
+                                           clientLatencies.begin(),
+                                           clientLatencies.end());
+                   }
+                   context.addEvents(static_cast<qint64>(allLatencies.size()));
+
+                   if (!allLatencies.empty())
+                   {
+                       std::sort(allLatencies.begin(), allLatencies.end());
+                       const auto last(allLatencies.size() - 1);
+                       context.setMetric(QLatin1String("latencyP50Us"),
+                                         allLatencies[last / 2]);
+                       context.setMetric(QLatin1String("latencyP99Us"),
+                                         allLatencies[last * 99 / 100]);
+                   }
+               });
+}
+#else
+void registerExtServerBenchmarks(BenchmarkRunner&)
+{
+    // The shell extension server is Linux only
+}
+#endif
@@ -0,0 +1,300 @@
+#include "FakeMegaObjects.h"
+
+#include <functional>
+
+using namespace mega;
+
+MegaTransfer* FakeTransfer::copy()
+{
+    return new FakeTransfer(*this);
+}
+
+int FakeTransfer::getType() const
+{
+    return type;
+}
+
+int FakeTransfer::getTag() const
+{
+    return tag;
+}
+
+int FakeTransfer::getState() const
+{
+    return state;
+}
+
+unsigned FakeTransfer::getStage() const
+{
+    return stage;
+}
+
+const char* FakeTransfer::getFileName() const
+{
+    return fileName.c_str();
+}
+
+const char* FakeTransfer::getPath() const
+{
+    return path.c_str();
+}
+
+const char* FakeTransfer::getParentPath() const
+{
+    return parentPath.c_str();
+}
+
+const char* FakeTransfer::getAppData() const
+{
+    return appData.c_str();
+}
+
+MegaHandle FakeTransfer::getNodeHandle() const
+{
+    return nodeHandle;
+}
+
+MegaHandle FakeTransfer::getParentHandle() const
+{
+    return parentHandle;
+}
+
+long long FakeTransfer::getTotalBytes() const
+{
+    return totalBytes;
+}
+
+long long FakeTransfer::getTransferredBytes() const
+{
+    return transferredBytes;
+}
+
+long long FakeTransfer::getDeltaSize() const
+{
+    return deltaSize;
+}
+
+long long FakeTransfer::getSpeed() const
+{
+    return speed;
+}
+
+long long FakeTransfer::getMeanSpeed() const
+{
+    return meanSpeed;
+}
+
+long long FakeTransfer::getNotificationNumber() const
+{
+    return notificationNumber;
+}
+
+unsigned long long FakeTransfer::getPriority() const
+{
+    return priority;
+}
+
+int64_t FakeTransfer::getStartTime() const
+{
+    return startTime;
+}
+
+int64_t FakeTransfer::getUpdateTime() const
+{
+    return updateTime;
+}
+
+int FakeTransfer::getFolderTransferTag() const
+{
+    return folderTransferTag;
+}
+
+bool FakeTransfer::isFolderTransfer() const
+{
+    return folderTransfer;
+}
+
+bool FakeTransfer::isSyncTransfer() const
+{
+    return syncTransfer;
+}
+
+bool FakeTransfer::isBackupTransfer() const
+{
+    return false;
+}
+
+bool FakeTransfer::isStreamingTransfer() const
+{
+    return false;
+}
+
+bool FakeTransfer::isFinished() const
+{
+    return state == STATE_COMPLETED || state == STATE_CANCELLED || state == STATE_FAILED;
+}
+
+FakeError::FakeError(int errorCode):
+    MegaError(errorCode)
+{
+}
+
+MegaSyncStall* FakeSyncStall::copy() const
+{
+    return new FakeSyncStall(*this);
+}
+
+MegaSyncStall::SyncStallReason FakeSyncStall::reason() const
+{
+    return stallReason;
+}
+
+const char* FakeSyncStall::path(bool cloudSide, int index) const
+{
+    const auto& paths(cloudSide ? cloudPaths : localPaths);
+    return index >= 0 && static_cast<size_t>(index) < paths.size() ?
+               paths[static_cast<size_t>(index)].c_str() :
+               "";
+}
+
+MegaHandle FakeSyncStall::cloudNodeHandle(int index) const
+{
+    return index >= 0 && static_cast<size_t>(index) < cloudHandles.size() ?
+               cloudHandles[static_cast<size_t>(index)] :
+               INVALID_HANDLE;
+}
+
+unsigned int FakeSyncStall::pathCount(bool cloudSide) const
+{
+    return static_cast<unsigned int>(cloudSide ? cloudPaths.size() : localPaths.size());
+}
+
+int FakeSyncStall::pathProblem(bool cloudSide, int index) const
+{
+    if (cloudSide || index < 0 || static_cast<size_t>(index) >= localPathProblems.size())
+    {
+        return NoProblem;
+    }
+    return localPathProblems[static_cast<size_t>(index)];
+}
+
+bool FakeSyncStall::couldSuggestIgnoreThisPath(bool, int) const
+{
+    return false;
+}
+
+bool FakeSyncStall::detectedCloudSide() const
+{
+    return cloudSideDetected;
+}
+
+size_t FakeSyncStall::getHash() const
+{
+    size_t hash(std::hash<int>()(stallReason));
+    for (const auto& path: localPaths)
+    {
+        hash ^= std::hash<std::string>()(path) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    for (const auto& path: cloudPaths)
+    {
+        hash ^= std::hash<std::string>()(path) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+MegaSyncStallList* FakeSyncStallList::copy() const
+{
+    return new FakeSyncStallList(*this);
+}
+
+const MegaSyncStall* FakeSyncStallList::get(size_t index) const
+{
+    return index < stalls.size() ? stalls[index].get() : nullptr;
+}
+
+size_t FakeSyncStallList::size() const
+{
+    return stalls.size();
+}
+
+MegaSyncStallMap* FakeSyncStallMap::copy() const
+{
+    return new FakeSyncStallMap(*this);
+}
+
+const MegaSyncStallList* FakeSyncStallMap::get(const MegaHandle key) const
+{
+    for (const auto& syncList: listsBySync)
+    {
+        if (syncList.first == key)
+        {
+            return &syncList.second;
+        }
+    }
+    return nullptr;
+}
+
+MegaHandleList* FakeSyncStallMap::getKeys() const
+{
+    auto keys(MegaHandleList::createInstance());
+    for (const auto& syncList: listsBySync)
+    {
+        keys->addMegaHandle(syncList.first);
+    }
+    return keys;
+}
+
+size_t FakeSyncStallMap::size() const
+{
+    return listsBySync.size();
+}
+
+MegaNode* FakeNode::copy()
+{
+    return new FakeNode(*this);
+}
+
+int FakeNode::getType()
+{
+    return type;
+}
+
+const char* FakeNode::getName()
+{
+    return name.c_str();
+}
+
+MegaHandle FakeNode::getHandle()
+{
+    return handle;
+}
+
+MegaHandle FakeNode::getParentHandle()
+{
+    return parentHandle;
+}
+
+int64_t FakeNode::getSize()
+{
+    return size;
+}
+
+int64_t FakeNode::getCreationTime()
+{
+    return creationTime;
+}
+
+int64_t FakeNode::getModificationTime()
+{
+    return modificationTime;
+}
+
+bool FakeNode::isFile()
+{
+    return type == TYPE_FILE;
+}
+
+bool FakeNode::isFolder()
+{
+    return type != TYPE_FILE;
+}
@@ -0,0 +1,150 @@
+#ifndef FAKEMEGAOBJECTS_H
+#define FAKEMEGAOBJECTS_H
+
+#include "megaapi.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// SDK objects with values set by the benchmarks, so the app classes can be fed without an account.
+// They only implement the getters the app uses
+
+class FakeTransfer: public mega::MegaTransfer
+{
+public:
+    FakeTransfer() = default;
+
+    mega::MegaTransfer* copy() override;
+
+    int getType() const override;
+    int getTag() const override;
+    int getState() const override;
+    unsigned getStage() const override;
+    const char* getFileName() const override;
+    const char* getPath() const override;
+    const char* getParentPath() const override;
+    const char* getAppData() const override;
+    mega::MegaHandle getNodeHandle() const override;
+    mega::MegaHandle getParentHandle() const override;
+    long long getTotalBytes() const override;
+    long long getTransferredBytes() const override;
+    long long getDeltaSize() const override;
+    long long getSpeed() const override;
+    long long getMeanSpeed() const override;
+    long long getNotificationNumber() const override;
+    unsigned long long getPriority() const override;
+    int64_t getStartTime() const override;
+    int64_t getUpdateTime() const override;
+    int getFolderTransferTag() const override;
+    bool isFolderTransfer() const override;
+    bool isSyncTransfer() const override;
+    bool isBackupTransfer() const override;
+    bool isStreamingTransfer() const override;
+    bool isFinished() const override;
+
+    int type = TYPE_DOWNLOAD;
+    int tag = 0;
+    int state = STATE_QUEUED;
+    unsigned stage = STAGE_NONE;
+    std::string fileName;
+    std::string path;
+    std::string parentPath;
+    std::string appData;
+    mega::MegaHandle nodeHandle = mega::INVALID_HANDLE;
+    mega::MegaHandle parentHandle = mega::INVALID_HANDLE;
+    long long totalBytes = 0;
+    long long transferredBytes = 0;
+    long long deltaSize = 0;
+    long long speed = 0;
+    long long meanSpeed = 0;
+    long long notificationNumber = 0;
+    unsigned long long priority = 0;
+    int64_t startTime = 0;
+    int64_t updateTime = 0;
+    int folderTransferTag = 0;
+    bool folderTransfer = false;
+    bool syncTransfer = false;
+};
+
+// The error code is all the app reads from the errors passed to the listeners
+class FakeError: public mega::MegaError
+{
+public:
+    explicit FakeError(int errorCode);
+};
+
+class FakeSyncStall: public mega::MegaSyncStall
+{
+public:
+    FakeSyncStall() = default;
+
+    mega::MegaSyncStall* copy() const override;
+    SyncStallReason reason() const override;
+    const char* path(bool cloudSide, int index) const override;
+    mega::MegaHandle cloudNodeHandle(int index) const override;
+    unsigned int pathCount(bool cloudSide) const override;
+    int pathProblem(bool cloudSide, int index) const override;
+    bool couldSuggestIgnoreThisPath(bool cloudSide, int index) const override;
+    bool detectedCloudSide() const override;
+    size_t getHash() const override;
+
+    SyncStallReason stallReason = FileIssue;
+    std::vector<std::string> localPaths;
+    std::vector<std::string> cloudPaths;
+    std::vector<int> localPathProblems;
+    std::vector<mega::MegaHandle> cloudHandles;
+    bool cloudSideDetected = false;
+};
+
+class FakeSyncStallList: public mega::MegaSyncStallList
+{
+public:
+    FakeSyncStallList() = default;
+
+    mega::MegaSyncStallList* copy() const override;
+    const mega::MegaSyncStall* get(size_t index) const override;
+    size_t size() const override;
+
+    std::vector<std::shared_ptr<FakeSyncStall>> stalls;
+};
+
+class FakeSyncStallMap: public mega::MegaSyncStallMap
+{
+public:
+    FakeSyncStallMap() = default;
+
+    mega::MegaSyncStallMap* copy() const override;
+    const mega::MegaSyncStallList* get(const mega::MegaHandle key) const override;
+    mega::MegaHandleList* getKeys() const override;
+    size_t size() const override;
+
+    std::vector<std::pair<mega::MegaHandle, FakeSyncStallList>> listsBySync;
+};
+
+class FakeNode: public mega::MegaNode
+{
+public:
+    FakeNode() = default;
+
+    mega::MegaNode* copy() override;
+    int getType() override;
+    const char* getName() override;
+    mega::MegaHandle getHandle() override;
+    mega::MegaHandle getParentHandle() override;
+    int64_t getSize() override;
+    int64_t getCreationTime() override;
+    int64_t getModificationTime() override;
+    bool isFile() override;
+    bool isFolder() override;
+
+    int type = TYPE_FILE;
+    std::string name;
+    mega::MegaHandle handle = mega::INVALID_HANDLE;
+    mega::MegaHandle parentHandle = mega::INVALID_HANDLE;
+    int64_t size = 0;
+    int64_t creationTime = 0;
+    int64_t modificationTime = 0;
+};
+
+#endif // FAKEMEGAOBJECTS_H
@@ -0,0 +1,200 @@
+#include "Benchmarks.h"
+#include "HTTPServer.h"
+#include "MegaApplication.h"
+#include "Preferences.h"
+
+#include <QElapsedTimer>
+#include <QTcpSocket>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr int REQUEST_TIMEOUT_MS = 5000;
+
+// Progress query of a transfer the webclient did not start, which is answered at once and does
+// not depend on the account. The webclient polls the progress of its transfers the same way
+QByteArray createProgressRequest(int client, int index)
+{
+    std::unique_ptr<char[]> handle(
+        mega::MegaApi::handleToBase64((static_cast<mega::MegaHandle>(client) << 32) | index));
+    const auto body(QByteArray("{\"a\":\"t\",\"h\":\"") + handle.get() + "\"}");
+    return QByteArray("POST / HTTP/1.1\r\n"
+                      "Host: localhost\r\n"
+                      "Origin: https://mega.nz\r\n"
+                      "Content-Type: text/plain\r\n"
+                      "Content-Length: ") +
+           QByteArray::number(body.size()) + "\r\n\r\n" + body;
+}
+
+// Reads one response from the socket. Returns false on timeout or if the response is not a 200
+bool readResponse(QTcpSocket& socket, QByteArray& buffer)
+{
+    int headEnd(-1);
+    int contentLength(-1);
+    while (true)
+    {
+        if (headEnd < 0)
+        {
+            headEnd = buffer.indexOf("\r\n\r\n");
+            if (headEnd >= 0)
+            {
+                if (!buffer.startsWith("HTTP/1.1 200"))
+                {
+                    return false;
+                }
+
+                const QByteArray lengthHeader("\r\nContent-Length: ");
+                const auto lengthStart(buffer.indexOf(lengthHeader));
+                if (lengthStart < 0 || lengthStart > headEnd)
+                {
+                    return false;
+                }
+                const auto valueStart(lengthStart + lengthHeader.size());
+                contentLength =
+                    buffer.mid(valueStart, buffer.indexOf("\r\n", valueStart) - valueStart).toInt();
+            }
+        }
+
+        const int responseSize(headEnd + 4 + contentLength);
+        if (headEnd >= 0 && buffer.size() >= responseSize)
+        {
+            buffer.remove(0, responseSize);
+            return true;
+        }
+
+        if (!socket.waitForReadyRead(REQUEST_TIMEOUT_MS))
+        {
+            return false;
+        }
+        buffer.append(socket.readAll());
+    }
+}
+
+// Sends the requests of a webclient tab over one keep-alive connection, in groups of pipelined
+// requests. Returns the latency of each group in microseconds, or an empty list if it failed
+std::vector<double> sendRequests(quint16 port, int client, int requests, int pipelineDepth)
+{
+    std::vector<double> latencies;
+    QTcpSocket socket;
+    socket.connectToHost(QHostAddress::LocalHost, port);
+    if (!socket.waitForConnected(REQUEST_TIMEOUT_MS))
+    {
+        return latencies;
+    }
+
+    QByteArray buffer;
+    QElapsedTimer timer;
+    for (int first = 0; first < requests; first += pipelineDepth)
+    {
+        const int groupSize(std::min(pipelineDepth, requests - first));
+        QByteArray group;
+        for (int index = first; index < first + groupSize; ++index)
+        {
+            group.append(createProgressRequest(client, index));
+        }
+
+        timer.start();
+        socket.write(group);
+        if (!socket.waitForBytesWritten(REQUEST_TIMEOUT_MS))
+        {
+            return {};
+        }
+        for (int index = 0; index < groupSize; ++index)
+        {
+            if (!readResponse(socket, buffer))
+            {
+                return {};
+            }
+        }
+        latencies.push_back(static_cast<double>(timer.nsecsElapsed()) / 1000.0);
+    }
+
+    return latencies;
+}
+}
+
+void registerHTTPServerBenchmarks(BenchmarkRunner& runner)
+{
+    runner.add(QLatin1String("http_server.keep_alive_requests"),
+               QLatin1String("Webclient requests of concurrent keep-alive connections to "
+                             "HTTPServer, optionally pipelined"),
+               [](BenchmarkContext& context)
+               {
+                   const int clients(
+                       std::max(context.getParameter(QLatin1String("clients"), 8), 1));
+                   const int requestsPerClient(
+                       std::max(context.getParameter(QLatin1String("requestsPerClient"), 2000), 1));
+                   const int pipelineDepth(
+                       std::max(context.getParameter(QLatin1String("pipelineDepth"), 1), 1));
+
+                   // The allowed origins come from the service URLs, which are not relevant here
+                   const bool originCheckEnabled(Preferences::HTTPS_ORIGIN_CHECK_ENABLED);
+                   Preferences::HTTPS_ORIGIN_CHECK_ENABLED = false;
+
+                   HTTPServer server(MegaSyncApp->getMegaApi(), 0);
+                   if (!server.isListening())
+                   {
+                       Preferences::HTTPS_ORIGIN_CHECK_ENABLED = originCheckEnabled;
+                       context.fail(QLatin1String("The server is not listening"));
+                       return;
+                   }
+                   const auto port(server.serverPort());
+
+                   std::vector<std::vector<double>> latencies(static_cast<size_t>(clients));
+                   std::vector<std::thread> threads;
+                   std::atomic<int> finishedClients(0);
+
+                   context.start();
+                   for (int client = 0; client < clients; ++client)
+                   {
+                       threads.emplace_back(
+                           [&, client]()
+                           {
+                               latencies[static_cast<size_t>(client)] =
+                                   sendRequests(port, client, requestsPerClient, pipelineDepth);
+                               ++finishedClients;
+                           });
+                   }
+                   context.waitUntil(
+                       [&finishedClients, clients]()
+                       {
+                           return finishedClients == clients;
+                       });
+                   context.stop();
+
+                   for (auto& thread: threads)
+                   {
+                       thread.join();
+                   }
+                   Preferences::HTTPS_ORIGIN_CHECK_ENABLED = originCheckEnabled;
+
+                   const auto groupsPerClient(static_cast<size_t>(
+                       (requestsPerClient + pipelineDepth - 1) / pipelineDepth));
+                   std::vector<double> allLatencies;
+                   for (const auto& clientLatencies: latencies)
+                   {
+                       if (clientLatencies.size() != groupsPerClient)
+                       {
+                           context.fail(QLatin1String("A client could not complete its requests"));
+                       }
+                       allLatencies.insert(allLatencies.end(),
+                                           clientLatencies.begin(),
+                                           clientLatencies.end());
+                   }
+                   context.addEvents(static_cast<qint64>(clients) * requestsPerClient);
+
+                   if (!allLatencies.empty())
+                   {
+                       std::sort(allLatencies.begin(), allLatencies.end());
+                       const auto last(allLatencies.size() - 1);
+                       context.setMetric(QLatin1String("latencyP50Us"), allLatencies[last / 2]);
+                       context.setMetric(QLatin1String("latencyP99Us"),
+                                         allLatencies[last * 99 / 100]);
+                   }
+               });
+}
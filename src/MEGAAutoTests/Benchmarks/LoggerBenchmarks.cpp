@@ -0,0 +1,70 @@
+#include "Benchmarks.h"
+#include "MegaApplication.h"
+#include "MegaSyncLogger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+void registerLoggerBenchmarks(BenchmarkRunner& runner)
+{
+    runner.add(QLatin1String("logger.concurrent_messages"),
+               QLatin1String("Messages logged to MegaSyncLogger from several SDK like threads"),
+               [](BenchmarkContext& context)
+               {
+                   const int threadCount(
+                       std::max(context.getParameter(QLatin1String("threads"), 4), 1));
+                   const int messagesPerThread(
+                       context.getParameter(QLatin1String("messagesPerThread"), 100000));
+                   const int messageSize(context.getParameter(QLatin1String("messageSize"), 120));
+
+                   auto& logger(MegaSyncApp->getLogger());
+                   std::vector<std::thread> threads;
+                   std::atomic<int> finishedThreads(0);
+
+                   context.start();
+                   for (int thread = 0; thread < threadCount; ++thread)
+                   {
+                       threads.emplace_back(
+                           [&logger, &finishedThreads, thread, messagesPerThread, messageSize]()
+                           {
+                               const std::string prefix("Benchmark thread " +
+                                                        std::to_string(thread) + " message ");
+                               std::string message;
+                               for (int index = 0; index < messagesPerThread; ++index)
+                               {
+                                   message = prefix + std::to_string(index);
+                                   message.resize(std::max(static_cast<size_t>(messageSize),
+                                                           message.size()),
+                                                  '.');
+                                   logger.log("",
+                                              mega::MegaApi::LOG_LEVEL_INFO,
+                                              nullptr,
+                                              message.c_str()
+#ifdef ENABLE_LOG_PERFORMANCE
+                                                  ,
+                                              nullptr,
+                                              nullptr,
+                                              0
+#endif
+                                   );
+                               }
+                               ++finishedThreads;
+                           });
+                   }
+                   context.waitUntil(
+                       [&finishedThreads, threadCount]()
+                       {
+                           return finishedThreads == threadCount;
+                       });
+                   context.addEvents(static_cast<qint64>(threadCount) * messagesPerThread);
+                   context.stop();
+
+                   for (auto& thread: threads)
+                   {
+                       thread.join();
+                   }
+               });
+}
@@ -0,0 +1,39 @@
+#include "Benchmarks.h"
+#include "EventGenerators.h"
+#include "NodeSelectorModelSpecialised.h"
+
+#include <algorithm>
+
+void registerNodeSelectorBenchmarks(BenchmarkRunner& runner)
+{
+    runner.add(QLatin1String("node_selector.search_results"),
+               QLatin1String("Search results added in batches to NodeSelectorModelSearch"),
+               [](BenchmarkContext& context)
+               {
+                   const int nodeCount(context.getParameter(QLatin1String("nodes"), 50000));
+                   const int batchSize(
+                       std::max(context.getParameter(QLatin1String("batchSize"), 1000), 1));
+                   const auto seed(
+                       static_cast<unsigned int>(context.getParameter(QLatin1String("seed"), 1)));
+                   const auto nodes(EventGenerators::createNodes(nodeCount, seed));
+
+                   NodeSelectorModelSearch model(NodeSelectorModelItemSearch::Type::CLOUD_DRIVE |
+                                                 NodeSelectorModelItemSearch::Type::INCOMING_SHARE |
+                                                 NodeSelectorModelItemSearch::Type::BACKUP |
+                                                 NodeSelectorModelItemSearch::Type::RUBBISH);
+                   model.firstLoad();
+
+                   context.start();
+                   for (int first = 0; first < nodes.size(); first += batchSize)
+                   {
+                       model.addNodes(nodes.mid(first, batchSize), QModelIndex());
+                   }
+                   context.waitUntil(
+                       [&model, nodeCount]()
+                       {
+                           return model.rowCount() >= nodeCount;
+                       });
+                   context.addEvents(nodeCount);
+                   context.stop();
+               });
+}
@@ -0,0 +1,235 @@
+#include "Benchmarks.h"
+#include "EventGenerators.h"
+#include "MegaApplication.h"
+#include "StalledIssueDelegate.h"
+#include "StalledIssueHashDiscardTracker.h"
+#include "StalledIssuesFactory.h"
+#include "StalledIssuesModel.h"
+#include "StalledIssuesProxyModel.h"
+#include "StalledIssuesView.h"
+
+#include <QElapsedTimer>
+#include <QScrollBar>
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <thread>
+
+namespace
+{
+struct LoadedIssues
+{
+    qint64 creationNs;
+    int issues;
+};
+
+// Creates the issues of a stalls map off the GUI thread, as the model receiver does, and waits
+// until StalledIssuesModel has processed them
+std::optional<LoadedIssues> loadIssues(BenchmarkContext& context, int syncs, int stallsPerSync)
+{
+    const auto seed(static_cast<unsigned int>(context.getParameter(QLatin1String("seed"), 1)));
+    const auto stallMap(EventGenerators::createStallMap(syncs, stallsPerSync, seed));
+
+    auto model(MegaSyncApp->getStalledIssuesModel());
+    bool received(false);
+    auto connection(QObject::connect(model,
+                                     &StalledIssuesModel::stalledIssuesReceived,
+                                     [&received]()
+                                     {
+                                         received = true;
+                                     }));
+
+    ReceivedStalledIssues issues;
+    qint64 creationNs(0);
+    std::atomic<bool> created(false);
+    std::thread creatorThread(
+        [&stallMap, &issues, &creationNs, &created]()
+        {
+            QElapsedTimer timer;
+            timer.start();
+            StalledIssuesCreator creator;
+            creator.setHashDiscardTracker(std::make_shared<StalledIssueHashDiscardTracker>());
+            creator.createIssues(stallMap.get(), UpdateType::UI);
+            issues = creator.getStalledIssues();
+            creationNs = timer.nsecsElapsed();
+            created = true;
+        });
+    context.waitUntil(
+        [&created]()
+        {
+            return created.load();
+        });
+    creatorThread.join();
+
+    QMetaObject::invokeMethod(model,
+                              "onProcessStalledIssues",
+                              Qt::QueuedConnection,
+                              Q_ARG(ReceivedStalledIssues, issues),
+                              Q_ARG(UpdateType, UpdateType::UI));
+    const bool loaded(context.waitUntil(
+        [&received]()
+        {
+            return received;
+        }));
+    QObject::disconnect(connection);
+
+    if (!loaded)
+    {
+        return std::nullopt;
+    }
+    return LoadedIssues{creationNs, static_cast<int>(issues.size())};
+}
+}
+
+void registerStalledIssuesBenchmarks(BenchmarkRunner& runner)
+{
+    runner.add(
+        QLatin1String("stalled_issues.process"),
+        QLatin1String("Issues created from a stalls map and loaded into StalledIssuesModel"),
+        [](BenchmarkContext& context)
+        {
+            const int syncs(context.getParameter(QLatin1String("syncs"), 10));
+            const int stallsPerSync(context.getParameter(QLatin1String("stallsPerSync"), 2000));
+
+            context.start();
+            const auto loaded(loadIssues(context, syncs, stallsPerSync));
+            context.addEvents(static_cast<qint64>(syncs) * stallsPerSync);
+            context.stop();
+
+            auto model(MegaSyncApp->getStalledIssuesModel());
+            if (loaded)
+            {
+                context.setMetric(QLatin1String("createIssuesMs"),
+                                  static_cast<double>(loaded->creationNs) / 1000000.0);
+                context.setMetric(QLatin1String("issues"), loaded->issues);
+                context.setMetric(QLatin1String("rows"), model->rowCount(QModelIndex()));
+            }
+
+            model->fullReset();
+        });
+
+    runner.add(
+        QLatin1String("stalled_issues.delegate_scroll"),
+        QLatin1String("Repaints of the stalled issues rows, unchanged, scrolled and once the "
+                      "scroll stops"),
+        [](BenchmarkContext& context)
+        {
+            const int syncs(context.getParameter(QLatin1String("syncs"), 10));
+            const int stallsPerSync(context.getParameter(QLatin1String("stallsPerSync"), 2000));
+            const int frames(std::max(context.getParameter(QLatin1String("frames"), 200), 1));
+            const int scrollStops(
+                std::max(context.getParameter(QLatin1String("scrollStops"), 20), 1));
+
+            auto model(MegaSyncApp->getStalledIssuesModel());
+            if (!loadIssues(context, syncs, stallsPerSync))
+            {
+                model->fullReset();
+                return;
+            }
+
+            // Same setup as StalledIssuesDialog
+            StalledIssuesProxyModel proxy;
+            proxy.setSourceModel(model);
+            bool filtered(false);
+            QObject::connect(&proxy,
+                             &StalledIssuesProxyModel::modelFiltered,
+                             [&filtered]()
+                             {
+                                 filtered = true;
+                             });
+            proxy.updateFilter();
+            if (!context.waitUntil(
+                    [&filtered]()
+                    {
+                        return filtered;
+                    }))
+            {
+                model->fullReset();
+                return;
+            }
+
+            StalledIssuesView view(nullptr);
+            view.setHeaderHidden(true);
+            view.setRootIsDecorated(false);
+            view.setIndentation(0);
+            view.setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+            view.setModel(&proxy);
+            StalledIssueDelegate delegate(&proxy, &view);
+            view.setItemDelegate(&delegate);
+            view.resize(context.getParameter(QLatin1String("width"), 800),
+                        context.getParameter(QLatin1String("height"), 600));
+            view.show();
+
+            bool scrollStopped(false);
+            QObject::connect(&view,
+                             &StalledIssuesView::scrollStopped,
+                             [&scrollStopped]()
+                             {
+                                 scrollStopped = true;
+                             });
+
+            QElapsedTimer frameTimer;
+            context.start();
+
+            // Every visible row is laid out and rendered from its widget
+            frameTimer.start();
+            view.viewport()->repaint();
+            const auto coldFrameNs(frameTimer.nsecsElapsed());
+
+            // Every row is drawn from its cached pixmap
+            frameTimer.restart();
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                view.viewport()->repaint();
+            }
+            const auto unchangedFramesNs(frameTimer.nsecsElapsed());
+
+            // A page down on each frame, so most rows are not measured yet
+            auto scrollBar(view.verticalScrollBar());
+            auto pageDown = [scrollBar]()
+            {
+                scrollBar->setValue(scrollBar->value() < scrollBar->maximum() ?
+                                        scrollBar->value() + scrollBar->pageStep() :
+                                        0);
+            };
+            frameTimer.restart();
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                pageDown();
+                view.viewport()->repaint();
+            }
+            const auto scrolledFramesNs(frameTimer.nsecsElapsed());
+
+            // The rows around the viewport are updated when the scroll stops. Only the frame
+            // painted after that is measured, the wait for the stop is not
+            qint64 stoppedFramesNs(0);
+            for (int stop = 0; stop < scrollStops && !context.hasFailed(); ++stop)
+            {
+                pageDown();
+                view.viewport()->repaint();
+                scrollStopped = false;
+                context.waitUntil(
+                    [&scrollStopped]()
+                    {
+                        return scrollStopped;
+                    });
+
+                frameTimer.restart();
+                view.viewport()->repaint();
+                stoppedFramesNs += frameTimer.nsecsElapsed();
+            }
+
+            context.stop();
+            context.addEvents(1 + 2 * frames + scrollStops);
+            context.setMetric(QLatin1String("rows"), proxy.rowCount(QModelIndex()));
+            context.setMetric(QLatin1String("coldFrameMs"), coldFrameNs / 1e6);
+            context.setMetric(QLatin1String("unchangedFrameMs"), unchangedFramesNs / 1e6 / frames);
+            context.setMetric(QLatin1String("scrolledFrameMs"), scrolledFramesNs / 1e6 / frames);
+            context.setMetric(QLatin1String("scrollStoppedFrameMs"),
+                              stoppedFramesNs / 1e6 / scrollStops);
+
+            view.hide();
+            model->fullReset();
+        });
+}
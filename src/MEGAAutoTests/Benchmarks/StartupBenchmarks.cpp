@@ -0,0 +1,52 @@
+#include "Benchmarks.h"
+#include "StartupProfiler.h"
+
+void registerStartupBenchmarks(BenchmarkRunner& runner)
+{
+    runner.add(QLatin1String("startup.time_to_tray"),
+               QLatin1String("Startup stages until the tray icon is shown, and the deferred work"),
+               [](BenchmarkContext& context)
+               {
+                   // MegaApplication::initialize() has already been run by the benchmarks main,
+                   // which does not call start(), so the critical path is finished here
+                   const int budgetMs(context.getParameter(QLatin1String("budgetMs"), 3000));
+                   auto profiler(StartupProfiler::instance());
+
+                   context.start();
+                   profiler->finishCriticalPath();
+                   if (!context.waitUntil(
+                           [profiler]()
+                           {
+                               return profiler->isFinished();
+                           }))
+                   {
+                       context.fail(QLatin1String("The deferred startup tasks did not finish"));
+                   }
+                   context.stop();
+
+                   for (const auto& stage: profiler->getStages())
+                   {
+                       context.setMetric(QLatin1String("stageMs.") + stage.name,
+                                         static_cast<double>(stage.durationMs));
+                   }
+                   context.addEvents(profiler->getStages().size());
+
+                   const auto trayShownMs(
+                       profiler->getMilestone(StartupProfiler::TRAY_SHOWN_MILESTONE));
+                   if (!trayShownMs.has_value())
+                   {
+                       context.fail(QLatin1String("The tray icon was not shown"));
+                       return;
+                   }
+
+                   context.setMetric(QLatin1String("timeToTrayMs"),
+                                     static_cast<double>(trayShownMs.value()));
+                   if (trayShownMs.value() > budgetMs)
+                   {
+                       context.fail(
+                           QString::fromLatin1("Time to tray of %1 ms over budget of %2 ms")
+                               .arg(trayShownMs.value())
+                               .arg(budgetMs));
+                   }
+               });
+}
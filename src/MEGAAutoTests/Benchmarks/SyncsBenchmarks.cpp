@@ -0,0 +1,101 @@
+#include "Benchmarks.h"
+#include "EventGenerators.h"
+#include "MegaIgnoreMatcher.h"
+
+#include <QElapsedTimer>
+
+#include <algorithm>
+
+namespace
+{
+// A few rules exclude part of the generated tree. The others are the kind of rules a long
+// .megaignore file gathers, of every pattern type, which do not match it
+QList<std::shared_ptr<MegaIgnoreRule>> createRules(int count)
+{
+    QStringList lines{QLatin1String("-d:archive1"),
+                      QLatin1String("-:*.psd"),
+                      QLatin1String("+:final_*.psd"),
+                      QLatin1String("-p:backup*/notes*/*.txt")};
+    for (int index = static_cast<int>(lines.size()); index < count; ++index)
+    {
+        switch (index % 4)
+        {
+            case 0:
+                lines.append(QString::fromLatin1("-:*.ext%1").arg(index));
+                break;
+            case 1:
+                lines.append(QString::fromLatin1("-:tmp%1_*").arg(index));
+                break;
+            case 2:
+                lines.append(QString::fromLatin1("-d:build%1").arg(index));
+                break;
+            default:
+                lines.append(QString::fromLatin1("-r:cache%1_[0-9]+\\.bin").arg(index));
+                break;
+        }
+    }
+
+    QList<std::shared_ptr<MegaIgnoreRule>> rules;
+    for (const auto& line: lines)
+    {
+        rules.append(std::make_shared<MegaIgnoreNameRule>(line, false));
+    }
+    return rules;
+}
+}
+
+void registerSyncsBenchmarks(BenchmarkRunner& runner)
+{
+    runner.add(QLatin1String("syncs.ignore_matcher"),
+               QLatin1String("Local paths of a sync matched against the compiled rules of a "
+                             ".megaignore file"),
+               [](BenchmarkContext& context)
+               {
+                   const int pathCount(
+                       std::max(context.getParameter(QLatin1String("paths"), 500000), 1));
+                   const int ruleCount(context.getParameter(QLatin1String("rules"), 200));
+                   const auto seed(
+                       static_cast<unsigned int>(context.getParameter(QLatin1String("seed"), 1)));
+                   const auto rules(createRules(ruleCount));
+
+                   // Relative to the sync folder, as the matcher expects them
+                   auto paths(EventGenerators::createLocalPaths(QString(), pathCount, seed));
+                   for (auto& path: paths)
+                   {
+                       path.remove(0, 1);
+                   }
+
+                   QElapsedTimer timer;
+                   context.start();
+
+                   timer.start();
+                   MegaIgnoreMatcher matcher(rules);
+                   const auto compileNs(timer.nsecsElapsed());
+
+                   timer.restart();
+                   int excludedPaths(0);
+                   for (const auto& path: qAsConst(paths))
+                   {
+                       if (matcher.isExcluded(path, MegaIgnoreMatcher::NodeType::FILE))
+                       {
+                           ++excludedPaths;
+                       }
+                   }
+                   const auto matchNs(timer.nsecsElapsed());
+
+                   context.stop();
+                   context.addEvents(pathCount);
+                   context.setMetric(QLatin1String("rules"), rules.size());
+                   context.setMetric(QLatin1String("compileMs"), compileNs / 1e6);
+                   context.setMetric(QLatin1String("matchNsPerPath"),
+                                     static_cast<double>(matchNs) / pathCount);
+                   context.setMetric(QLatin1String("excludedPaths"), excludedPaths);
+
+                   if (excludedPaths == 0 || excludedPaths == pathCount)
+                   {
+                       context.fail(QString::fromLatin1("%1 of %2 paths excluded")
+                                        .arg(excludedPaths)
+                                        .arg(pathCount));
+                   }
+               });
+}
@@ -0,0 +1,94 @@
+#include "Benchmarks.h"
+#include "IconTokenizer.h"
+
+#include <QElapsedTimer>
+#include <QPainter>
+#include <QPixmap>
+#include <QPixmapCache>
+#include <QVector>
+
+#include <algorithm>
+
+namespace
+{
+// Antialiased shapes, so the icons have every alpha value and not only opaque pixels
+QVector<QPixmap> createIcons(int count, int size, qreal devicePixelRatio)
+{
+    QVector<QPixmap> icons;
+    icons.reserve(count);
+    for (int index = 0; index < count; ++index)
+    {
+        QPixmap icon(QSize(size, size) * devicePixelRatio);
+        icon.setDevicePixelRatio(devicePixelRatio);
+        icon.fill(Qt::transparent);
+
+        QPainter painter(&icon);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(QPen(Qt::black, 1.5));
+        painter.setBrush(QColor(0, 0, 0, 64 + index % 192));
+        const qreal margin(1.0 + index % 4);
+        painter.drawEllipse(QRectF(margin, margin, size - 2 * margin, size - 2 * margin));
+        painter.drawLine(QPointF(margin, size / 2.0), QPointF(size - margin, size / 2.0));
+        painter.end();
+
+        icons.append(icon);
+    }
+    return icons;
+}
+}
+
+void registerTokenizerBenchmarks(BenchmarkRunner& runner)
+{
+    runner.add(QLatin1String("tokenizer.icon_tint"),
+               QLatin1String("Icons tinted by IconTokenizer, first with an empty cache and then "
+                             "again from the cache"),
+               [](BenchmarkContext& context)
+               {
+                   const int iconCount(
+                       std::max(context.getParameter(QLatin1String("icons"), 500), 1));
+                   const int size(std::max(context.getParameter(QLatin1String("size"), 24), 1));
+                   const int devicePixelRatio(
+                       std::max(context.getParameter(QLatin1String("devicePixelRatio"), 2), 1));
+                   const int rounds(std::max(context.getParameter(QLatin1String("rounds"), 10), 1));
+                   const auto icons(createIcons(iconCount, size, devicePixelRatio));
+                   const QColor color(QLatin1String("#04101E"));
+
+                   QPixmapCache::clear();
+                   QElapsedTimer timer;
+                   int failures(0);
+                   context.start();
+
+                   // Every icon is converted and tinted
+                   timer.start();
+                   for (const auto& icon: icons)
+                   {
+                       failures += IconTokenizer::changePixmapColor(icon, color) ? 0 : 1;
+                   }
+                   const auto coldNs(timer.nsecsElapsed());
+
+                   // Repaints tint the same icons again, which are found in the cache
+                   timer.restart();
+                   for (int round = 0; round < rounds; ++round)
+                   {
+                       for (const auto& icon: icons)
+                       {
+                           failures += IconTokenizer::changePixmapColor(icon, color) ? 0 : 1;
+                       }
+                   }
+                   const auto cachedNs(timer.nsecsElapsed());
+
+                   context.stop();
+                   context.addEvents(static_cast<qint64>(iconCount) * (1 + rounds));
+                   context.setMetric(QLatin1String("coldTintUs"), coldNs / 1e3 / iconCount);
+                   context.setMetric(QLatin1String("cachedTintUs"),
+                                     cachedNs / 1e3 / iconCount / rounds);
+
+                   if (failures > 0)
+                   {
+                       context.fail(QString::fromLatin1("%1 icons could not be tinted")
+                                        .arg(failures));
+                   }
+
+                   QPixmapCache::clear();
+               });
+}
@@ -0,0 +1,386 @@
+#include "Benchmarks.h"
+#include "EventGenerators.h"
+#include "FolderTransferListener.h"
+#include "MegaApplication.h"
+#include "MegaTransferDelegate.h"
+#include "QTMegaTransferListener.h"
+#include "TransferMetaData.h"
+#include "TransfersManagerSortFilterProxyModel.h"
+#include "TransfersModel.h"
+#include "TransferWidgetColumnsManager.h"
+
+#include <QElapsedTimer>
+#include <QScrollBar>
+#include <QTreeView>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Far from the tags of the SDK, in case the model already has transfers
+constexpr int FIRST_TAG = 1000000;
+
+EventGenerators::TransferStormOptions getStormOptions(BenchmarkContext& context,
+                                                      int defaultUpdatesPerTransfer)
+{
+    EventGenerators::TransferStormOptions options;
+    options.transfers = context.getParameter(QLatin1String("transfers"), 10000);
+    options.updatesPerTransfer =
+        context.getParameter(QLatin1String("updatesPerTransfer"), defaultUpdatesPerTransfer);
+    options.uploadPercentage = context.getParameter(QLatin1String("uploadPercentage"), 50);
+    options.maxFileSize =
+        1024LL * 1024LL * context.getParameter(QLatin1String("maxFileSizeMb"), 100);
+    options.seed = static_cast<unsigned int>(context.getParameter(QLatin1String("seed"), 1));
+    options.firstTag = FIRST_TAG;
+    return options;
+}
+
+// Sends the events from another thread through the same Qt listener the SDK notifies, and waits
+// until the model shows all the transfers with their last update
+bool replay(BenchmarkContext& context,
+            const std::vector<EventGenerators::TransferEvent>& events,
+            int transfers)
+{
+    auto model(MegaSyncApp->getTransfersModel());
+    auto api(MegaSyncApp->getMegaApi());
+    QTMegaTransferListener listener(api, model->getTransferEventWorker());
+
+    std::atomic<bool> allDelivered(false);
+    std::thread sdkThread(
+        [&events, &listener, &allDelivered, api]()
+        {
+            for (const auto& event: events)
+            {
+                if (event.type == EventGenerators::TransferEvent::Type::START)
+                {
+                    listener.onTransferStart(api, event.transfer.get());
+                }
+                else
+                {
+                    listener.onTransferUpdate(api, event.transfer.get());
+                }
+            }
+
+            // Queued after the last event, so it runs once all of them are delivered
+            QMetaObject::invokeMethod(
+                &listener,
+                [&allDelivered]()
+                {
+                    allDelivered = true;
+                },
+                Qt::QueuedConnection);
+        });
+
+    const auto& lastTransfer(*events.back().transfer);
+    const bool finished(context.waitUntil(
+        [&]()
+        {
+            if (!allDelivered || model->rowCount() < transfers)
+            {
+                return false;
+            }
+
+            auto data(model->getTransferByTag(lastTransfer.tag));
+            return data && data->mTransferredBytes == lastTransfer.transferredBytes;
+        }));
+
+    sdkThread.join();
+    // The listener goes away with this scope, so do its pending events if it timed out
+    QCoreApplication::removePostedEvents(&listener);
+
+    return finished;
+}
+}
+
+void registerTransfersBenchmarks(BenchmarkRunner& runner)
+{
+    runner.add(QLatin1String("transfers.event_storm"),
+               QLatin1String("Start and update events of many transfers into TransfersModel"),
+               [](BenchmarkContext& context)
+               {
+                   const auto options(getStormOptions(context, 10));
+                   const auto events(EventGenerators::createTransferStorm(options));
+                   if (events.empty())
+                   {
+                       return;
+                   }
+
+                   context.start();
+                   replay(context, events, options.transfers);
+                   context.addEvents(static_cast<qint64>(events.size()));
+                   context.stop();
+
+                   MegaSyncApp->getTransfersModel()->resetModel();
+               });
+
+    runner.add(QLatin1String("transfers.proxy_sort"),
+               QLatin1String("Sort of the transfers manager proxy by each criterion"),
+               [](BenchmarkContext& context)
+               {
+                   const auto options(getStormOptions(context, 1));
+                   const auto events(EventGenerators::createTransferStorm(options));
+                   if (events.empty() || !replay(context, events, options.transfers))
+                   {
+                       return;
+                   }
+
+                   auto model(MegaSyncApp->getTransfersModel());
+                   TransfersManagerSortFilterProxyModel proxy;
+                   proxy.setSourceModel(model);
+
+                   bool sorted(false);
+                   QObject::connect(&proxy,
+                                    &TransfersManagerSortFilterProxyModel::modelChanged,
+                                    [&sorted]()
+                                    {
+                                        sorted = true;
+                                    });
+
+                   context.start();
+                   for (int criterion = static_cast<int>(SortCriterion::NAME);
+                        criterion < static_cast<int>(SortCriterion::LAST) && !context.hasFailed();
+                        ++criterion)
+                   {
+                       sorted = false;
+                       proxy.sort(criterion, Qt::AscendingOrder);
+                       context.waitUntil(
+                           [&sorted]()
+                           {
+                               return sorted;
+                           });
+                       context.addEvents(model->rowCount());
+                   }
+                   context.stop();
+
+                   model->resetModel();
+               });
+
+    runner.add(QLatin1String("transfers.delegate_paint"),
+               QLatin1String("Repaints of the Transfer Manager rows, unchanged and scrolled"),
+               [](BenchmarkContext& context)
+               {
+                   const auto options(getStormOptions(context, 1));
+                   const int frames(
+                       std::max(context.getParameter(QLatin1String("frames"), 200), 1));
+                   const auto events(EventGenerators::createTransferStorm(options));
+                   if (events.empty() || !replay(context, events, options.transfers))
+                   {
+                       return;
+                   }
+
+                   auto model(MegaSyncApp->getTransfersModel());
+                   TransferWidgetColumnsManager columnManager;
+                   TransfersManagerSortFilterProxyModel proxy;
+                   proxy.setSourceModel(model);
+                   proxy.setColumnManager(&columnManager);
+
+                   QTreeView view;
+                   view.setHeaderHidden(true);
+                   view.setRootIsDecorated(false);
+                   view.setModel(&proxy);
+                   MegaTransferDelegate delegate(&proxy, &view);
+                   view.setItemDelegate(&delegate);
+                   view.resize(context.getParameter(QLatin1String("width"), 800),
+                               context.getParameter(QLatin1String("height"), 600));
+                   view.show();
+                   if (!context.waitUntil(
+                           [&proxy]()
+                           {
+                               return proxy.rowCount() > 0;
+                           }))
+                   {
+                       return;
+                   }
+
+                   QElapsedTimer frameTimer;
+                   context.start();
+
+                   // Every row is rendered from its widget
+                   frameTimer.start();
+                   view.viewport()->repaint();
+                   const auto coldFrameNs(frameTimer.nsecsElapsed());
+
+                   // Every row is drawn from its cached pixmap
+                   frameTimer.restart();
+                   for (int frame = 0; frame < frames; ++frame)
+                   {
+                       view.viewport()->repaint();
+                   }
+                   const auto unchangedFramesNs(frameTimer.nsecsElapsed());
+
+                   // A page down on each frame, so most rows are not cached yet
+                   auto scrollBar(view.verticalScrollBar());
+                   frameTimer.restart();
+                   for (int frame = 0; frame < frames; ++frame)
+                   {
+                       scrollBar->setValue(scrollBar->value() < scrollBar->maximum() ?
+                                               scrollBar->value() + scrollBar->pageStep() :
+                                               0);
+                       view.viewport()->repaint();
+                   }
+                   const auto scrolledFramesNs(frameTimer.nsecsElapsed());
+
+                   context.stop();
+                   context.addEvents(1 + 2 * frames);
+                   context.setMetric(QLatin1String("coldFrameMs"), coldFrameNs / 1e6);
+                   context.setMetric(QLatin1String("unchangedFrameMs"),
+                                     unchangedFramesNs / 1e6 / frames);
+                   context.setMetric(QLatin1String("scrolledFrameMs"),
+                                     scrolledFramesNs / 1e6 / frames);
+
+                   view.hide();
+                   model->resetModel();
+               });
+
+    runner.add(QLatin1String("transfers.metadata_memory"),
+               QLatin1String("Memory per file tracked by the metadata of a folder download. The "
+                             "peak memory is process-wide, so run it alone"),
+               [](BenchmarkContext& context)
+               {
+                   const int files(
+                       std::max(context.getParameter(QLatin1String("files"), 500000), 1));
+                   const auto seed(
+                       static_cast<unsigned int>(context.getParameter(QLatin1String("seed"), 1)));
+                   const auto localPaths(
+                       EventGenerators::createLocalPaths(QLatin1String("/downloads"), files, seed));
+
+                   const auto initialRssKb(BenchmarkRunner::getPeakRssKb());
+                   DownloadTransferMetaData data(1, QLatin1String("/downloads"));
+                   FakeError error(mega::MegaError::API_OK);
+                   FakeTransfer transfer;
+                   transfer.state = mega::MegaTransfer::STATE_COMPLETED;
+                   transfer.folderTransferTag = FIRST_TAG;
+
+                   context.start();
+                   for (int index = 0; index < files; ++index)
+                   {
+                       data.addFileFromFolder(FIRST_TAG, FIRST_TAG + 1 + index);
+                   }
+                   for (int index = 0; index < files; ++index)
+                   {
+                       const auto& localPath(localPaths.at(index));
+                       transfer.tag = FIRST_TAG + 1 + index;
+                       transfer.path = localPath.toStdString();
+                       transfer.fileName = localPath.section(QLatin1Char('/'), -1).toStdString();
+                       data.finish(&transfer, &error);
+                   }
+                   context.stop();
+                   context.addEvents(files);
+
+                   if (data.getFileTransfersOK() != files)
+                   {
+                       context.fail(QString::fromLatin1("%1 of %2 files completed")
+                                        .arg(data.getFileTransfersOK())
+                                        .arg(files));
+                   }
+
+                   const auto memoryKb(BenchmarkRunner::getPeakRssKb() - initialRssKb);
+                   context.setMetric(QLatin1String("bytesPerFile"),
+                                     static_cast<double>(memoryKb) * 1024.0 / files);
+               });
+
+    runner.add(QLatin1String("transfers.folder_scan_updates"),
+               QLatin1String("Scan and folder creation updates of concurrent folder transfers "
+                             "into FolderTransferListener"),
+               [](BenchmarkContext& context)
+               {
+                   const int transfers(
+                       std::max(context.getParameter(QLatin1String("transfers"), 4), 1));
+                   const int updatesPerTransfer(std::max(
+                       context.getParameter(QLatin1String("updatesPerTransfer"), 200000), 2));
+                   // The first half of the updates scan the folders, the second half create them
+                   const int scanUpdates(updatesPerTransfer / 2);
+                   const uint32_t folders(static_cast<uint32_t>(scanUpdates));
+                   const auto createUpdates(
+                       static_cast<uint32_t>(updatesPerTransfer - scanUpdates));
+
+                   FolderTransferListener listener;
+                   int aggregatedEvents(0);
+                   FolderTransferUpdateEvent lastEvent{};
+                   QObject::connect(&listener,
+                                    &FolderTransferListener::folderTransferUpdated,
+                                    [&aggregatedEvents, &lastEvent](FolderTransferUpdateEvent event)
+                                    {
+                                        ++aggregatedEvents;
+                                        lastEvent = event;
+                                    });
+
+                   auto api(MegaSyncApp->getMegaApi());
+                   std::vector<std::thread> threads;
+                   std::atomic<int> finishedTransfers(0);
+
+                   context.start();
+                   // The SDK reports each folder transfer from its own worker
+                   for (int index = 0; index < transfers; ++index)
+                   {
+                       threads.emplace_back(
+                           [&, index]()
+                           {
+                               FakeTransfer transfer;
+                               transfer.tag = FIRST_TAG + index;
+                               transfer.folderTransfer = true;
+                               transfer.appData = std::to_string(index);
+                               transfer.fileName = "folder" + std::to_string(index);
+
+                               for (int update = 0; update < updatesPerTransfer; ++update)
+                               {
+                                   if (update < scanUpdates)
+                                   {
+                                       const auto scanned(static_cast<uint32_t>(update + 1));
+                                       listener.onFolderTransferUpdate(
+                                           api,
+                                           &transfer,
+                                           mega::MegaTransfer::STAGE_SCAN,
+                                           scanned,
+                                           0,
+                                           10 * scanned,
+                                           nullptr,
+                                           nullptr);
+                                   }
+                                   else
+                                   {
+                                       const auto created(static_cast<uint32_t>(
+                                           static_cast<uint64_t>(update - scanUpdates + 1) *
+                                           folders / createUpdates));
+                                       listener.onFolderTransferUpdate(
+                                           api,
+                                           &transfer,
+                                           mega::MegaTransfer::STAGE_CREATE_TREE,
+                                           folders,
+                                           created,
+                                           10 * folders,
+                                           nullptr,
+                                           nullptr);
+                                   }
+                               }
+                               ++finishedTransfers;
+                           });
+                   }
+                   context.waitUntil(
+                       [&finishedTransfers, transfers]()
+                       {
+                           return finishedTransfers == transfers;
+                       });
+                   context.addEvents(static_cast<qint64>(transfers) * updatesPerTransfer);
+                   context.stop();
+
+                   for (auto& thread: threads)
+                   {
+                       thread.join();
+                   }
+
+                   // The timer of the listener reports the last values of every transfer
+                   const auto totalFolders(static_cast<uint32_t>(transfers) * folders);
+                   context.waitUntil(
+                       [&lastEvent, totalFolders]()
+                       {
+                           return lastEvent.stage == mega::MegaTransfer::STAGE_CREATE_TREE &&
+                                  lastEvent.createdfoldercount == totalFolders &&
+                                  lastEvent.foldercount == totalFolders;
+                       });
+                   context.setMetric(QLatin1String("aggregatedEvents"), aggregatedEvents);
+               });
+}
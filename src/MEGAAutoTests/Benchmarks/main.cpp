@@ -0,0 +1,166 @@
+#include "Benchmarks.h"
+#include "MegaApplication.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QStandardPaths>
+
+#include <iostream>
+
+/******************************
+ *
+ * Note about Benchmarks :
+ *
+ * They replay synthetic SDK events into the app classes, without an account, and print a JSON
+ * report with the throughput, the GUI thread stalls and the peak memory of each benchmark.
+ * Run them headless with QT_QPA_PLATFORM=offscreen (the default if it is not set).
+ *
+ * Parameters :
+ * --list : list the benchmarks
+ * --filter <text> : only run the benchmarks whose name contains the text
+ * --param <name>=<value> : override a parameter, as "<benchmark>.<parameter>" or "<parameter>"
+ * --params <file> : same, from a JSON object
+ * --revision <text> : stored in the report, to compare results across commits
+ * --output <file> : write the report to a file instead of the standard output
+ *
+ * The exit code is not zero if any benchmark failed.
+ *
+ *****************************/
+
+void qtSilencedHandler(QtMsgType type, const QMessageLogContext&, const QString&)
+{
+    if (type == QtFatalMsg)
+    {
+        abort();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    // The data folder of the app (preferences, SDK cache) is a throwaway test one
+    QStandardPaths::setTestModeEnabled(true);
+    qInstallMessageHandler(qtSilencedHandler);
+
+    MegaApplication app(argc, argv);
+    app.initialize();
+
+    BenchmarkRunner runner;
+    registerStartupBenchmarks(runner);
+    registerTokenizerBenchmarks(runner);
+    registerTransfersBenchmarks(runner);
+    registerStalledIssuesBenchmarks(runner);
+    registerNodeSelectorBenchmarks(runner);
+    registerSyncsBenchmarks(runner);
+    registerExtServerBenchmarks(runner);
+    registerHTTPServerBenchmarks(runner);
+    registerLoggerBenchmarks(runner);
+    registerBugReportBenchmarks(runner);
+
+    QString filter;
+    QString outputPath;
+    QString revision;
+    QJsonObject parameters;
+
+    const auto arguments(app.arguments());
+    for (int index = 1; index < arguments.size(); ++index)
+    {
+        const auto& argument(arguments.at(index));
+        const bool hasValue(index + 1 < arguments.size());
+
+        if (argument == QLatin1String("--list"))
+        {
+            for (const auto& name: runner.getNames())
+            {
+                std::cout << name.toStdString() << std::endl;
+            }
+            return 0;
+        }
+        else if (argument == QLatin1String("--filter") && hasValue)
+        {
+            filter = arguments.at(++index);
+        }
+        else if (argument == QLatin1String("--output") && hasValue)
+        {
+            outputPath = arguments.at(++index);
+        }
+        else if (argument == QLatin1String("--revision") && hasValue)
+        {
+            revision = arguments.at(++index);
+        }
+        else if (argument == QLatin1String("--param") && hasValue)
+        {
+            const auto parameter(arguments.at(++index));
+            const auto separator(parameter.indexOf(QLatin1Char('=')));
+            bool ok(false);
+            const int value(parameter.mid(separator + 1).toInt(&ok));
+            if (separator <= 0 || !ok)
+            {
+                std::cerr << "Invalid parameter: " << parameter.toStdString() << std::endl;
+                return 1;
+            }
+            parameters.insert(parameter.left(separator), value);
+        }
+        else if (argument == QLatin1String("--params") && hasValue)
+        {
+            QFile file(arguments.at(++index));
+            const auto document(file.open(QIODevice::ReadOnly) ?
+                                    QJsonDocument::fromJson(file.readAll()) :
+                                    QJsonDocument());
+            if (!document.isObject())
+            {
+                std::cerr << "Invalid parameters file: " << file.fileName().toStdString()
+                          << std::endl;
+                return 1;
+            }
+
+            const auto fileParameters(document.object());
+            for (auto it = fileParameters.constBegin(); it != fileParameters.constEnd(); ++it)
+            {
+                parameters.insert(it.key(), it.value());
+            }
+        }
+        else
+        {
+            std::cerr << "Unknown argument: " << argument.toStdString() << std::endl;
+            return 1;
+        }
+    }
+
+    auto report(runner.run(filter, parameters));
+    if (!revision.isEmpty())
+    {
+        report.insert(QLatin1String("revision"), revision);
+    }
+
+    const auto json(QJsonDocument(report).toJson(QJsonDocument::Indented));
+    if (outputPath.isEmpty())
+    {
+        std::cout << json.constData();
+    }
+    else
+    {
+        QFile output(outputPath);
+        if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate) || output.write(json) < 0)
+        {
+            std::cerr << "Cannot write the report to " << outputPath.toStdString() << std::endl;
+            return 1;
+        }
+    }
+
+    const auto results(report.value(QLatin1String("benchmarks")).toArray());
+    for (const auto& result: results)
+    {
+        const auto status(result.toObject().value(QLatin1String("status")).toString());
+        if (status != QLatin1String("passed"))
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
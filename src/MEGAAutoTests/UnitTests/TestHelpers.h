@@ -0,0 +1,40 @@
+#ifndef TESTHELPERS_H
+#define TESTHELPERS_H
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+#include <functional>
+
+namespace TestHelpers
+{
+constexpr int WAIT_TIMEOUT_MS = 5000;
+constexpr int EVENTS_INTERVAL_MS = 10;
+
+// Processes events until the condition is true or the timeout expires. Returns the condition, so
+// it can be checked with REQUIRE. Timing tests can process events more often than the default
+inline bool waitUntil(const std::function<bool()>& condition,
+                      int eventsIntervalMs = EVENTS_INTERVAL_MS)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition() && timer.elapsed() < WAIT_TIMEOUT_MS)
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, eventsIntervalMs);
+    }
+    return condition();
+}
+
+// Processes events for a while, to check that something does not happen
+inline void processEventsFor(int milliseconds)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < milliseconds)
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, EVENTS_INTERVAL_MS);
+    }
+}
+}
+
+#endif // TESTHELPERS_H
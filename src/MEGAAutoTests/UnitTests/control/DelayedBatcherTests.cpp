@@ -0,0 +1,126 @@
+#include "DelayedBatcher.h"
+#include "TestHelpers.h"
+#include <catch.hpp>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+#include <vector>
+
+namespace
+{
+using TestHelpers::waitUntil;
+
+constexpr int DELAY_MS = 50;
+// Timers and clocks are read at different moments, allow for the rounding
+constexpr int TOLERANCE_MS = 2;
+// The releases are timed, so the events are processed more often than by default
+constexpr int EVENTS_INTERVAL_MS = 1;
+
+// Items are the time they were added, so each release can check how long they waited
+struct TestBatcher
+{
+    TestBatcher():
+        batcher(DELAY_MS,
+                [this](std::vector<qint64> items)
+                {
+                    releases.push_back({clock.elapsed(), std::move(items)});
+                })
+    {
+        clock.start();
+    }
+
+    void add()
+    {
+        batcher.add(clock.elapsed());
+        ++added;
+    }
+
+    int getReleasedCount() const
+    {
+        int count(0);
+        for (const auto& release: releases)
+        {
+            count += static_cast<int>(release.items.size());
+        }
+        return count;
+    }
+
+    struct Release
+    {
+        qint64 timeMs;
+        std::vector<qint64> items;
+    };
+
+    QElapsedTimer clock;
+    DelayedBatcher<qint64> batcher;
+    std::vector<Release> releases;
+    int added = 0;
+};
+}
+
+TEST_CASE("DelayedBatcher")
+{
+    TestBatcher test;
+
+    SECTION("An item added while another one waits still waits the whole delay")
+    {
+        test.add();
+        REQUIRE(waitUntil(
+            [&test]()
+            {
+                return test.clock.elapsed() >= DELAY_MS / 2;
+            },
+            EVENTS_INTERVAL_MS));
+        test.add();
+
+        REQUIRE(waitUntil(
+            [&test]()
+            {
+                return test.getReleasedCount() == 2;
+            },
+            EVENTS_INTERVAL_MS));
+        for (const auto& release: test.releases)
+        {
+            for (auto addedMs: release.items)
+            {
+                REQUIRE(release.timeMs - addedMs >= DELAY_MS - TOLERANCE_MS);
+            }
+        }
+    }
+
+    SECTION("A continuous stream is released once per delay, in order")
+    {
+        constexpr int STREAM_MS = 10 * DELAY_MS;
+        while (test.clock.elapsed() < STREAM_MS)
+        {
+            test.add();
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 5);
+        }
+
+        REQUIRE(waitUntil(
+            [&test]()
+            {
+                return test.getReleasedCount() == test.added && test.batcher.isEmpty();
+            },
+            EVENTS_INTERVAL_MS));
+
+        qint64 previousReleaseMs(-DELAY_MS);
+        qint64 previousAddedMs(-1);
+        for (const auto& release: test.releases)
+        {
+            REQUIRE(release.timeMs - previousReleaseMs >= DELAY_MS - TOLERANCE_MS);
+            previousReleaseMs = release.timeMs;
+
+            for (auto addedMs: release.items)
+            {
+                REQUIRE(addedMs >= previousAddedMs);
+                REQUIRE(release.timeMs - addedMs >= DELAY_MS - TOLERANCE_MS);
+                // At most two delays, plus some slack for a busy test machine
+                REQUIRE(release.timeMs - addedMs <= 3 * DELAY_MS);
+                previousAddedMs = addedMs;
+            }
+        }
+        REQUIRE(test.releases.size() <= static_cast<size_t>(STREAM_MS / DELAY_MS + 2));
+    }
+}
@@ -0,0 +1,46 @@
+#include "FolderInfoRequests.h"
+#include <catch.hpp>
+
+namespace
+{
+constexpr mega::MegaHandle FOLDER = 1;
+constexpr mega::MegaHandle OTHER_FOLDER = 2;
+}
+
+TEST_CASE("FolderInfoRequests")
+{
+    FolderInfoRequests requests(3);
+
+    SECTION("Each request of a folder queued twice is matched by its own response")
+    {
+        requests.start(FOLDER);
+        requests.start(FOLDER);
+
+        REQUIRE(requests.finish(FOLDER));
+        REQUIRE(requests.getInFlightCount() == 1);
+        REQUIRE(requests.finish(FOLDER));
+        REQUIRE(requests.getInFlightCount() == 0);
+        REQUIRE_FALSE(requests.finish(FOLDER));
+    }
+
+    SECTION("Duplicated folders count towards the limit")
+    {
+        requests.start(FOLDER);
+        requests.start(FOLDER);
+        requests.start(OTHER_FOLDER);
+
+        REQUIRE_FALSE(requests.canStart());
+        REQUIRE(requests.finish(FOLDER));
+        REQUIRE(requests.canStart());
+    }
+
+    SECTION("Responses to requests of a previous check are ignored")
+    {
+        requests.start(FOLDER);
+        requests.clear();
+
+        REQUIRE_FALSE(requests.finish(FOLDER));
+        REQUIRE_FALSE(requests.finish(OTHER_FOLDER));
+        REQUIRE(requests.getInFlightCount() == 0);
+    }
+}
@@ -0,0 +1,122 @@
+#include "FolderLinkApiPool.h"
+#include <catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <vector>
+
+namespace
+{
+// The pool never uses the sessions, so any distinct addresses work
+std::array<char, 3> sessionStorage;
+
+mega::MegaApi* fakeSession(size_t index)
+{
+    return reinterpret_cast<mega::MegaApi*>(&sessionStorage[index]);
+}
+}
+
+TEST_CASE("FolderLinkApiPool acquire()")
+{
+    size_t createdSessions(0);
+    FolderLinkApiPool pool(fakeSession(0),
+                           [&createdSessions]()
+                           {
+                               return fakeSession(++createdSessions);
+                           },
+                           nullptr,
+                           3);
+
+    SECTION("Sessions are created up to the limit and reused once released")
+    {
+        auto first = pool.acquire();
+        auto second = pool.acquire();
+        auto third = pool.acquire();
+
+        REQUIRE(first == fakeSession(0));
+        REQUIRE(second == fakeSession(1));
+        REQUIRE(third == fakeSession(2));
+        REQUIRE(pool.acquire() == nullptr);
+
+        pool.release(second);
+        REQUIRE(pool.acquire() == second);
+        REQUIRE(createdSessions == 2);
+        REQUIRE(pool.getApis().size() == 3);
+    }
+
+    SECTION("A lower limit keeps the sessions already created")
+    {
+        pool.acquire();
+        pool.acquire();
+        pool.setMaxSessions(1);
+
+        REQUIRE(pool.acquire() == nullptr);
+        REQUIRE(pool.getApis().size() == 2);
+    }
+}
+
+TEST_CASE("FolderLinkApiLeases")
+{
+    std::vector<mega::MegaApi*> loggedOutSessions;
+    std::vector<std::function<void()>> pendingLogouts;
+    size_t createdSessions(0);
+    FolderLinkApiPool pool(
+        fakeSession(0),
+        [&createdSessions]()
+        {
+            return fakeSession(++createdSessions);
+        },
+        [&loggedOutSessions, &pendingLogouts](mega::MegaApi* api, std::function<void()> onLoggedOut)
+        {
+            loggedOutSessions.push_back(api);
+            pendingLogouts.push_back(onLoggedOut);
+        },
+        2);
+    int releasedSessions(0);
+    QObject::connect(&pool,
+                     &FolderLinkApiPool::sessionReleased,
+                     [&releasedSessions]()
+                     {
+                         ++releasedSessions;
+                     });
+
+    SECTION("Sessions released by their owner are not logged out")
+    {
+        FolderLinkApiLeases leases(&pool);
+        auto session = leases.acquire();
+        REQUIRE(leases.getCount() == 1);
+
+        leases.release(session);
+        REQUIRE(leases.getCount() == 0);
+        REQUIRE(releasedSessions == 1);
+        REQUIRE(loggedOutSessions.empty());
+    }
+
+    SECTION("Destroying the owner while a session is in use gives it back after a logout")
+    {
+        mega::MegaApi* abandonedSession(nullptr);
+        {
+            FolderLinkApiLeases leases(&pool);
+            leases.release(leases.acquire());
+            abandonedSession = leases.acquire();
+            REQUIRE(leases.acquire() != nullptr);
+            REQUIRE(pool.acquire() == nullptr);
+        }
+
+        REQUIRE(loggedOutSessions.size() == 2);
+        REQUIRE(std::find(loggedOutSessions.begin(), loggedOutSessions.end(), abandonedSession) !=
+                loggedOutSessions.end());
+        // The sessions are still logging out
+        REQUIRE(pool.acquire() == nullptr);
+
+        for (const auto& onLoggedOut: pendingLogouts)
+        {
+            onLoggedOut();
+        }
+        REQUIRE(releasedSessions == 3);
+        REQUIRE(pool.acquire() != nullptr);
+        REQUIRE(pool.acquire() != nullptr);
+        REQUIRE(createdSessions == 1);
+    }
+}
@@ -0,0 +1,99 @@
+#include "HTTPRequestParser.h"
+#include <catch.hpp>
+
+namespace
+{
+const QByteArray VERSION_REQUEST("POST / HTTP/1.1\r\n"
+                                 "Origin: https://mega.nz\r\n"
+                                 "Content-Length: 9\r\n"
+                                 "\r\n"
+                                 "{\"a\":\"v\"}");
+}
+
+TEST_CASE("HTTPRequestParser parse()")
+{
+    HTTPRequestParser parser;
+
+    SECTION("A request split in several reads is parsed once complete")
+    {
+        const int splitPositions[] = {5, 30, VERSION_REQUEST.size() - 1};
+        int from = 0;
+        for (int position : splitPositions)
+        {
+            parser.feed(VERSION_REQUEST.mid(from, position - from));
+            REQUIRE(parser.parse() == HTTPRequestParser::Status::INCOMPLETE);
+            from = position;
+        }
+
+        parser.feed(VERSION_REQUEST.mid(from));
+        REQUIRE(parser.parse() == HTTPRequestParser::Status::COMPLETE);
+        REQUIRE(parser.method() == "POST");
+        REQUIRE(parser.headers().at(1) == QLatin1String("Origin: https://mega.nz"));
+        REQUIRE(parser.body() == "{\"a\":\"v\"}");
+        REQUIRE(parser.keepAlive());
+        REQUIRE_FALSE(parser.hasPendingData());
+    }
+
+    SECTION("Pipelined requests are parsed in order")
+    {
+        QByteArray closingRequest(VERSION_REQUEST);
+        closingRequest.replace("Content-Length", "Connection: close\r\nContent-Length");
+        parser.feed(VERSION_REQUEST + closingRequest);
+
+        REQUIRE(parser.parse() == HTTPRequestParser::Status::COMPLETE);
+        REQUIRE(parser.keepAlive());
+        REQUIRE(parser.hasPendingData());
+
+        REQUIRE(parser.parse() == HTTPRequestParser::Status::COMPLETE);
+        REQUIRE(parser.body() == "{\"a\":\"v\"}");
+        REQUIRE_FALSE(parser.keepAlive());
+        REQUIRE(parser.parse() == HTTPRequestParser::Status::INCOMPLETE);
+    }
+
+    SECTION("The body is measured in bytes")
+    {
+        const QByteArray body(QString::fromUtf8("{\"n\":\"\xc3\xa9t\xc3\xa9\"}").toUtf8());
+        parser.feed("POST / HTTP/1.0\r\nContent-Length: " + QByteArray::number(body.size()) +
+                    "\r\n\r\n" + body);
+
+        REQUIRE(parser.parse() == HTTPRequestParser::Status::COMPLETE);
+        REQUIRE(parser.body() == body);
+        REQUIRE_FALSE(parser.keepAlive());
+    }
+
+    SECTION("The target of a transfer events request is kept, with its query")
+    {
+        parser.feed("GET /transfers/events?interval=100 HTTP/1.1\r\n"
+                    "Origin: https://mega.nz\r\n"
+                    "Accept: text/event-stream\r\n"
+                    "\r\n");
+
+        REQUIRE(parser.parse() == HTTPRequestParser::Status::COMPLETE);
+        REQUIRE(parser.method() == "GET");
+        REQUIRE(parser.target() == "/transfers/events?interval=100");
+        REQUIRE(parser.body().isEmpty());
+        REQUIRE(parser.keepAlive());
+    }
+
+    SECTION("Invalid requests are detected")
+    {
+        SECTION("POST without Content-Length")
+        {
+            parser.feed("POST / HTTP/1.1\r\n\r\n");
+            REQUIRE(parser.parse() == HTTPRequestParser::Status::LENGTH_REQUIRED);
+        }
+
+        SECTION("Malformed request line")
+        {
+            parser.feed("POST /\r\n\r\n");
+            REQUIRE(parser.parse() == HTTPRequestParser::Status::BAD_REQUEST);
+        }
+
+        SECTION("Unbounded head")
+        {
+            parser.feed("POST / HTTP/1.1\r\nX-Filler: " +
+                        QByteArray(HTTPRequestParser::MAX_HEADER_SIZE, 'x'));
+            REQUIRE(parser.parse() == HTTPRequestParser::Status::PAYLOAD_TOO_LARGE);
+        }
+    }
+}
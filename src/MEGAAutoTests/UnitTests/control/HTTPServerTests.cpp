@@ -0,0 +1,198 @@
+#include "HTTPServer.h"
+#include "Preferences.h"
+#include "TestHelpers.h"
+#include <catch.hpp>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTcpSocket>
+
+#include <memory>
+
+namespace
+{
+using TestHelpers::processEventsFor;
+using TestHelpers::waitUntil;
+
+const mega::MegaHandle FIRST_HANDLE = 1;
+const mega::MegaHandle SECOND_HANDLE = 2;
+const QByteArray EVENT_PREFIX("event: transfers\r\ndata: ");
+const QByteArray EVENTS_REQUEST("GET /transfers/events?interval=100 HTTP/1.1\r\n"
+                                "Origin: https://mega.nz\r\n"
+                                "\r\n");
+
+// Progress of each transfer in the event, by base64 handle
+QHash<QString, qint64> getEventProgress(const QByteArray& event)
+{
+    REQUIRE(event.startsWith(EVENT_PREFIX));
+    REQUIRE(event.endsWith("\r\n\r\n"));
+
+    const auto data(event.mid(EVENT_PREFIX.size(), event.size() - EVENT_PREFIX.size() - 4));
+    QHash<QString, qint64> progress;
+    for (const auto& value: QJsonDocument::fromJson(data).array())
+    {
+        const auto transfer(value.toObject());
+        progress.insert(transfer.value(QLatin1String("h")).toString(),
+                        static_cast<qint64>(transfer.value(QLatin1String("p")).toDouble()));
+    }
+    return progress;
+}
+
+QString toBase64(mega::MegaHandle handle)
+{
+    std::unique_ptr<char[]> base64Handle(mega::MegaApi::handleToBase64(handle));
+    return QString::fromUtf8(base64Handle.get());
+}
+
+// The allowed origins come from the service URLs, which are not relevant here
+class OriginCheckDisabler
+{
+public:
+    OriginCheckDisabler():
+        mEnabled(Preferences::HTTPS_ORIGIN_CHECK_ENABLED)
+    {
+        Preferences::HTTPS_ORIGIN_CHECK_ENABLED = false;
+    }
+
+    ~OriginCheckDisabler()
+    {
+        Preferences::HTTPS_ORIGIN_CHECK_ENABLED = mEnabled;
+    }
+
+private:
+    bool mEnabled;
+};
+}
+
+TEST_CASE("TransferEventsSubscriber")
+{
+    RequestTransferData first;
+    first.progress = 10;
+    RequestTransferData second;
+    second.progress = 20;
+    const QHash<mega::MegaHandle, RequestTransferData*> transfers{{FIRST_HANDLE, &first},
+                                                                   {SECOND_HANDLE, &second}};
+    TransferEventsSubscriber subscriber;
+
+    SECTION("The stream head announces an event stream on a persistent connection")
+    {
+        const auto head(TransferEventsSubscriber::getStreamHead(QLatin1String("https://mega.nz")));
+
+        REQUIRE(head.startsWith("HTTP/1.1 200 Ok\r\n"));
+        REQUIRE(head.contains("\r\nAccess-Control-Allow-Origin: https://mega.nz\r\n"));
+        REQUIRE(head.contains("\r\nContent-Type: text/event-stream\r\n"));
+        REQUIRE(head.contains("\r\nCache-Control: no-cache\r\n"));
+        REQUIRE(head.contains("\r\nConnection: keep-alive\r\n"));
+        REQUIRE(head.endsWith("\r\n\r\nretry: 3000\r\n\r\n"));
+    }
+
+    SECTION("The interval requested is bounded")
+    {
+        REQUIRE(TransferEventsSubscriber::getInterval(QUrl(QLatin1String("/transfers/events"))) ==
+                HTTPServer::TRANSFER_EVENTS_DEFAULT_INTERVAL_MS);
+        REQUIRE(TransferEventsSubscriber::getInterval(
+                    QUrl(QLatin1String("/transfers/events?interval=1"))) ==
+                HTTPServer::TRANSFER_EVENTS_MIN_INTERVAL_MS);
+        REQUIRE(TransferEventsSubscriber::getInterval(
+                    QUrl(QLatin1String("/transfers/events?interval=1000"))) == 1000);
+    }
+
+    SECTION("Updates are coalesced until the next flush")
+    {
+        subscriber.queue(FIRST_HANDLE);
+        subscriber.queue(SECOND_HANDLE);
+        first.progress = 15;
+        subscriber.queue(FIRST_HANDLE);
+
+        const auto progress(getEventProgress(subscriber.takeEvent(transfers, 0)));
+        REQUIRE(progress.size() == 2);
+        REQUIRE(progress.value(toBase64(FIRST_HANDLE)) == 15);
+        REQUIRE(progress.value(toBase64(SECOND_HANDLE)) == 20);
+
+        // Nothing new since the last flush
+        REQUIRE(subscriber.takeEvent(transfers, 0).isEmpty());
+
+        second.progress = 25;
+        subscriber.queue(SECOND_HANDLE);
+        const auto nextProgress(getEventProgress(subscriber.takeEvent(transfers, 0)));
+        REQUIRE(nextProgress.size() == 1);
+        REQUIRE(nextProgress.value(toBase64(SECOND_HANDLE)) == 25);
+    }
+
+    SECTION("Updates wait while the browser has not read what was sent")
+    {
+        subscriber.queue(FIRST_HANDLE);
+        REQUIRE(subscriber
+                    .takeEvent(transfers, HTTPServer::TRANSFER_EVENTS_MAX_PENDING_BYTES + 1)
+                    .isEmpty());
+
+        first.progress = 30;
+        const auto progress(getEventProgress(subscriber.takeEvent(transfers, 0)));
+        REQUIRE(progress.size() == 1);
+        REQUIRE(progress.value(toBase64(FIRST_HANDLE)) == 30);
+    }
+
+    SECTION("Handles that are not tracked are skipped")
+    {
+        subscriber.queue(SECOND_HANDLE + 1);
+        REQUIRE(subscriber.takeEvent(transfers, 0).isEmpty());
+    }
+}
+
+TEST_CASE("HTTPServer transfer events stream")
+{
+    OriginCheckDisabler originCheckDisabler;
+    HTTPServer server(nullptr, 0);
+    REQUIRE(server.isListening());
+
+    QTcpSocket client;
+    QByteArray received;
+    QObject::connect(&client,
+                     &QTcpSocket::readyRead,
+                     [&client, &received]()
+                     {
+                         received.append(client.readAll());
+                     });
+    client.connectToHost(QHostAddress::LocalHost, server.serverPort());
+    REQUIRE(waitUntil(
+        [&client]()
+        {
+            return client.state() == QAbstractSocket::ConnectedState;
+        }));
+
+    client.write(EVENTS_REQUEST);
+    REQUIRE(waitUntil(
+        [&received]()
+        {
+            return received.endsWith("retry: 3000\r\n\r\n");
+        }));
+    REQUIRE(received.startsWith("HTTP/1.1 200 Ok\r\n"));
+    REQUIRE(received.contains("\r\nContent-Type: text/event-stream\r\n"));
+    REQUIRE(server.getTransferEventsSubscribersCount() == 1);
+
+    SECTION("The stream stays open across several flush intervals")
+    {
+        processEventsFor(5 * HTTPServer::TRANSFER_EVENTS_MIN_INTERVAL_MS);
+
+        REQUIRE(client.state() == QAbstractSocket::ConnectedState);
+        REQUIRE(server.getTransferEventsSubscribersCount() == 1);
+        // No transfer is tracked, so nothing is sent after the head
+        REQUIRE(received.endsWith("retry: 3000\r\n\r\n"));
+    }
+
+    SECTION("A client disconnect removes the subscriber")
+    {
+        client.disconnectFromHost();
+        REQUIRE(waitUntil(
+            [&server]()
+            {
+                return server.getTransferEventsSubscribersCount() == 0;
+            }));
+
+        // Later updates do not reach the closed connection
+        HTTPServer::onTransferDataUpdate(FIRST_HANDLE, 0, 0, 0, 0, QString());
+        processEventsFor(2 * HTTPServer::TRANSFER_EVENTS_MIN_INTERVAL_MS);
+        REQUIRE(server.getTransferEventsSubscribersCount() == 0);
+    }
+}
@@ -0,0 +1,299 @@
+#include "ImageCache.h"
+#include "ImageDownloader.h"
+#include "TestHelpers.h"
+#include <catch.hpp>
+
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+
+#include <chrono>
+#include <memory>
+
+namespace
+{
+using TestHelpers::waitUntil;
+
+const QByteArray IMAGE_ETAG("\"v1\"");
+
+QByteArray createPng(const QSize& size)
+{
+    QImage image(size, QImage::Format_ARGB32);
+    image.fill(Qt::red);
+    QByteArray bytes;
+    QBuffer buffer(&bytes);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "PNG");
+    return bytes;
+}
+
+// HTTP server on the loopback interface serving one image, which counts the requests received
+class LoopbackImageServer
+{
+public:
+    LoopbackImageServer():
+        mImage(createPng(QSize(64, 32)))
+    {
+        QObject::connect(&mServer,
+                         &QTcpServer::newConnection,
+                         [this]()
+                         {
+                             while (auto socket = mServer.nextPendingConnection())
+                             {
+                                 QObject::connect(socket,
+                                                  &QTcpSocket::readyRead,
+                                                  socket,
+                                                  [this, socket]()
+                                                  {
+                                                      onReadyRead(socket);
+                                                  });
+                                 QObject::connect(socket,
+                                                  &QTcpSocket::disconnected,
+                                                  socket,
+                                                  &QObject::deleteLater);
+                             }
+                         });
+        mServer.listen(QHostAddress::LocalHost);
+    }
+
+    QString getUrl() const
+    {
+        return QString::fromLatin1("http://127.0.0.1:%1/banner.png").arg(mServer.serverPort());
+    }
+
+    int requests = 0;
+    int notModifiedReplies = 0;
+
+private:
+    void onReadyRead(QTcpSocket* socket)
+    {
+        auto& request(mRequests[socket]);
+        request.append(socket->readAll());
+        if (!request.contains("\r\n\r\n"))
+        {
+            return;
+        }
+
+        ++requests;
+        QByteArray reply;
+        if (request.contains("If-None-Match: " + IMAGE_ETAG))
+        {
+            ++notModifiedReplies;
+            reply = "HTTP/1.1 304 Not Modified\r\nETag: " + IMAGE_ETAG +
+                    "\r\nConnection: close\r\n\r\n";
+        }
+        else
+        {
+            reply = "HTTP/1.1 200 OK\r\nContent-Type: image/png\r\nETag: " + IMAGE_ETAG +
+                    "\r\nContent-Length: " + QByteArray::number(mImage.size()) +
+                    "\r\nConnection: close\r\n\r\n" + mImage;
+        }
+        mRequests.remove(socket);
+        socket->write(reply);
+        socket->disconnectFromHost();
+    }
+
+    QTcpServer mServer;
+    QByteArray mImage;
+    QHash<QTcpSocket*, QByteArray> mRequests;
+};
+
+// Downloader with the number of images received
+struct TestDownloader
+{
+    explicit TestDownloader(std::shared_ptr<ImageCache> cache)
+    {
+        downloader.setCache(cache);
+        QObject::connect(&downloader,
+                         &ImageDownloader::downloadFinished,
+                         [this](const QImage& image, const QString&)
+                         {
+                             lastImage = image;
+                             ++images;
+                         });
+    }
+
+    ImageDownloader downloader;
+    QImage lastImage;
+    int images = 0;
+};
+}
+
+TEST_CASE("ImageDownloader against a loopback server")
+{
+    LoopbackImageServer server;
+    QTemporaryDir cacheDirectory;
+    REQUIRE(cacheDirectory.isValid());
+
+    SECTION("Concurrent requests for the same URL share one reply")
+    {
+        auto cache(std::make_shared<ImageCache>(cacheDirectory.path()));
+        TestDownloader first(cache);
+        TestDownloader second(cache);
+        TestDownloader third(cache);
+
+        first.downloader.downloadImage(server.getUrl());
+        second.downloader.downloadImage(server.getUrl());
+        third.downloader.downloadImage(server.getUrl(), QImage::Format_RGB32, QSize(32, 32));
+
+        REQUIRE(waitUntil(
+            [&]()
+            {
+                return first.images == 1 && second.images == 1 && third.images == 1;
+            }));
+        REQUIRE(server.requests == 1);
+        REQUIRE(first.lastImage.size() == QSize(64, 32));
+        // Decoded and scaled to fit, keeping the aspect ratio
+        REQUIRE(third.lastImage.size() == QSize(32, 16));
+        REQUIRE(third.lastImage.format() == QImage::Format_RGB32);
+    }
+
+    SECTION("Requests for the same URL with different caches fill each cache")
+    {
+        QTemporaryDir otherCacheDirectory;
+        REQUIRE(otherCacheDirectory.isValid());
+        auto cache(std::make_shared<ImageCache>(cacheDirectory.path()));
+        auto otherCache(std::make_shared<ImageCache>(otherCacheDirectory.path()));
+        TestDownloader first(cache);
+        TestDownloader second(otherCache);
+
+        first.downloader.downloadImage(server.getUrl());
+        second.downloader.downloadImage(server.getUrl());
+
+        REQUIRE(waitUntil(
+            [&]()
+            {
+                return first.images == 1 && second.images == 1;
+            }));
+        REQUIRE(server.requests == 2);
+        REQUIRE(cache->getEntry(server.getUrl()).has_value());
+        REQUIRE(otherCache->getEntry(server.getUrl()).has_value());
+    }
+
+    SECTION("A fresh cached image is not requested again, even after a restart")
+    {
+        {
+            TestDownloader downloader(std::make_shared<ImageCache>(cacheDirectory.path()));
+            downloader.downloader.downloadImage(server.getUrl());
+            REQUIRE(waitUntil(
+                [&]()
+                {
+                    return downloader.images == 1;
+                }));
+        }
+
+        TestDownloader downloader(std::make_shared<ImageCache>(cacheDirectory.path()));
+        downloader.downloader.downloadImage(server.getUrl());
+        REQUIRE(waitUntil(
+            [&]()
+            {
+                return downloader.images == 1;
+            }));
+        REQUIRE(server.requests == 1);
+    }
+
+    SECTION("An outdated cached image is revalidated with a conditional request")
+    {
+        auto cache(std::make_shared<ImageCache>(cacheDirectory.path(),
+                                                ImageCache::DEFAULT_MAX_SIZE,
+                                                std::chrono::seconds(0)));
+        TestDownloader downloader(cache);
+
+        downloader.downloader.downloadImage(server.getUrl());
+        REQUIRE(waitUntil(
+            [&]()
+            {
+                return downloader.images == 1;
+            }));
+
+        downloader.downloader.downloadImage(server.getUrl());
+        REQUIRE(waitUntil(
+            [&]()
+            {
+                return downloader.images == 2;
+            }));
+        REQUIRE(server.requests == 2);
+        REQUIRE(server.notModifiedReplies == 1);
+        REQUIRE(downloader.lastImage.size() == QSize(64, 32));
+    }
+}
+
+TEST_CASE("ImageCache eviction")
+{
+    QTemporaryDir cacheDirectory;
+    REQUIRE(cacheDirectory.isValid());
+
+    const QByteArray content(100, 'a');
+    ImageCache cache(cacheDirectory.path(), 3 * content.size());
+
+    SECTION("The least recently used images are evicted when the cache is full")
+    {
+        cache.store(QLatin1String("first"), content + "1", QByteArray(), QByteArray());
+        cache.store(QLatin1String("second"), content + "2", QByteArray(), QByteArray());
+        REQUIRE(cache.getEntry(QLatin1String("first")).has_value());
+        cache.store(QLatin1String("third"), content + "3", QByteArray(), QByteArray());
+
+        REQUIRE(cache.getSize() <= 3 * content.size());
+        REQUIRE_FALSE(cache.getEntry(QLatin1String("second")).has_value());
+        REQUIRE(cache.getEntry(QLatin1String("first")).has_value());
+        REQUIRE(cache.getEntry(QLatin1String("third")).has_value());
+    }
+
+    SECTION("URLs with the same content share one file")
+    {
+        cache.store(QLatin1String("first"), content, QByteArray(), QByteArray());
+        cache.store(QLatin1String("second"), content, QByteArray(), QByteArray());
+        REQUIRE(cache.getSize() == content.size());
+
+        cache.remove(QLatin1String("first"));
+        auto entry(cache.getEntry(QLatin1String("second")));
+        REQUIRE(entry.has_value());
+        REQUIRE(cache.read(entry.value()) == content);
+    }
+}
+
+TEST_CASE("ImageCache index")
+{
+    QTemporaryDir cacheDirectory;
+    REQUIRE(cacheDirectory.isValid());
+
+    const QByteArray content(100, 'a');
+    const auto maxSize(3 * content.size());
+
+    SECTION("The access order of cache hits is kept after a restart")
+    {
+        {
+            ImageCache cache(cacheDirectory.path(), maxSize);
+            cache.store(QLatin1String("first"), content + "1", QByteArray(), QByteArray());
+            cache.store(QLatin1String("second"), content + "2", QByteArray(), QByteArray());
+            // Saved when the cache is destroyed, before its delay
+            REQUIRE(cache.getEntry(QLatin1String("first")).has_value());
+        }
+
+        ImageCache cache(cacheDirectory.path(), maxSize);
+        cache.store(QLatin1String("third"), content + "3", QByteArray(), QByteArray());
+
+        REQUIRE_FALSE(cache.getEntry(QLatin1String("second")).has_value());
+        REQUIRE(cache.getEntry(QLatin1String("first")).has_value());
+        REQUIRE(cache.getEntry(QLatin1String("third")).has_value());
+    }
+
+    SECTION("Cache hits do not rewrite the index at once")
+    {
+        ImageCache cache(cacheDirectory.path(), maxSize);
+        cache.store(QLatin1String("first"), content, QByteArray(), QByteArray());
+
+        const QString indexPath(QDir(cacheDirectory.path()).filePath(QLatin1String("index.json")));
+        QFile indexFile(indexPath);
+        REQUIRE(indexFile.open(QIODevice::ReadOnly));
+        const auto savedIndex(indexFile.readAll());
+        indexFile.close();
+
+        REQUIRE(cache.getEntry(QLatin1String("first")).has_value());
+        REQUIRE(indexFile.open(QIODevice::ReadOnly));
+        REQUIRE(indexFile.readAll() == savedIndex);
+    }
+}
@@ -0,0 +1,125 @@
+#include "LogBundleBuilder.h"
+#include "TestHelpers.h"
+#include <catch.hpp>
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+namespace
+{
+using TestHelpers::waitUntil;
+
+// The rotated logs are gzip files, but the builder appends them as they are
+QByteArray writeLog(const QDir& logsFolder, int number, const QByteArray& content)
+{
+    QFile log(logsFolder.filePath(QString::fromLatin1("MEGAsync.%1.log").arg(number)));
+    REQUIRE(log.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    REQUIRE(log.write(content) == content.size());
+    return content;
+}
+
+QByteArray readFile(const QString& path)
+{
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::ReadOnly));
+    return file.readAll();
+}
+
+// Staged builder without account, so the bundle name has no email
+struct TestBuilder
+{
+    explicit TestBuilder(const QString& logsFolder):
+        builder(nullptr)
+    {
+        builder.setLogsFolder(logsFolder);
+    }
+
+    QString build()
+    {
+        bool finished(false);
+        QString bundlePath;
+        auto connection(QObject::connect(&builder,
+                                         &LogBundleBuilder::finished,
+                                         [&finished, &bundlePath](QString path)
+                                         {
+                                             bundlePath = path;
+                                             finished = true;
+                                         }));
+        builder.buildAsync();
+        REQUIRE(waitUntil(
+            [&finished]()
+            {
+                return finished;
+            }));
+        QObject::disconnect(connection);
+        REQUIRE_FALSE(bundlePath.isEmpty());
+        return bundlePath;
+    }
+
+    LogBundleBuilder builder;
+};
+
+// Overwrites the start of the staged bundle, so the test can tell a reused member from a member
+// appended again
+QByteArray markFirstMember(const QString& bundlePath, int size)
+{
+    const QByteArray marker(size, 'X');
+    QFile bundle(bundlePath);
+    REQUIRE(bundle.open(QIODevice::ReadWrite));
+    REQUIRE(bundle.write(marker) == marker.size());
+    return marker;
+}
+}
+
+TEST_CASE("LogBundleBuilder staged bundle")
+{
+    QTemporaryDir logsDirectory;
+    REQUIRE(logsDirectory.isValid());
+    const QDir logsFolder(logsDirectory.path());
+    TestBuilder test(logsDirectory.path());
+
+    // The higher the number, the older the log
+    const auto oldestLog(writeLog(logsFolder, 2, QByteArray(1000, 'a')));
+    const auto olderLog(writeLog(logsFolder, 1, QByteArray(2000, 'b')));
+
+    const auto firstBundlePath(test.build());
+    REQUIRE(readFile(firstBundlePath) == oldestLog + olderLog);
+    const auto marker(markFirstMember(firstBundlePath, oldestLog.size()));
+
+    SECTION("A partial member left by an interrupted build is truncated")
+    {
+        {
+            QFile bundle(firstBundlePath);
+            REQUIRE(bundle.open(QIODevice::Append));
+            REQUIRE(bundle.write("partial member") > 0);
+        }
+        const auto lastLog(writeLog(logsFolder, 0, QByteArray(500, 'c')));
+
+        const auto bundlePath(test.build());
+        REQUIRE(bundlePath == firstBundlePath);
+        REQUIRE(readFile(bundlePath) == marker + olderLog + lastLog);
+    }
+
+    SECTION("A changed log file invalidates its member and the following ones")
+    {
+        const auto changedLog(writeLog(logsFolder, 1, QByteArray(2500, 'd')));
+
+        REQUIRE(readFile(test.build()) == marker + changedLog);
+    }
+
+    SECTION("If the first log file changed, the bundle is built again")
+    {
+        const auto changedLog(writeLog(logsFolder, 2, QByteArray(1500, 'e')));
+
+        REQUIRE(readFile(test.build()) == changedLog + olderLog);
+    }
+
+    SECTION("A discarded staging folder is not reused")
+    {
+        test.builder.discardStaging();
+        REQUIRE_FALSE(QFile::exists(firstBundlePath));
+
+        REQUIRE(readFile(test.build()) == oldestLog + olderLog);
+    }
+}
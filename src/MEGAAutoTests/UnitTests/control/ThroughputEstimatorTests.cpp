@@ -0,0 +1,121 @@
+#include "ThroughputEstimator.h"
+#include <catch.hpp>
+
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+// Speeds recorded once per second, starting at the given time
+void addTrace(ThroughputEstimator& estimator,
+              const std::vector<double>& speeds,
+              std::chrono::milliseconds start = 0ms)
+{
+    auto timestamp(start);
+    for (auto speed: speeds)
+    {
+        estimator.addRateSample(timestamp, speed);
+        timestamp += 1s;
+    }
+}
+}
+
+TEST_CASE("ThroughputEstimator with recorded speed traces")
+{
+    ThroughputEstimator estimator;
+
+    SECTION("There is no estimation without samples")
+    {
+        REQUIRE(estimator.getRegime() == ThroughputEstimator::Regime::NO_SAMPLES);
+        REQUIRE_FALSE(estimator.getEstimate(100).has_value());
+        REQUIRE(estimator.getEstimate(0)->remaining == 0s);
+    }
+
+    SECTION("A noisy steady transfer converges, with bounds around the estimation")
+    {
+        addTrace(estimator, {1000, 1100, 900, 1050, 950, 1000, 1020, 980, 1010, 990});
+
+        REQUIRE(estimator.getRegime() == ThroughputEstimator::Regime::STEADY);
+        REQUIRE(estimator.getRegimeChanges() == 0);
+        REQUIRE(estimator.getRate() == Approx(1000.0).epsilon(0.05));
+
+        auto estimate(estimator.getEstimate(10000));
+        REQUIRE(estimate.has_value());
+        REQUIRE(estimate->remaining >= 10s);
+        REQUIRE(estimate->remaining <= 11s);
+        REQUIRE(estimate->lowerBound < estimate->remaining);
+        REQUIRE(estimate->upperBound > estimate->remaining);
+    }
+
+    SECTION("An isolated spike is damped")
+    {
+        addTrace(estimator, {1000, 1000, 1000, 1000, 1000, 10000, 1000, 1000});
+
+        REQUIRE(estimator.getRegimeChanges() == 0);
+        REQUIRE(estimator.getRate() < 1100.0);
+    }
+
+    SECTION("A bandwidth limit starts a new regime")
+    {
+        addTrace(estimator, {1000, 1000, 1000, 1000, 1000, 1000, 250, 250, 250});
+
+        REQUIRE(estimator.getRegimeChanges() == 1);
+        REQUIRE(estimator.getRegime() == ThroughputEstimator::Regime::WARMING_UP);
+        REQUIRE(estimator.getRate() == Approx(250.0));
+        REQUIRE(estimator.getEstimate(1000)->remaining == 4s);
+    }
+
+    SECTION("A paused transfer stalls and restarts when it resumes")
+    {
+        addTrace(estimator, {1000, 1000, 1000, 1000, 1000, 0, 0});
+        REQUIRE(estimator.getRegime() != ThroughputEstimator::Regime::STALLED);
+
+        estimator.addRateSample(7s, 0);
+        REQUIRE(estimator.getRegime() == ThroughputEstimator::Regime::STALLED);
+        REQUIRE_FALSE(estimator.getEstimate(10000).has_value());
+
+        estimator.addRateSample(8s, 2000);
+        REQUIRE(estimator.getRegimeChanges() == 1);
+        REQUIRE(estimator.getEstimate(10000)->remaining == 5s);
+    }
+}
+
+TEST_CASE("ThroughputEstimator with progress samples")
+{
+    ThroughputEstimator estimator;
+
+    SECTION("There is no estimation until the rate is measured")
+    {
+        estimator.addProgressSample(1000ms, 0);
+        REQUIRE_FALSE(estimator.getEstimateForTotal(100).has_value());
+
+        // Too close to the previous sample to measure the rate
+        estimator.addProgressSample(1100ms, 10);
+        REQUIRE_FALSE(estimator.getEstimateForTotal(100).has_value());
+
+        estimator.addProgressSample(2000ms, 10);
+        REQUIRE(estimator.getRate() == Approx(10.0));
+        REQUIRE(estimator.getEstimateForTotal(100)->remaining == 9s);
+    }
+
+    SECTION("The rate averages the first samples")
+    {
+        estimator.addProgressSample(0ms, 0);
+        estimator.addProgressSample(1000ms, 100);
+        estimator.addProgressSample(2000ms, 300);
+
+        REQUIRE(estimator.getRate() == Approx(150.0));
+        REQUIRE(estimator.getEstimateForTotal(300)->remaining == 0s);
+    }
+
+    SECTION("A counter going back restarts the estimation")
+    {
+        estimator.addProgressSample(0ms, 0);
+        estimator.addProgressSample(1000ms, 100);
+        estimator.addProgressSample(2000ms, 5);
+
+        REQUIRE(estimator.getRate() == Approx(0.0));
+        REQUIRE_FALSE(estimator.getEstimateForTotal(100).has_value());
+    }
+}
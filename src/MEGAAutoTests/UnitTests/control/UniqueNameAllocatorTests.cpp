@@ -0,0 +1,48 @@
+#include "UniqueNameAllocator.h"
+#include <catch.hpp>
+
+TEST_CASE("UniqueNameAllocator allocate()")
+{
+    UniqueNameAllocator allocator;
+
+    SECTION("First free counter is used")
+    {
+        allocator.reserve(QStringList{QLatin1String("file.txt"), QLatin1String("file(1).txt")});
+
+        REQUIRE(allocator.allocate(QLatin1String("file"), QLatin1String(".txt")) ==
+                QLatin1String("file(2).txt"));
+    }
+
+    SECTION("Names are compared case insensitively")
+    {
+        allocator.reserve(QLatin1String("FILE(1).TXT"));
+
+        REQUIRE(allocator.allocate(QLatin1String("file"), QLatin1String(".txt")) ==
+                QLatin1String("file(2).txt"));
+    }
+
+    SECTION("Allocated names are reserved for the rest of the batch")
+    {
+        allocator.reserve(QLatin1String("folder(2)"));
+
+        REQUIRE(allocator.allocate(QLatin1String("folder"), QString()) ==
+                QLatin1String("folder(1)"));
+        REQUIRE(allocator.isTaken(QLatin1String("Folder(1)")));
+        REQUIRE(allocator.allocate(QLatin1String("folder"), QString()) ==
+                QLatin1String("folder(3)"));
+        REQUIRE(allocator.allocateCounter(QLatin1String("FOLDER"), QString()) == 4);
+    }
+
+    SECTION("A big batch hands out distinct names")
+    {
+        constexpr auto batchSize{10000};
+        QSet<QString> allocatedNames;
+        for (int index = 0; index < batchSize; ++index)
+        {
+            allocatedNames.insert(allocator.allocate(QLatin1String("photo"), QLatin1String(".jpg")));
+        }
+
+        REQUIRE(allocatedNames.size() == batchSize);
+        REQUIRE(allocatedNames.contains(QLatin1String("photo(10000).jpg")));
+    }
+}
@@ -0,0 +1,78 @@
+#include "FailedIssuesBatch.h"
+#include <catch.hpp>
+
+#include <QString>
+#include <QStringList>
+
+namespace
+{
+QString getKey(const QString& issue)
+{
+    return issue;
+}
+}
+
+TEST_CASE("FailedIssuesBatch")
+{
+    // Issues are their own key, as the model uses the issue pointer
+    QList<QString> failedIssues{QLatin1String("a"),
+                                QLatin1String("b"),
+                                QLatin1String("c"),
+                                QLatin1String("d"),
+                                QLatin1String("e")};
+    FailedIssuesBatch<QString, QString> batch;
+
+    auto taken(batch.take(failedIssues,
+                          QSet<QString>{QLatin1String("b"), QLatin1String("c"), QLatin1String("d")},
+                          getKey));
+
+    REQUIRE(taken == 3);
+    REQUIRE(failedIssues == QList<QString>{QLatin1String("a"), QLatin1String("e")});
+
+    SECTION("Issues not reached by a stopped run go back to the failed list")
+    {
+        // Only "b" was handed to its solver before the run was stopped
+        batch.release(QLatin1String("b"));
+
+        failedIssues.append(batch.takeUnreleased(
+            [](const QString&)
+            {
+                return true;
+            }));
+
+        REQUIRE(failedIssues == QList<QString>{QLatin1String("a"),
+                                               QLatin1String("e"),
+                                               QLatin1String("c"),
+                                               QLatin1String("d")});
+    }
+
+    SECTION("Issues which are not failed anymore do not go back")
+    {
+        // "d" changed externally, so it is potentially solved
+        failedIssues.append(batch.takeUnreleased(
+            [](const QString& issue)
+            {
+                return issue != QLatin1String("d");
+            }));
+
+        REQUIRE(failedIssues == QList<QString>{QLatin1String("a"),
+                                               QLatin1String("e"),
+                                               QLatin1String("b"),
+                                               QLatin1String("c")});
+    }
+
+    SECTION("A finished batch is empty")
+    {
+        batch.release(QLatin1String("b"));
+        batch.release(QLatin1String("c"));
+        batch.release(QLatin1String("d"));
+
+        REQUIRE(batch
+                    .takeUnreleased(
+                        [](const QString&)
+                        {
+                            return true;
+                        })
+                    .isEmpty());
+    }
+}
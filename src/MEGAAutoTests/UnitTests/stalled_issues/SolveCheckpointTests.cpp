@@ -0,0 +1,88 @@
+#include "SolveCheckpoint.h"
+#include <catch.hpp>
+
+#include <QString>
+
+#include <memory>
+
+namespace
+{
+enum class Action
+{
+    NONE,
+    CHOOSE_LOCAL,
+    CHOOSE_REMOTE
+};
+
+using Issue = std::shared_ptr<const QString>;
+using Checkpoint = SolveCheckpoint<Action, QString, int>;
+
+Issue createIssue(const char* name)
+{
+    return std::make_shared<const QString>(QLatin1String(name));
+}
+}
+
+TEST_CASE("SolveCheckpoint")
+{
+    const auto first(createIssue("first"));
+    const auto second(createIssue("second"));
+    const auto third(createIssue("third"));
+    const QList<Issue> selection{first, second, third};
+
+    // A run stopped after processing the first issue
+    Checkpoint checkpoint;
+    REQUIRE_FALSE(checkpoint.begin(Action::CHOOSE_LOCAL, selection));
+    checkpoint.setProcessed(first.get());
+    checkpoint.stop(1);
+
+    SECTION("The same action on the same issues resumes the run")
+    {
+        REQUIRE(checkpoint.begin(Action::CHOOSE_LOCAL, selection));
+        REQUIRE(checkpoint.isProcessed(first.get()));
+        REQUIRE_FALSE(checkpoint.isProcessed(second.get()));
+        REQUIRE(checkpoint.getProgress() == 1);
+        REQUIRE(checkpoint.getIssuesCount() == 3);
+    }
+
+    SECTION("The processed issues may be left out, as they may be solved")
+    {
+        REQUIRE(checkpoint.begin(Action::CHOOSE_LOCAL, QList<Issue>{second, third}));
+        REQUIRE(checkpoint.getIssuesCount() == 3);
+    }
+
+    SECTION("A different action after a stopped run starts from scratch")
+    {
+        REQUIRE_FALSE(checkpoint.begin(Action::CHOOSE_REMOTE, selection));
+        REQUIRE_FALSE(checkpoint.isProcessed(first.get()));
+        REQUIRE(checkpoint.getProgress() == 0);
+
+        // Nor can the first action resume the run anymore
+        checkpoint.stop(0);
+        REQUIRE_FALSE(checkpoint.begin(Action::CHOOSE_LOCAL, selection));
+    }
+
+    SECTION("A different selection starts from scratch")
+    {
+        SECTION("An issue not processed is left out")
+        {
+            REQUIRE_FALSE(checkpoint.begin(Action::CHOOSE_LOCAL, QList<Issue>{first, second}));
+        }
+
+        SECTION("An issue of another run is added")
+        {
+            const auto other(createIssue("other"));
+            REQUIRE_FALSE(
+                checkpoint.begin(Action::CHOOSE_LOCAL, QList<Issue>{first, second, third, other}));
+        }
+
+        REQUIRE_FALSE(checkpoint.isProcessed(first.get()));
+        REQUIRE(checkpoint.getProgress() == 0);
+    }
+
+    SECTION("A run which was not stopped is not resumed")
+    {
+        REQUIRE(checkpoint.begin(Action::CHOOSE_LOCAL, selection));
+        REQUIRE_FALSE(checkpoint.begin(Action::CHOOSE_LOCAL, selection));
+    }
+}
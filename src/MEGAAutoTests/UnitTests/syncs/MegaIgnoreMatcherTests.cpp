@@ -0,0 +1,66 @@
+#include "MegaIgnoreMatcher.h"
+#include <catch.hpp>
+
+namespace
+{
+MegaIgnoreMatcher createMatcher(const QStringList& lines)
+{
+    QList<std::shared_ptr<MegaIgnoreRule>> rules;
+    for (const auto& line: lines)
+    {
+        rules.append(
+            std::make_shared<MegaIgnoreNameRule>(line, line.startsWith(QLatin1String("#"))));
+    }
+    return MegaIgnoreMatcher(rules);
+}
+}
+
+TEST_CASE("MegaIgnoreMatcher isExcluded()")
+{
+    using NodeType = MegaIgnoreMatcher::NodeType;
+
+    SECTION("The last matching rule wins")
+    {
+        auto matcher(createMatcher({QLatin1String("-:*.tmp"), QLatin1String("+:keep.tmp")}));
+
+        REQUIRE(matcher.isExcluded(QLatin1String("a.tmp"), NodeType::FILE));
+        REQUIRE(matcher.isExcluded(QLatin1String("folder/A.TMP"), NodeType::FILE));
+        REQUIRE_FALSE(matcher.isExcluded(QLatin1String("keep.tmp"), NodeType::FILE));
+        REQUIRE_FALSE(matcher.isExcluded(QLatin1String("a.txt"), NodeType::FILE));
+    }
+
+    SECTION("Targets, local names and paths")
+    {
+        auto matcher(createMatcher({QLatin1String("-d:build"),
+                                    QLatin1String("-N:local"),
+                                    QLatin1String("-p:docs/*.md")}));
+
+        REQUIRE(matcher.isExcluded(QLatin1String("src/build"), NodeType::FOLDER));
+        REQUIRE_FALSE(matcher.isExcluded(QLatin1String("src/build"), NodeType::FILE));
+        // The contents of an excluded folder are excluded too
+        REQUIRE(matcher.isExcluded(QLatin1String("src/build/main.o"), NodeType::FILE));
+
+        REQUIRE(matcher.isExcluded(QLatin1String("local"), NodeType::FILE));
+        REQUIRE_FALSE(matcher.isExcluded(QLatin1String("src/local"), NodeType::FILE));
+
+        REQUIRE(matcher.isExcluded(QLatin1String("docs/readme.md"), NodeType::FILE));
+        REQUIRE_FALSE(matcher.isExcluded(QLatin1String("readme.md"), NodeType::FILE));
+    }
+
+    SECTION("Globs, regular expressions and case sensitivity")
+    {
+        auto matcher(createMatcher({QLatin1String("-G:Cache*"),
+                                    QLatin1String("-:a?c"),
+                                    QLatin1String("-r:v[0-9]+"),
+                                    QLatin1String("#-:*.log")}));
+
+        REQUIRE(matcher.isExcluded(QLatin1String("Cache1"), NodeType::FOLDER));
+        REQUIRE_FALSE(matcher.isExcluded(QLatin1String("cache1"), NodeType::FOLDER));
+        REQUIRE(matcher.isExcluded(QLatin1String("ABC"), NodeType::FILE));
+        REQUIRE_FALSE(matcher.isExcluded(QLatin1String("abbc"), NodeType::FILE));
+        REQUIRE(matcher.isExcluded(QLatin1String("V12"), NodeType::FILE));
+        REQUIRE_FALSE(matcher.isExcluded(QLatin1String("v12a"), NodeType::FILE));
+        // Commented rules are not applied
+        REQUIRE_FALSE(matcher.isExcluded(QLatin1String("debug.log"), NodeType::FILE));
+    }
+}
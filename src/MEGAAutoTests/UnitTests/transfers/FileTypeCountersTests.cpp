@@ -0,0 +1,150 @@
+#include "FileTypeCounters.h"
+#include <catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+namespace
+{
+const std::array<Utilities::FileType, FileTypeCounters::FILE_TYPE_COUNT> FILE_TYPES{
+    Utilities::FileType::TYPE_OTHER,
+    Utilities::FileType::TYPE_AUDIO,
+    Utilities::FileType::TYPE_VIDEO,
+    Utilities::FileType::TYPE_ARCHIVE,
+    Utilities::FileType::TYPE_DOCUMENT,
+    Utilities::FileType::TYPE_IMAGE};
+
+// The transfers in the list, kept apart to know which counters each operation has to change
+struct TransfersList
+{
+    std::vector<Utilities::FileType> pending;
+    std::vector<Utilities::FileType> finished;
+
+    uint count(const std::vector<Utilities::FileType>& transfers,
+               Utilities::FileType fileType) const
+    {
+        return static_cast<uint>(std::count(transfers.begin(), transfers.end(), fileType));
+    }
+};
+
+Utilities::FileType takeRandom(std::vector<Utilities::FileType>& transfers, std::mt19937& random)
+{
+    std::uniform_int_distribution<size_t> position(0, transfers.size() - 1);
+    auto& picked(transfers[position(random)]);
+    const auto fileType(picked);
+    picked = transfers.back();
+    transfers.pop_back();
+    return fileType;
+}
+
+void requireSameCounts(const FileTypeCounters& counters, const TransfersList& transfers)
+{
+    for (auto fileType: FILE_TYPES)
+    {
+        REQUIRE(counters.getFinishedTransfers(fileType) ==
+                transfers.count(transfers.finished, fileType));
+        REQUIRE(counters.getTransfers(fileType) ==
+                transfers.count(transfers.pending, fileType) +
+                    transfers.count(transfers.finished, fileType));
+    }
+}
+}
+
+TEST_CASE("FileTypeCounters")
+{
+    FileTypeCounters counters;
+
+    SECTION("Each file type has its own counters")
+    {
+        counters.addTransfer(Utilities::FileType::TYPE_IMAGE);
+        counters.addTransfer(Utilities::FileType::TYPE_IMAGE);
+        counters.addTransfer(Utilities::FileType::TYPE_OTHER);
+        counters.addFinishedTransfer(Utilities::FileType::TYPE_IMAGE);
+
+        REQUIRE(counters.getTransfers(Utilities::FileType::TYPE_IMAGE) == 2);
+        REQUIRE(counters.getFinishedTransfers(Utilities::FileType::TYPE_IMAGE) == 1);
+        REQUIRE(counters.getTransfers(Utilities::FileType::TYPE_OTHER) == 1);
+        REQUIRE(counters.getTransfers(Utilities::FileType::TYPE_VIDEO) == 0);
+
+        auto copy(counters);
+        REQUIRE(copy == counters);
+        copy.clear();
+        REQUIRE(copy != counters);
+        REQUIRE(copy.getTransfers(Utilities::FileType::TYPE_IMAGE) == 0);
+    }
+
+    SECTION("A counter does not wrap around when it is decreased at zero")
+    {
+        counters.removeTransfer(Utilities::FileType::TYPE_AUDIO);
+        counters.removeFinishedTransfer(Utilities::FileType::TYPE_AUDIO);
+
+        REQUIRE(counters.getTransfers(Utilities::FileType::TYPE_AUDIO) == 0);
+        REQUIRE(counters.getFinishedTransfers(Utilities::FileType::TYPE_AUDIO) == 0);
+    }
+
+    SECTION("The counts are exact after a million random insert, cancel, retry and clear")
+    {
+        constexpr int OPERATIONS = 1000000;
+        constexpr int CHECK_INTERVAL = 10000;
+        constexpr int CLEAR_ALL_INTERVAL = 250000;
+
+        std::mt19937 random(2024);
+        std::uniform_int_distribution<int> operation(0, 99);
+        std::uniform_int_distribution<size_t> fileTypeIndex(0, FILE_TYPES.size() - 1);
+        TransfersList transfers;
+
+        for (int index = 1; index <= OPERATIONS; ++index)
+        {
+            const auto nextOperation(operation(random));
+            if (nextOperation < 35 || transfers.pending.empty())
+            {
+                // A transfer is started
+                const auto fileType(FILE_TYPES[fileTypeIndex(random)]);
+                counters.addTransfer(fileType);
+                transfers.pending.push_back(fileType);
+            }
+            else if (nextOperation < 45)
+            {
+                // A transfer is cancelled, and it is removed from the list
+                counters.removeTransfer(takeRandom(transfers.pending, random));
+            }
+            else if (nextOperation < 75)
+            {
+                // A transfer is completed or fails
+                const auto fileType(takeRandom(transfers.pending, random));
+                counters.addFinishedTransfer(fileType);
+                transfers.finished.push_back(fileType);
+            }
+            else if (nextOperation < 85 && !transfers.finished.empty())
+            {
+                // A failed transfer is retried: it is cleared and started again
+                const auto fileType(takeRandom(transfers.finished, random));
+                counters.removeFinishedTransfer(fileType);
+                counters.addTransfer(fileType);
+                transfers.pending.push_back(fileType);
+            }
+            else if (nextOperation >= 85 && !transfers.finished.empty())
+            {
+                // A finished transfer is cleared from the list
+                counters.removeFinishedTransfer(takeRandom(transfers.finished, random));
+            }
+
+            if (index % CLEAR_ALL_INTERVAL == 0)
+            {
+                // The whole list is cleared, as on logout
+                counters.clear();
+                transfers.pending.clear();
+                transfers.finished.clear();
+            }
+
+            if (index % CHECK_INTERVAL == 0)
+            {
+                requireSameCounts(counters, transfers);
+            }
+        }
+
+        requireSameCounts(counters, transfers);
+    }
+}
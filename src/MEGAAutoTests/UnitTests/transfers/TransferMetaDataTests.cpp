@@ -0,0 +1,46 @@
+#include "TransferMetaData.h"
+#include <catch.hpp>
+
+namespace
+{
+QList<int> getTags(const QList<TransferMetaDataItemId>& ids)
+{
+    QList<int> tags;
+    for (const auto& id: ids)
+    {
+        tags.append(id.tag);
+    }
+    return tags;
+}
+}
+
+TEST_CASE("TransferMetaData items in the order they were started")
+{
+    DownloadTransferMetaData data(1, QLatin1String("/downloads"));
+
+    // The SDK reports the files of a folder in any order
+    for (int tag: {7, 3, 12, 5, 9})
+    {
+        data.addFile(tag);
+    }
+
+    REQUIRE(data.getFirstTransferIdByState(TransferData::TRANSFER_ACTIVE).tag == 3);
+    REQUIRE(getTags(data.getTransferIdsByState(TransferData::TRANSFER_ACTIVE)) ==
+            QList<int>{3, 5, 7, 9, 12});
+
+    SECTION("Files added later take their place by tag")
+    {
+        data.addFile(1);
+        data.addFile(10);
+
+        REQUIRE(data.getFirstTransferIdByState(TransferData::TRANSFER_ACTIVE).tag == 1);
+        REQUIRE(getTags(data.getTransferIdsByState(TransferData::TRANSFER_ACTIVE)) ==
+                QList<int>{1, 3, 5, 7, 9, 10, 12});
+    }
+
+    SECTION("States without files have no first item")
+    {
+        REQUIRE_FALSE(data.getFirstTransferIdByState(TransferData::TRANSFER_COMPLETED).isValid());
+        REQUIRE(data.getTransferIdsByState(TransferData::TRANSFER_COMPLETED).isEmpty());
+    }
+}
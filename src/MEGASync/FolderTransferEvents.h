@@ -11,6 +11,8 @@ struct FolderTransferUpdateEvent
     uint32_t filecount;
     QString transferName;
     std::string appData;
+    // Time left to finish the current stage, -1 while it can't be estimated
+    long long remainingSeconds = -1;
 };
 
 #endif // FOLDERTRANSFEREVENT_H
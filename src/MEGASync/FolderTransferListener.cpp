@@ -2,8 +2,23 @@
 
 #include "Utilities.h"
 
+#include <algorithm>
+
+namespace
+{
+long long currentTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+}
+
 FolderTransferListener::FolderTransferListener()
-    : QObject(nullptr)
+    : QObject(nullptr),
+      mGeneration(0),
+      mLastProcessedUpdateMs(0),
+      mLastProcessedStage(mega::MegaTransfer::STAGE_NONE)
 {
     qRegisterMetaType<FolderTransferUpdateEvent>("FolderTransferUpdateEvent");
 
@@ -18,23 +33,27 @@ void FolderTransferListener::onFolderTransferUpdate(mega::MegaApi *, mega::MegaT
 {
     if(!transfer->isSyncTransfer() && !transfer->isBackupTransfer())
     {
-        FolderTransferUpdateEvent event;
-        event.stage = stage;
-
-        event.foldercount = foldercount;
-        event.createdfoldercount = createdfoldercount;
-        event.filecount = filecount;
-        event.appData = std::string(transfer->getAppData());
-
         if(stage >= mega::MegaTransfer::STAGE_TRANSFERRING_FILES)
         {
+            FolderTransferUpdateEvent event;
+            event.stage = stage;
+
+            event.foldercount = foldercount;
+            event.createdfoldercount = createdfoldercount;
+            event.filecount = filecount;
+            event.appData = std::string(transfer->getAppData());
             event.transferName = Utilities::getNodePath(transfer);
             emit folderTransferUpdated(event);
         }
         else
         {
-            QMutexLocker lock(&mLock);
-            mEventsReceivedMap.insert(transfer->getTag(), event);
+            auto counters = getCounters(transfer);
+            counters->stage.store(stage, std::memory_order_relaxed);
+            counters->folderCount.store(foldercount, std::memory_order_relaxed);
+            counters->createdFolderCount.store(createdfoldercount, std::memory_order_relaxed);
+            counters->fileCount.store(filecount, std::memory_order_relaxed);
+            // Publishes the values above
+            counters->lastUpdateMs.store(currentTimeMs(), std::memory_order_release);
         }
     }
 }
@@ -43,35 +62,98 @@ void FolderTransferListener::onFolderTransferUpdate(mega::MegaApi *, mega::MegaT
 void FolderTransferListener::reset()
 {
     QMutexLocker lock(&mLock);
-    mEventsReceivedMap.clear();
-    mEventsToProcessMap.clear();
+    mCounters.clear();
+    mGeneration.fetch_add(1, std::memory_order_release);
+    mLastProcessedUpdateMs = 0;
+    mLastProcessedStage = mega::MegaTransfer::STAGE_NONE;
+    mStageRate.reset();
+}
+
+FolderTransferListener::Counters* FolderTransferListener::getCounters(mega::MegaTransfer* transfer)
+{
+    // Consecutive updates usually come from the same transfer, so the map is only looked up (and
+    // locked) when the transfer changes. The cache keeps the counters alive after a reset
+    struct CachedCounters
+    {
+        const FolderTransferListener* owner = nullptr;
+        unsigned long long generation = 0;
+        int tag = 0;
+        std::shared_ptr<Counters> counters;
+    };
+    static thread_local CachedCounters cached;
+
+    const int tag(transfer->getTag());
+    if (cached.owner == this && cached.tag == tag &&
+        cached.generation == mGeneration.load(std::memory_order_acquire))
+    {
+        return cached.counters.get();
+    }
+
+    QMutexLocker lock(&mLock);
+    auto& counters = mCounters[tag];
+    if (!counters)
+    {
+        counters = std::make_shared<Counters>();
+        counters->appData = std::string(transfer->getAppData());
+    }
+
+    cached.owner = this;
+    cached.generation = mGeneration.load(std::memory_order_relaxed);
+    cached.tag = tag;
+    cached.counters = counters;
+    return counters.get();
 }
 
 void FolderTransferListener::processEvent()
 {
-    uint32_t folderCount(0);
-    uint32_t fileCount(0);
-    uint32_t createFolderCount(0);
+    QList<std::shared_ptr<Counters>> counters;
+    {
+        QMutexLocker lock(&mLock);
+        counters = mCounters.values();
+    }
 
-    mLock.lock();
-    mEventsToProcessMap = mEventsReceivedMap;
-    mLock.unlock();
+    if(counters.isEmpty())
+    {
+        return;
+    }
 
-    if(!mEventsToProcessMap.isEmpty())
+    FolderTransferUpdateEvent eventToSend;
+    eventToSend.stage = counters.first()->stage.load(std::memory_order_relaxed);
+    eventToSend.appData = counters.first()->appData;
+    eventToSend.foldercount = 0;
+    eventToSend.createdfoldercount = 0;
+    eventToSend.filecount = 0;
+
+    long long lastUpdateMs(0);
+    for(const auto& transferCounters : qAsConst(counters))
     {
-        auto eventToSend = mEventsToProcessMap.first();
+        lastUpdateMs = std::max(lastUpdateMs, transferCounters->lastUpdateMs.load(std::memory_order_acquire));
+        eventToSend.foldercount += transferCounters->folderCount.load(std::memory_order_relaxed);
+        eventToSend.filecount += transferCounters->fileCount.load(std::memory_order_relaxed);
+        eventToSend.createdfoldercount += transferCounters->createdFolderCount.load(std::memory_order_relaxed);
+    }
 
-        foreach(auto event, mEventsToProcessMap)
+    if(eventToSend.stage != mLastProcessedStage)
+    {
+        mStageRate.reset();
+        mLastProcessedStage = eventToSend.stage;
+    }
+
+    // Only the folder creation has a known total to estimate the time left
+    if(eventToSend.stage == mega::MegaTransfer::STAGE_CREATE_TREE)
+    {
+        if(lastUpdateMs != mLastProcessedUpdateMs)
         {
-            folderCount += event.foldercount;
-            fileCount += event.filecount;
-            createFolderCount += event.createdfoldercount;
+            mStageRate.addProgressSample(std::chrono::milliseconds(lastUpdateMs),
+                                         eventToSend.createdfoldercount);
         }
 
-        eventToSend.foldercount = folderCount;
-        eventToSend.filecount = fileCount;
-        eventToSend.createdfoldercount = createFolderCount;
-
-        emit folderTransferUpdated(eventToSend);
+        if(auto estimate = mStageRate.getEstimateForTotal(eventToSend.foldercount))
+        {
+            eventToSend.remainingSeconds = estimate->remaining.count();
+        }
     }
+    mLastProcessedUpdateMs = lastUpdateMs;
+
+    emit folderTransferUpdated(eventToSend);
 }
@@ -3,12 +3,16 @@
 
 #include "FolderTransferEvents.h"
 #include "megaapi.h"
+#include "ThroughputEstimator.h"
 
 #include <QMap>
 #include <QMutex>
 #include <QObject>
 #include <QTimer>
 
+#include <atomic>
+#include <memory>
+
 class FolderTransferListener : public QObject, public mega::MegaTransferListener
 {
 Q_OBJECT
@@ -23,10 +27,29 @@ signals:
     void folderTransferUpdated(FolderTransferUpdateEvent);
 
 private:
+    // Last values reported for a folder transfer. They are written without locks on every update
+    // and read by the timer, which aggregates all the folder transfers being scanned
+    struct Counters
+    {
+        std::atomic<int> stage{mega::MegaTransfer::STAGE_NONE};
+        std::atomic<uint32_t> folderCount{0};
+        std::atomic<uint32_t> createdFolderCount{0};
+        std::atomic<uint32_t> fileCount{0};
+        std::atomic<long long> lastUpdateMs{0};
+        // Set before the counters are published
+        std::string appData;
+    };
+
+    Counters* getCounters(mega::MegaTransfer* transfer);
     void processEvent();
 
-    QMap<int, FolderTransferUpdateEvent> mEventsReceivedMap;
-    QMap<int, FolderTransferUpdateEvent> mEventsToProcessMap;
+    // By transfer tag. The lock only protects the map, as counters are added once per transfer
+    QMap<int, std::shared_ptr<Counters>> mCounters;
+    // Increased on reset, so the counters cached by each thread are not used anymore
+    std::atomic<unsigned long long> mGeneration;
+    long long mLastProcessedUpdateMs;
+    int mLastProcessedStage;
+    ThroughputEstimator mStageRate;
     QTimer mProcessTimer;
     QMutex mLock;
 };
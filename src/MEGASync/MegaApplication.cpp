@@ -13,11 +13,13 @@
 #include "DateTimeFormatter.h"
 #include "DeviceCentre.h"
 #include "DialogOpener.h"
+#include "DownloadQueueController.h"
 #include "EmailRequester.h"
 #include "EphemeralCredentials.h"
 #include "EventUpdater.h"
 #include "ExportProcessor.h"
 #include "FatalEventHandler.h"
+#include "FolderLinkApiPool.h"
 #include "FullName.h"
 #include "gui/TrayIconManager.h"
 #include "GuiUtilities.h"
@@ -48,6 +50,7 @@
 #include "ServiceUrls.h"
 #include "StalledIssuesDialog.h"
 #include "StalledIssuesModel.h"
+#include "StartupProfiler.h"
 #include "StatsEventHandler.h"
 #include "StreamingFromMegaDialog.h"
 #include "SyncController.h"
@@ -244,6 +247,8 @@ MegaApplication::MegaApplication(int& argc, char** argv):
     guestMenu = nullptr;
     megaApi = nullptr;
     megaApiFolders = nullptr;
+    mFolderLinkApiPool = nullptr;
+    mStagingDisablePkp = false;
     delegateListener = nullptr;
     httpServer = nullptr;
     exportOps = 0;
@@ -518,6 +523,8 @@ void MegaApplication::initialize()
                                     "handleMEGAurl");
     QDesktopServices::setUrlHandler(SCHEME_LOCAL_URL, this, "handleLocalPath");
 
+    auto startupProfiler(StartupProfiler::instance());
+    startupProfiler->startStage(QLatin1String("preferences"));
     preferences = Preferences::instance();
     connect(preferences.get(), SIGNAL(stateChanged()), this, SLOT(changeState()));
     connect(preferences.get(), SIGNAL(updated(int)), this, SLOT(showUpdatedMessage(int)),
@@ -525,6 +532,7 @@ void MegaApplication::initialize()
     preferences->initialize(dataPath);
 
     // Apply specific rcc files depending on selected theme
+    startupProfiler->startStage(QLatin1String("styleAndResources"));
     initStyleAndResources();
 
     if (preferences->error())
@@ -540,6 +548,7 @@ void MegaApplication::initialize()
     preferences->setLastStatsRequest(0);
     lastExit = preferences->getLastExit();
 
+    startupProfiler->startStage(QLatin1String("translationsAndTrayIcon"));
     installTranslator(&translator);
     QString language = preferences->language();
     changeLanguage(language);
@@ -553,6 +562,7 @@ void MegaApplication::initialize()
         toggleLogging();
     }
 
+    startupProfiler->startStage(QLatin1String("sdk"));
     const QString basePath = QDir::toNativeSeparators(dataPath + QString::fromUtf8("/"));
 
     createGfxProvider(basePath);
@@ -596,6 +606,18 @@ void MegaApplication::initialize()
                                     Preferences::USER_AGENT.toUtf8().constData(),
                                     !preferences->SSLcertificateException());
     megaApiFolders->disableGfxFeatures(true);
+    mFolderLinkApiPool = new FolderLinkApiPool(megaApiFolders,
+                                               [this]()
+                                               {
+                                                   return createFolderLinkApi();
+                                               },
+                                               [this](MegaApi* folderApi,
+                                                      std::function<void()> onLoggedOut)
+                                               {
+                                                   logoutFolderLinkApi(folderApi, onLoggedOut);
+                                               },
+                                               FolderLinkApiPool::DEFAULT_MAX_SESSIONS,
+                                               this);
 
     model = SyncInfo::instance();
     connect(model, &SyncInfo::syncStateChanged, this, &MegaApplication::onSyncModelUpdated);
@@ -635,6 +657,8 @@ void MegaApplication::initialize()
         const bool disablepkp = disablepkpValue == QLatin1String("1");
         megaApi->changeApiUrl(apiURL.toUtf8(), disablepkp);
         megaApiFolders->changeApiUrl(apiURL.toUtf8(), disablepkp);
+        mStagingApiUrl = apiURL;
+        mStagingDisablePkp = disablepkp;
 
         MessageDialogInfo msgInfo;
         msgInfo.descriptionText = QString::fromUtf8("API URL changed to ") + apiURL;
@@ -662,6 +686,7 @@ void MegaApplication::initialize()
         Preferences::SDK_ID.append(QString::fromUtf8(" - STAGING"));
     }
     mTrayIconManager->show();
+    startupProfiler->addMilestone(StartupProfiler::TRAY_SHOWN_MILESTONE);
 
     megaApi->log(MegaApi::LOG_LEVEL_INFO,
                  QString::fromUtf8("MEGA Desktop App is starting. Version string: %1   Version "
@@ -675,7 +700,10 @@ void MegaApplication::initialize()
                      .constData());
 
     megaApi->setLanguage(currentLanguageCode.toUtf8().constData());
-    megaApiFolders->setLanguage(currentLanguageCode.toUtf8().constData());
+    for (auto folderApi : mFolderLinkApiPool->getApis())
+    {
+        folderApi->setLanguage(currentLanguageCode.toUtf8().constData());
+    }
 
     // In case the user has logout and closed the app, we set the default values
     setMaxConnections(MegaTransfer::TYPE_UPLOAD, preferences->parallelUploadConnections());
@@ -685,6 +713,7 @@ void MegaApplication::initialize()
 
     megaApi->retrySSLerrors(true);
 
+    startupProfiler->startStage(QLatin1String("accountAndListeners"));
     mStatusController = new AccountStatusController(this);
     QmlManager::instance()->setRootContextProperty(mStatusController);
     AccountDetailsManager::instance()->init(megaApi);
@@ -791,6 +820,7 @@ void MegaApplication::initialize()
         connect(watcher, SIGNAL(fileChanged(QString)), this, SLOT(showInterface(QString)));
     }
 
+    startupProfiler->startStage(QLatin1String("modelsAndControllers"));
     mTransfersModel = new TransfersModel();
     connect(mTransfersModel.data(), &TransfersModel::transfersCountUpdated, this, &MegaApplication::onTransfersModelUpdate);
 
@@ -806,7 +836,7 @@ void MegaApplication::initialize()
     //! mSetManager needs to be manually deleted, as the SDK needs to be destroyed first
     mSetManager = new SetManager(megaApi, megaApiFolders);
 
-    mLinkProcessor = new LinkProcessor(megaApi, megaApiFolders);
+    mLinkProcessor = new LinkProcessor(megaApi, mFolderLinkApiPool);
     connect(mLinkProcessor,
             &LinkProcessor::linkCopyErrorDetected,
             this,
@@ -823,9 +853,27 @@ void MegaApplication::initialize()
             mSetManager,
             &SetManager::requestImportSet);
 
+    // The listener of the user messages has to be registered before the login
     createUserMessageController();
 
-    TokenParserWidgetManager::instance();
+    // Not needed to show the tray icon, so done once the startup critical path is done:
+    // - the token manager loads the color tokens of every theme and themes the standard components
+    //   style sheet with them. Widget style sheets are still compiled when a widget is first themed
+    // - the QML components used by the first dialogs are loaded
+    startupProfiler->deferToIdle(QLatin1String("colorTokens"),
+                                 []()
+                                 {
+                                     TokenParserWidgetManager::instance();
+                                 });
+    startupProfiler->deferToIdle(QLatin1String("qmlComponents"),
+                                 []()
+                                 {
+                                     QmlManager::instance()->preloadComponents(
+                                         {QUrl(QLatin1String("qrc:/guest/GuestDialog.qml")),
+                                          QUrl(QLatin1String(
+                                              "qrc:/messageDialogs/MessageDialog.qml"))});
+                                 });
+    startupProfiler->finishStage();
 
 #ifdef Q_OS_LINUX
     connect(Platform::getInstance(),
@@ -1101,6 +1149,8 @@ void MegaApplication::start()
         return;
     }
 
+    StartupProfiler::instance()->startStage(QLatin1String("start"));
+
     mIndexing = false;
     paused = false;
     nodescurrent = false;
@@ -1369,6 +1419,9 @@ void MegaApplication::start()
                      "Logout diagnostics: start() requests openOnboardingDialog().");
         QmlDialogManager::instance()->openOnboardingDialog();
     }
+
+    // Does nothing when start() is called again after a logout
+    StartupProfiler::instance()->finishCriticalPath();
 }
 
 void MegaApplication::requestUserData()
@@ -2451,6 +2504,7 @@ void MegaApplication::cleanAll()
         Platform::getInstance()->notifyItemChange(localFolder, MegaApi::STATE_NONE);
     }
 
+    model->flushSyncSettings();
     Preferences::instance()->clearTempTransfersPath();
     PowerOptions::appShutdown();
 
@@ -3431,7 +3485,10 @@ void MegaApplication::unlink(bool keepLogs)
                      "Clearing stale account settings immediately.");
         preferences->unlink();
     }
-    megaApiFolders->setAccountAuth(nullptr);
+    for (auto folderApi : mFolderLinkApiPool->getApis())
+    {
+        folderApi->setAccountAuth(nullptr);
+    }
     DialogOpener::closeAllDialogs();
 
     // Reset desktop integration
@@ -3780,11 +3837,17 @@ void MegaApplication::applyProxySettings()
     }
 
     megaApi->setProxySettings(proxySettings);
-    megaApiFolders->setProxySettings(proxySettings);
-    delete proxySettings;
+    for (auto folderApi : mFolderLinkApiPool->getApis())
+    {
+        folderApi->setProxySettings(proxySettings);
+    }
+    mProxySettings.reset(proxySettings);
     QNetworkProxy::setApplicationProxy(proxy);
     megaApi->retryPendingConnections(true, true);
-    megaApiFolders->retryPendingConnections(true, true);
+    for (auto folderApi : mFolderLinkApiPool->getApis())
+    {
+        folderApi->retryPendingConnections(true, true);
+    }
 }
 
 void MegaApplication::showUpdatedMessage(int lastVersion)
@@ -4633,7 +4696,7 @@ void MegaApplication::streamActionClicked()
     mTransferQuota->checkStreamingAlertDismissed([this](int result){
         if(result == QDialog::Rejected)
         {
-            auto streamSelector = new StreamingFromMegaDialog(megaApi, megaApiFolders);
+            auto streamSelector = new StreamingFromMegaDialog(megaApi, mFolderLinkApiPool);
             connect(mTransferQuota.get(), &TransferQuota::waitTimeIsOver, streamSelector, &StreamingFromMegaDialog::updateStreamingState);
             DialogOpener::showDialog<StreamingFromMegaDialog>(streamSelector);
         }
@@ -4928,6 +4991,50 @@ void MegaApplication::createUserMessageController()
     }
 }
 
+MegaApi* MegaApplication::createFolderLinkApi()
+{
+    // Extra folder link sessions have no local cache, so they never share database files with
+    // megaApiFolders, but they get the rest of its settings
+    MegaApi* folderApi(nullptr);
+    QTMegaApiManager::createMegaApi(folderApi,
+                                    Preferences::CLIENT_KEY,
+                                    nullptr,
+                                    nullptr,
+                                    Preferences::USER_AGENT.toUtf8().constData(),
+                                    !preferences->SSLcertificateException());
+    if (!folderApi)
+    {
+        return nullptr;
+    }
+
+    folderApi->disableGfxFeatures(true);
+    folderApi->setMaxPayloadLogSize(10240);
+    if (!mStagingApiUrl.isEmpty())
+    {
+        folderApi->changeApiUrl(mStagingApiUrl.toUtf8(), mStagingDisablePkp);
+    }
+    folderApi->setLanguage(currentLanguageCode.toUtf8().constData());
+    if (mProxySettings)
+    {
+        folderApi->setProxySettings(mProxySettings.get());
+    }
+
+    return folderApi;
+}
+
+void MegaApplication::logoutFolderLinkApi(MegaApi* folderApi, std::function<void()> onLoggedOut)
+{
+    // The pool outlives the users of its sessions, so it owns the listener. The session is given
+    // back whatever the result, as the next login to a folder replaces the previous one anyway
+    auto listener = RequestListenerManager::instance().registerAndGetCustomFinishListener(
+        mFolderLinkApiPool,
+        [onLoggedOut](MegaRequest*, MegaError*)
+        {
+            onLoggedOut();
+        });
+    folderApi->logout(false, listener.get());
+}
+
 void MegaApplication::createGfxProvider(const QString& basePath)
 {
     MegaGfxProvider* provider = nullptr;
@@ -6941,6 +7048,7 @@ void MegaApplication::onTransferFinish(MegaApi* , MegaTransfer *transfer, MegaEr
                                              transfer->getTotalBytes(),
                                              transfer->getSpeed(),
                                              QString::fromUtf8(transfer->getPath()));
+        DownloadQueueController::onTransferFinish(transfer);
     }
 
     if (e->getErrorCode() == MegaError::API_EBUSINESSPASTDUE
@@ -7037,6 +7145,7 @@ void MegaApplication::onTransferUpdate(MegaApi*, MegaTransfer* transfer)
                                              transfer->getTotalBytes(),
                                              transfer->getSpeed(),
                                              QString::fromUtf8(transfer->getPath()));
+        DownloadQueueController::onTransferUpdate(transfer);
     }
 }
 
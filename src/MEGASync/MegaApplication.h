@@ -47,8 +47,10 @@
 #include <QQueue>
 #include <QSystemTrayIcon>
 
+#include <functional>
 #include <memory>
 
+class FolderLinkApiPool;
 class IntervalExecutioner;
 class TransfersModel;
 class StalledIssuesModel;
@@ -126,6 +128,7 @@ public:
 
     mega::MegaApi *getMegaApi() { return megaApi; }
     mega::MegaApi *getMegaApiFolders() { return megaApiFolders; }
+    FolderLinkApiPool* getFolderLinkApiPool() const { return mFolderLinkApiPool; }
     std::unique_ptr<mega::MegaApiLock> megaApiLock;
 
     QString getMEGAString(){return QLatin1String("MEGA");}
@@ -421,6 +424,11 @@ protected:
     SyncInfo *model;
     mega::MegaApi *megaApi;
     mega::MegaApi* megaApiFolders;
+    FolderLinkApiPool* mFolderLinkApiPool;
+    // Settings for the folder link sessions created after startup
+    std::unique_ptr<mega::MegaProxy> mProxySettings;
+    QString mStagingApiUrl;
+    bool mStagingDisablePkp;
 
     HTTPServer *httpServer;
     mega::MegaHandle fileUploadTarget;
@@ -643,6 +651,8 @@ private:
     void closeUpsellStorageDialog();
 
     void createGfxProvider(const QString& basePath);
+    mega::MegaApi* createFolderLinkApi();
+    void logoutFolderLinkApi(mega::MegaApi* folderApi, std::function<void()> onLoggedOut);
     void startCrashReportingDialog();
 
     void removeSyncsAndBackupsMenus();
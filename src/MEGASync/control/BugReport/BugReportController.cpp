@@ -13,11 +13,22 @@ BugReportController::BugReportController(MegaSyncLogger& logger):
 {
     mMegaApi = ((MegaApplication*)qApp)->getMegaApi();
     mDelegateTransferListener = std::make_unique<mega::QTMegaTransferListener>(mMegaApi, this);
+    mLogBundleBuilder = std::make_unique<LogBundleBuilder>(mMegaApi);
 
     connect(&mLogger,
             &MegaSyncLogger::logReadyForReporting,
             this,
             &BugReportController::onReadyForReporting);
+
+    connect(mLogBundleBuilder.get(),
+            &LogBundleBuilder::progressUpdated,
+            this,
+            &BugReportController::reportLogPackagingUpdated);
+
+    connect(mLogBundleBuilder.get(),
+            &LogBundleBuilder::finished,
+            this,
+            &BugReportController::onLogBundleFinished);
 }
 
 BugReportController::~BugReportController()
@@ -27,6 +38,9 @@ BugReportController::~BugReportController()
         // Just in case the dialog is closed from an exit action
         cancel();
     }
+
+    // A cancelled report can only be resumed while its dialog is open
+    mLogBundleBuilder->discardStaging();
 }
 
 void BugReportController::submitReport()
@@ -99,6 +113,10 @@ void BugReportController::onTransferFinish(mega::MegaApi*,
         MegaSyncApp->getTransfersModel()->setGlobalPause(true);
     }
 
+    // The staged bundle is kept until the upload is over, so a resume does not build it again.
+    // After a failure or a cancel, a new report builds it from the current logs
+    mLogBundleBuilder->discardStaging();
+
     if (transfer->getState() == mega::MegaTransfer::STATE_CANCELLED)
     {
         mData.mStatus = BugReportData::STATUS::LOG_UPLOAD_CANCELLED;
@@ -178,7 +196,11 @@ void BugReportController::prepareForCancellation()
 
 void BugReportController::cancel()
 {
-    if (mData.mStatus == BugReportData::STATUS::UPLOADING_LOG && mData.mCurrentTransfer)
+    if (mData.mStatus == BugReportData::STATUS::JOINING_LOG)
+    {
+        mLogBundleBuilder->cancel();
+    }
+    else if (mData.mStatus == BugReportData::STATUS::UPLOADING_LOG && mData.mCurrentTransfer)
     {
         mMegaApi->cancelTransferByTag(mData.mCurrentTransfer);
 
@@ -212,6 +234,16 @@ void BugReportController::resume()
         {
             onReadyForReporting();
         }
+        // The log bundle is still being built, it will continue when finished
+        else if (mData.getStatus() == BugReportData::STATUS::JOINING_LOG)
+        {
+            return;
+        }
+        // The log bundle was built but the user cancelled it before uploading it
+        else if (mData.getStatus() == BugReportData::STATUS::LOG_JOINED)
+        {
+            startLogUpload();
+        }
         else
         {
             mData.mStatus = BugReportData::STATUS::REPORT_SUBMIT_FAILED;
@@ -232,28 +264,9 @@ void BugReportController::onReadyForReporting()
         // If send log file is enabled
         if (mData.getAttachLog())
         {
-            mData.mReportPath = Utilities::joinLogZipFiles(mMegaApi);
-            if (mData.mReportPath.isNull())
-            {
-                mLogger.resumeAfterReporting();
-                onReportFailed();
-            }
-            else
-            {
-                QFileInfo joinLogsFile{mData.mReportPath};
-                mData.mReportFileName = joinLogsFile.fileName();
-
-                if (Preferences::instance()->getGlobalPaused())
-                {
-                    mData.mHadGlobalPause = true;
-                    MegaSyncApp->getTransfersModel()->setGlobalPause(false);
-                }
-
-                mMegaApi->startUploadForSupport(
-                    QDir::toNativeSeparators(mData.mReportPath).toUtf8().constData(),
-                    true,
-                    mDelegateTransferListener.get());
-            }
+            // The bundle is built in a worker thread, the report continues in onLogBundleFinished
+            mData.mStatus = BugReportData::STATUS::JOINING_LOG;
+            mLogBundleBuilder->buildAsync();
         }
         else
         {
@@ -263,6 +276,50 @@ void BugReportController::onReadyForReporting()
     }
 }
 
+void BugReportController::onLogBundleFinished(QString bundlePath)
+{
+    if (bundlePath.isNull())
+    {
+        mLogger.resumeAfterReporting();
+
+        // Cancelled by the user, a later resume continues from the members already staged
+        if (mData.mCancelled)
+        {
+            mData.mStatus = BugReportData::STATUS::LOG_READY;
+        }
+        else
+        {
+            mData.mStatus = BugReportData::STATUS::LOG_FAILED;
+            onReportFailed();
+        }
+
+        return;
+    }
+
+    mData.mReportPath = bundlePath;
+    mData.mReportFileName = QFileInfo(bundlePath).fileName();
+    mData.mStatus = BugReportData::STATUS::LOG_JOINED;
+
+    // The user is deciding whether to cancel the report, wait for resume
+    if (!mData.mCancelled)
+    {
+        startLogUpload();
+    }
+}
+
+void BugReportController::startLogUpload()
+{
+    if (Preferences::instance()->getGlobalPaused())
+    {
+        mData.mHadGlobalPause = true;
+        MegaSyncApp->getTransfersModel()->setGlobalPause(false);
+    }
+
+    mMegaApi->startUploadForSupport(QDir::toNativeSeparators(mData.mReportPath).toUtf8().constData(),
+                                    true,
+                                    mDelegateTransferListener.get());
+}
+
 void BugReportController::onReportFailed()
 {
     emit reportFailed();
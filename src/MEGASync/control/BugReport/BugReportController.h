@@ -2,6 +2,7 @@
 #define BUGREPORTSENDER_H
 
 #include "BugReportData.h"
+#include "LogBundleBuilder.h"
 #include "MegaSyncLogger.h"
 #include "QTMegaTransferListener.h"
 
@@ -36,6 +37,7 @@ public:
 signals:
     void reportStarted();
     void reportUpdated(int progress);
+    void reportLogPackagingUpdated(int progress);
     void reportUploadFinished();
     void reportFinished();
     void reportFailed();
@@ -49,15 +51,18 @@ private slots:
                                   mega::MegaError* e);
 
     void onReadyForReporting();
+    void onLogBundleFinished(QString bundlePath);
 
 private:
     void onReportFailed();
+    void startLogUpload();
     void createSupportTicket();
 
     BugReportData mData;
 
     mega::MegaApi* mMegaApi;
     std::unique_ptr<mega::QTMegaTransferListener> mDelegateTransferListener;
+    std::unique_ptr<LogBundleBuilder> mLogBundleBuilder;
 
     MegaSyncLogger& mLogger;
 };
@@ -15,6 +15,8 @@ public:
         PREPARING_LOG,
         LOG_FAILED,
         LOG_READY,
+        JOINING_LOG,
+        LOG_JOINED,
         UPLOADING_LOG,
         LOG_UPLOAD_CANCELLED,
         LOG_UPLOAD_FAILED,
@@ -0,0 +1,435 @@
+#include "LogBundleBuilder.h"
+
+#include "MegaApplication.h"
+#include "MegaSyncLogger.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QtConcurrent/QtConcurrent>
+
+#include <algorithm>
+#include <memory>
+
+namespace
+{
+constexpr qint64 COPY_BUFFER_SIZE = 1024 * 1024;
+const QString LAST_LOG_FILE_NAME = QLatin1String("MEGAsync.0.log");
+const QString STAGING_FOLDER_NAME = QLatin1String("bugreport.staging");
+const QString MANIFEST_FILE_NAME = QLatin1String("manifest.json");
+
+const QLatin1String BUNDLE_KEY("bundle");
+const QLatin1String MEMBERS_KEY("members");
+const QLatin1String SIZE_KEY("size");
+const QLatin1String LAST_MODIFIED_KEY("lastModified");
+}
+
+bool LogBundleBuilder::StagedMember::matches(const QFileInfo& logFile) const
+{
+    return size == logFile.size() && lastModifiedMs == logFile.lastModified().toMSecsSinceEpoch();
+}
+
+LogBundleBuilder::LogBundleBuilder(mega::MegaApi* megaApi, QObject* parent):
+    QObject(parent),
+    mMegaApi(megaApi),
+    mCancelled(false),
+    mTotalBytes(0),
+    mCopiedBytes(0),
+    mLastPermil(-1)
+{
+    connect(&mWatcher,
+            &QFutureWatcher<QString>::finished,
+            this,
+            [this]()
+            {
+                emit finished(mFuture.result());
+            });
+}
+
+LogBundleBuilder::~LogBundleBuilder()
+{
+    cancel();
+    mFuture.waitForFinished();
+}
+
+QString LogBundleBuilder::build(const QDateTime* timestampSince,
+                                const QString& appendHashReference)
+{
+    mCopiedBytes = 0;
+    mLastPermil = -1;
+
+    QDir logDir(getLogsFolder());
+    if (!logDir.exists())
+    {
+        return QString();
+    }
+
+    QString bundlePath(getBundlePath(logDir, appendHashReference));
+    QFile bundle(bundlePath);
+    if (!bundle.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        logError(QString::fromUtf8("Error opening file for joining log zip files: %1 (%2)")
+                     .arg(bundlePath, bundle.errorString()));
+        return QString();
+    }
+
+    const auto rotationLock(lockLogRotation());
+    auto logFiles(getSortedLogFiles(logDir, timestampSince));
+
+    mTotalBytes = 0;
+    for (const auto& logFile: logFiles)
+    {
+        mTotalBytes += logFile.size();
+    }
+
+    for (const auto& logFile: logFiles)
+    {
+        if (!appendMember(logFile, bundle))
+        {
+            bundle.close();
+            bundle.remove();
+            return QString();
+        }
+    }
+
+    bundle.close();
+    updateProgress(0);
+
+    return QFileInfo(bundlePath).absoluteFilePath();
+}
+
+void LogBundleBuilder::buildAsync()
+{
+    if (isRunning())
+    {
+        return;
+    }
+
+    mCancelled = false;
+    mFuture = QtConcurrent::run(
+        [this]()
+        {
+            return buildStaged();
+        });
+    mWatcher.setFuture(mFuture);
+}
+
+void LogBundleBuilder::cancel()
+{
+    mCancelled = true;
+}
+
+bool LogBundleBuilder::isRunning() const
+{
+    return mFuture.isRunning();
+}
+
+void LogBundleBuilder::discardStaging()
+{
+    // The build writes into the staging folder
+    cancel();
+    mFuture.waitForFinished();
+    getStagingFolder().removeRecursively();
+}
+
+void LogBundleBuilder::setLogsFolder(const QString& path)
+{
+    mLogsFolder = path;
+}
+
+QString LogBundleBuilder::buildStaged()
+{
+    mCopiedBytes = 0;
+    mLastPermil = -1;
+
+    QDir logDir(getLogsFolder());
+    QDir stagingDir(getStagingFolder());
+    if (!logDir.exists() || !stagingDir.mkpath(QLatin1String(".")))
+    {
+        return QString();
+    }
+
+    const auto rotationLock(lockLogRotation());
+    auto logFiles(getSortedLogFiles(logDir, nullptr));
+
+    mTotalBytes = 0;
+    for (const auto& logFile: logFiles)
+    {
+        mTotalBytes += logFile.size();
+    }
+
+    // Keep the members of a previous build while they match the current log files. The manifest
+    // is only updated after a member is complete, so the bundle may have a partial one at the end
+    QString bundleName;
+    QList<StagedMember> members;
+    qint64 stagedBytes(0);
+    if (loadManifest(bundleName, members))
+    {
+        int matchingMembers(0);
+        while (matchingMembers < members.size() && matchingMembers < logFiles.size() &&
+               members.at(matchingMembers).matches(logFiles.at(matchingMembers)))
+        {
+            stagedBytes += members.at(matchingMembers).size;
+            ++matchingMembers;
+        }
+        members = members.mid(0, matchingMembers);
+
+        if (QFileInfo(stagingDir.filePath(bundleName)).size() < stagedBytes)
+        {
+            members.clear();
+            stagedBytes = 0;
+        }
+    }
+
+    if (members.isEmpty())
+    {
+        stagingDir.removeRecursively();
+        stagingDir.mkpath(QLatin1String("."));
+        bundleName = QFileInfo(getBundlePath(stagingDir, QString())).fileName();
+    }
+    const auto reusedMembers(members.size());
+
+    const QString bundlePath(stagingDir.absoluteFilePath(bundleName));
+    QFile bundle(bundlePath);
+    if (!bundle.open(QIODevice::ReadWrite) || !bundle.resize(stagedBytes) ||
+        !bundle.seek(stagedBytes))
+    {
+        logError(QString::fromUtf8("Error opening file for joining log zip files: %1 (%2)")
+                     .arg(bundlePath, bundle.errorString()));
+        return QString();
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    updateProgress(stagedBytes);
+
+    for (int index = members.size(); index < logFiles.size(); ++index)
+    {
+        const auto& logFile(logFiles.at(index));
+        if (!appendMember(logFile, bundle) || !bundle.flush())
+        {
+            // The complete members are kept for the next build
+            bundle.close();
+            return QString();
+        }
+
+        StagedMember member;
+        member.size = logFile.size();
+        member.lastModifiedMs = logFile.lastModified().toMSecsSinceEpoch();
+        members.append(member);
+        saveManifest(bundleName, members);
+    }
+
+    bundle.close();
+    updateProgress(0);
+    logThroughput(mCopiedBytes - stagedBytes, timer.elapsed(), reusedMembers);
+
+    return QFileInfo(bundlePath).absoluteFilePath();
+}
+
+QDir LogBundleBuilder::getLogsFolder() const
+{
+    if (!mLogsFolder.isEmpty())
+    {
+        return QDir(mLogsFolder);
+    }
+
+    return QDir(MegaApplication::applicationDataPath().append(QString::fromUtf8("/") +
+                                                              LOGS_FOLDER_LEAFNAME_QSTRING));
+}
+
+QDir LogBundleBuilder::getStagingFolder() const
+{
+    return QDir(getLogsFolder().filePath(STAGING_FOLDER_NAME));
+}
+
+QString LogBundleBuilder::getBundlePath(const QDir& logDir,
+                                        const QString& appendHashReference) const
+{
+    std::unique_ptr<mega::MegaUser> myUser(mMegaApi ? mMegaApi->getMyUser() : nullptr);
+
+    QString fileName{
+        QString::fromUtf8("%1%2%3.gz")
+            .arg(QDateTime::currentDateTimeUtc().toString(QString::fromLatin1("yyMMdd_hhmmss")),
+                 myUser ? QString::fromUtf8("_") + QString::fromUtf8(myUser->getEmail()) :
+                          QString(),
+                 !appendHashReference.isEmpty() ? QString::fromUtf8("_") + appendHashReference :
+                                                  QString())};
+
+    return logDir.absoluteFilePath(fileName);
+}
+
+QFileInfoList LogBundleBuilder::getSortedLogFiles(const QDir& logDir,
+                                                  const QDateTime* timestampSince) const
+{
+    const auto entries(
+        logDir.entryInfoList(QStringList() << QString::fromUtf8("MEGAsync.[0-9]*.log"),
+                             QDir::Files));
+
+    // Parse the rotation number once per file instead of once per comparison
+    QVector<QPair<int, QFileInfo>> numberedFiles;
+    numberedFiles.reserve(entries.size());
+    for (const auto& entry: entries)
+    {
+        // Discard by metadata before reading anything, but keep at least the last log
+        if (timestampSince && entry.lastModified() < *timestampSince &&
+            entry.fileName() != LAST_LOG_FILE_NAME)
+        {
+            continue;
+        }
+
+        numberedFiles.append(qMakePair(entry.fileName().section(QLatin1Char('.'), 1, 1).toInt(),
+                                       entry));
+    }
+
+    // Oldest logs (higher rotation number) first
+    std::sort(numberedFiles.begin(),
+              numberedFiles.end(),
+              [](const QPair<int, QFileInfo>& v1, const QPair<int, QFileInfo>& v2)
+              {
+                  return v1.first > v2.first;
+              });
+
+    QFileInfoList logFiles;
+    logFiles.reserve(numberedFiles.size());
+    for (const auto& numberedFile: qAsConst(numberedFiles))
+    {
+        logFiles.append(numberedFile.second);
+    }
+
+    return logFiles;
+}
+
+std::unique_lock<std::mutex> LogBundleBuilder::lockLogRotation() const
+{
+    // Without the app logger (or with another logs folder) nothing rotates the files
+    if (!g_megaSyncLogger || !mLogsFolder.isEmpty())
+    {
+        return std::unique_lock<std::mutex>();
+    }
+
+    return g_megaSyncLogger->lockRotation();
+}
+
+bool LogBundleBuilder::appendMember(const QFileInfo& logFile, QFile& bundle)
+{
+    QFile member(logFile.absoluteFilePath());
+    if (!member.open(QIODevice::ReadOnly))
+    {
+        logError(QString::fromUtf8("Error opening log file for bug report: %1 (%2)")
+                     .arg(logFile.absoluteFilePath(), member.errorString()));
+        return false;
+    }
+
+    QByteArray buffer;
+    while (!member.atEnd())
+    {
+        if (mCancelled)
+        {
+            return false;
+        }
+
+        buffer = member.read(COPY_BUFFER_SIZE);
+        if (buffer.isEmpty() || bundle.write(buffer) != buffer.size())
+        {
+            logError(QString::fromUtf8("Error joining zip files for bug report: %1")
+                         .arg(bundle.errorString()));
+            return false;
+        }
+
+        updateProgress(buffer.size());
+    }
+
+    return true;
+}
+
+void LogBundleBuilder::updateProgress(qint64 bytes)
+{
+    mCopiedBytes += bytes;
+
+    auto permil = mTotalBytes > 0 ? static_cast<int>((MAXIMUM_PERMIL * mCopiedBytes) / mTotalBytes) :
+                                    MAXIMUM_PERMIL;
+    if (permil > mLastPermil)
+    {
+        mLastPermil = permil;
+        emit progressUpdated(permil);
+    }
+}
+
+void LogBundleBuilder::logThroughput(qint64 copiedBytes, qint64 elapsedMs, int reusedMembers) const
+{
+    const auto bytesPerSecond(elapsedMs > 0 ? (copiedBytes * 1000) / elapsedMs : copiedBytes);
+    mega::MegaApi::log(mega::MegaApi::LOG_LEVEL_INFO,
+                       QString::fromUtf8("Log bundle built: %1 bytes in %2 ms (%3 bytes/s), %4 "
+                                         "staged members reused")
+                           .arg(copiedBytes)
+                           .arg(elapsedMs)
+                           .arg(bytesPerSecond)
+                           .arg(reusedMembers)
+                           .toUtf8()
+                           .constData());
+}
+
+void LogBundleBuilder::logError(const QString& message) const
+{
+    mega::MegaApi::log(mega::MegaApi::LOG_LEVEL_ERROR, message.toUtf8().constData());
+}
+
+bool LogBundleBuilder::loadManifest(QString& bundleName, QList<StagedMember>& members) const
+{
+    QFile manifestFile(getStagingFolder().filePath(MANIFEST_FILE_NAME));
+    if (!manifestFile.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    const auto manifest(QJsonDocument::fromJson(manifestFile.readAll()).object());
+    bundleName = manifest.value(BUNDLE_KEY).toString();
+    if (bundleName.isEmpty())
+    {
+        return false;
+    }
+
+    members.clear();
+    const auto memberValues(manifest.value(MEMBERS_KEY).toArray());
+    for (const auto& memberValue: memberValues)
+    {
+        const auto memberObject(memberValue.toObject());
+
+        StagedMember member;
+        member.size = static_cast<qint64>(memberObject.value(SIZE_KEY).toDouble());
+        member.lastModifiedMs =
+            static_cast<qint64>(memberObject.value(LAST_MODIFIED_KEY).toDouble());
+        members.append(member);
+    }
+
+    return true;
+}
+
+void LogBundleBuilder::saveManifest(const QString& bundleName,
+                                    const QList<StagedMember>& members) const
+{
+    QJsonArray memberValues;
+    for (const auto& member: members)
+    {
+        QJsonObject memberObject;
+        memberObject.insert(SIZE_KEY, static_cast<double>(member.size));
+        memberObject.insert(LAST_MODIFIED_KEY, static_cast<double>(member.lastModifiedMs));
+        memberValues.append(memberObject);
+    }
+
+    QJsonObject manifest;
+    manifest.insert(BUNDLE_KEY, bundleName);
+    manifest.insert(MEMBERS_KEY, memberValues);
+
+    QSaveFile manifestFile(getStagingFolder().filePath(MANIFEST_FILE_NAME));
+    if (manifestFile.open(QIODevice::WriteOnly))
+    {
+        manifestFile.write(QJsonDocument(manifest).toJson(QJsonDocument::Compact));
+        manifestFile.commit();
+    }
+}
@@ -0,0 +1,92 @@
+#ifndef LOGBUNDLEBUILDER_H
+#define LOGBUNDLEBUILDER_H
+
+#include "megaapi.h"
+
+#include <QDateTime>
+#include <QFileInfoList>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QObject>
+
+#include <atomic>
+#include <mutex>
+
+class QFile;
+
+// Builds the log bundle attached to bug and crash reports.
+// The rotated logs are already gzip files, so they are appended as they are: the result is a
+// multi-member gzip file which decompresses to the concatenation of all the logs, and there is
+// no need to inflate and recompress any of them.
+// The bug report bundle is built in a staging folder, along with a manifest of the log files
+// already appended to it. A build after a cancel or a crash keeps the complete members whose log
+// file has not changed and continues from there. The staging folder is discarded once the report
+// does not need the bundle anymore.
+// The rotation of the logs is held while they are listed and appended, as it renames, compresses
+// and removes them.
+// Without a MegaApi the bundle name has no account email.
+class LogBundleBuilder: public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int MAXIMUM_PERMIL = 1000;
+
+    explicit LogBundleBuilder(mega::MegaApi* megaApi, QObject* parent = nullptr);
+    ~LogBundleBuilder();
+
+    // Blocking version. Returns the bundle path, or a null string if it failed or was cancelled
+    QString build(const QDateTime* timestampSince = nullptr,
+                  const QString& appendHashReference = QString());
+
+    // Builds the staged bundle in a worker thread and emits finished when done
+    void buildAsync();
+    void cancel();
+    bool isRunning() const;
+    // Removes the staged bundle, once it is not needed anymore. A build in progress is stopped
+    void discardStaging();
+
+    // By default, the logs folder of the app
+    void setLogsFolder(const QString& path);
+
+signals:
+    void progressUpdated(int permil);
+    void finished(QString bundlePath);
+
+private:
+    // A log file appended to the staged bundle, identified by its size and modification time,
+    // as the rotation renames the files
+    struct StagedMember
+    {
+        qint64 size = 0;
+        qint64 lastModifiedMs = 0;
+
+        bool matches(const QFileInfo& logFile) const;
+    };
+
+    QString buildStaged();
+    QDir getLogsFolder() const;
+    QDir getStagingFolder() const;
+    QString getBundlePath(const QDir& logDir, const QString& appendHashReference) const;
+    QFileInfoList getSortedLogFiles(const QDir& logDir, const QDateTime* timestampSince) const;
+    std::unique_lock<std::mutex> lockLogRotation() const;
+    bool appendMember(const QFileInfo& logFile, QFile& bundle);
+    void updateProgress(qint64 bytes);
+    void logThroughput(qint64 copiedBytes, qint64 elapsedMs, int reusedMembers) const;
+    void logError(const QString& message) const;
+
+    bool loadManifest(QString& bundleName, QList<StagedMember>& members) const;
+    void saveManifest(const QString& bundleName, const QList<StagedMember>& members) const;
+
+    mega::MegaApi* mMegaApi;
+    QString mLogsFolder;
+    std::atomic<bool> mCancelled;
+    qint64 mTotalBytes;
+    qint64 mCopiedBytes;
+    int mLastPermil;
+
+    QFuture<QString> mFuture;
+    QFutureWatcher<QString> mWatcher;
+};
+
+#endif // LOGBUNDLEBUILDER_H
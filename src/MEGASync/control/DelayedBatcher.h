@@ -0,0 +1,100 @@
+#ifndef DELAYED_BATCHER_H
+#define DELAYED_BATCHER_H
+
+#include <QElapsedTimer>
+#include <QTimer>
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <vector>
+
+// Holds each item for at least the delay, and releases together all the items whose delay has
+// expired. Releases are at least one delay apart, so a continuous stream of items is released
+// once per delay, and no item waits more than two delays. Only used from the thread it lives in
+template<typename T>
+class DelayedBatcher
+{
+public:
+    using Callback = std::function<void(std::vector<T>)>;
+
+    DelayedBatcher(int delayMs, Callback callback):
+        mDelayMs(delayMs),
+        mCallback(std::move(callback)),
+        mLastReleaseMs(std::numeric_limits<qint64>::min() / 2)
+    {
+        mClock.start();
+        mTimer.setSingleShot(true);
+        mTimer.setTimerType(Qt::PreciseTimer);
+        QObject::connect(&mTimer,
+                         &QTimer::timeout,
+                         [this]()
+                         {
+                             releaseDueItems();
+                         });
+    }
+
+    void add(T item)
+    {
+        mPendingItems.push_back({std::move(item), mClock.elapsed() + mDelayMs});
+        if (!mTimer.isActive())
+        {
+            scheduleRelease();
+        }
+    }
+
+    bool isEmpty() const
+    {
+        return mPendingItems.empty();
+    }
+
+private:
+    struct PendingItem
+    {
+        T item;
+        qint64 dueMs;
+    };
+
+    void scheduleRelease()
+    {
+        if (mPendingItems.empty())
+        {
+            return;
+        }
+
+        const auto releaseMs(std::max(mPendingItems.front().dueMs, mLastReleaseMs + mDelayMs));
+        mTimer.start(static_cast<int>(std::max<qint64>(releaseMs - mClock.elapsed(), 0)));
+    }
+
+    void releaseDueItems()
+    {
+        const auto nowMs(mClock.elapsed());
+        std::vector<T> dueItems;
+        while (!mPendingItems.empty() && mPendingItems.front().dueMs <= nowMs)
+        {
+            dueItems.push_back(std::move(mPendingItems.front().item));
+            mPendingItems.pop_front();
+        }
+
+        if (!dueItems.empty())
+        {
+            mLastReleaseMs = nowMs;
+        }
+        scheduleRelease();
+
+        if (!dueItems.empty())
+        {
+            mCallback(std::move(dueItems));
+        }
+    }
+
+    int mDelayMs;
+    Callback mCallback;
+    std::deque<PendingItem> mPendingItems;
+    QTimer mTimer;
+    QElapsedTimer mClock;
+    qint64 mLastReleaseMs;
+};
+
+#endif // DELAYED_BATCHER_H
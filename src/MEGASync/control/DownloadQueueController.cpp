@@ -4,6 +4,7 @@
 #include "DialogOpener.h"
 #include "Platform.h"
 #include "RequestListenerManager.h"
+#include "TransferMetaData.h"
 
 #ifdef WIN32
 #include <fileapi.h>
@@ -11,8 +12,20 @@
 
 using namespace mega;
 
+namespace
+{
+constexpr int MAX_FOLDER_INFO_REQUESTS_IN_FLIGHT = 8;
+}
+
+QMap<unsigned long long, DownloadQueueController::SpaceReservation>
+    DownloadQueueController::mSpaceReservations;
+QMutex DownloadQueueController::mSpaceReservationsMutex;
+
 DownloadQueueController::DownloadQueueController(MegaApi *_megaApi, const QMap<mega::MegaHandle, QString>& pathMap)
-    : mMegaApi(_megaApi), mPathMap(pathMap)
+    : mMegaApi(_megaApi),
+      mPathMap(pathMap),
+      mFolderInfoRequestsInFlight(MAX_FOLDER_INFO_REQUESTS_IN_FLIGHT),
+      mTotalQueueDiskSizeIsLowerBound(false)
 {
 }
 
@@ -31,33 +44,81 @@ void DownloadQueueController::initialize(QQueue<WrappedNode> downloadQueue,
 void DownloadQueueController::startAvailableSpaceChecking()
 {
     mTotalQueueDiskSize = 0LL;
+    mTotalQueueDiskSizeIsLowerBound = false;
     mFolderCountPendingSizeComputation = 0;
-    auto accumulator = [this](long long partialSum, const WrappedNode& currentNode)
+    mFoldersPendingInfo.clear();
+    mFolderInfoRequestsInFlight.clear();
+
+    long long totalSize(0LL);
+    for (const auto& currentNode : qAsConst(mDownloadQueue))
     {
         MegaNode* node = currentNode.getMegaNode();
         if (node->getType() == MegaNode::TYPE_FILE)
         {
-            partialSum += node->getSize();
+            totalSize += node->getSize();
         }
         else if (currentNode.getTransferOrigin() != WrappedNode::FROM_WEBSERVER)
         { // Ignore folders if the transfer comes from the webclient, because it provides
           // both all folders and all files, and not only top files/folders.
-            mFolderCountPendingSizeComputation++;
-            auto listener = RequestListenerManager::instance().registerAndGetFinishListener(this, true);
-            mMegaApi->getFolderInfo(node, listener.get());
-        }
 
-        return partialSum;
-    };
-
-    auto queueStart = mDownloadQueue.cbegin();
-    auto queueEnd = mDownloadQueue.cend();
-    mTotalQueueDiskSize += std::accumulate(queueStart, queueEnd, 0LL, accumulator);
+            // Folders of the account tree keep their size in the node counters, only folders
+            // from links need a request
+            std::unique_ptr<MegaNode> accountNode(
+                node->isForeign() ? nullptr : mMegaApi->getNodeByHandle(node->getHandle()));
+            if (accountNode)
+            {
+                totalSize += mMegaApi->getSize(accountNode.get());
+            }
+            else
+            {
+                mFolderCountPendingSizeComputation++;
+                mFoldersPendingInfo.enqueue(std::shared_ptr<MegaNode>(node->copy()));
+            }
+        }
+    }
+    mTotalQueueDiskSize += totalSize;
 
     if (mFolderCountPendingSizeComputation == 0)
     {
         tryDownload();
+        return;
+    }
+
+    mCachedDriveData = getDriveSpaceDataFromQt();
+    if (isKnownSizeOverAvailableSpace())
+    {
+        stopSizeComputation();
+        tryDownload();
+        return;
     }
+
+    requestPendingFolderInfo();
+}
+
+void DownloadQueueController::requestPendingFolderInfo()
+{
+    while (!mFoldersPendingInfo.isEmpty() && mFolderInfoRequestsInFlight.canStart())
+    {
+        auto node = mFoldersPendingInfo.dequeue();
+        mFolderInfoRequestsInFlight.start(node->getHandle());
+        auto listener = RequestListenerManager::instance().registerAndGetFinishListener(this, true);
+        mMegaApi->getFolderInfo(node.get(), listener.get());
+    }
+}
+
+bool DownloadQueueController::isKnownSizeOverAvailableSpace() const
+{
+    // The size of the pending folders can only make it worse, so there is no need to wait for them
+    return !mCurrentTargetPath.isEmpty() && mCachedDriveData.mIsReady &&
+           mTotalQueueDiskSize >= mCachedDriveData.mAvailableSpace;
+}
+
+void DownloadQueueController::stopSizeComputation()
+{
+    mTotalQueueDiskSizeIsLowerBound = mFolderCountPendingSizeComputation > 0;
+    mFoldersPendingInfo.clear();
+    mFolderInfoRequestsInFlight.clear();
+    mFolderCountPendingSizeComputation = 0;
 }
 
 void DownloadQueueController::addTransferBatch(std::shared_ptr<TransferBatch> batch)
@@ -98,8 +159,10 @@ WrappedNode DownloadQueueController::dequeueDownloadQueue()
 
 void DownloadQueueController::onRequestFinish(MegaRequest *request, MegaError *e)
 {
-    if (request->getType() != mega::MegaRequest::TYPE_FOLDER_INFO)
+    if (request->getType() != mega::MegaRequest::TYPE_FOLDER_INFO ||
+        !mFolderInfoRequestsInFlight.finish(request->getNodeHandle()))
     {
+        // The check finished early, or this request belongs to a previous check
         return;
     }
 
@@ -109,10 +172,15 @@ void DownloadQueueController::onRequestFinish(MegaRequest *request, MegaError *e
         mTotalQueueDiskSize += folderInfo->getCurrentSize();
     }
 
-    if (--mFolderCountPendingSizeComputation <= 0)
+    if (--mFolderCountPendingSizeComputation <= 0 || isKnownSizeOverAvailableSpace())
     {
+        stopSizeComputation();
         tryDownload();
     }
+    else
+    {
+        requestPendingFolderInfo();
+    }
 }
 
 void DownloadQueueController::tryDownload()
@@ -124,6 +192,7 @@ void DownloadQueueController::tryDownload()
     }
     else
     {
+        reserveSpace();
         emit finishedAvailableSpaceCheck(downloadPossible);
     }
 }
@@ -137,11 +206,113 @@ bool DownloadQueueController::hasEnoughSpaceForDownloads()
         {
             mCachedDriveData = Platform::getInstance()->getDriveData(mCurrentTargetPath);
         }
+
+        if (mCachedDriveData.mIsReady)
+        {
+            // Other downloads to the same drive may not have written their data yet
+            mCachedDriveData.mAvailableSpace -=
+                getReservedSpace(QStorageInfo(mCurrentTargetPath).rootPath(), mCurrentAppDataId);
+        }
         return (!mCachedDriveData.mIsReady || mTotalQueueDiskSize < mCachedDriveData.mAvailableSpace);
     }
     return true;
 }
 
+void DownloadQueueController::reserveSpace()
+{
+    if (mCurrentTargetPath.isEmpty() || mCurrentAppDataId == TransferMetaData::INVALID_ID ||
+        !mCachedDriveData.mIsReady || mTotalQueueDiskSize <= 0)
+    {
+        return;
+    }
+
+    SpaceReservation reservation;
+    reservation.rootPath = QStorageInfo(mCurrentTargetPath).rootPath();
+    reservation.bytes = mTotalQueueDiskSize;
+
+    QMutexLocker lock(&mSpaceReservationsMutex);
+    mSpaceReservations.insert(mCurrentAppDataId, reservation);
+}
+
+long long DownloadQueueController::getReservedSpace(const QString& rootPath,
+                                                    unsigned long long excludedAppDataId)
+{
+    QMutexLocker lock(&mSpaceReservationsMutex);
+
+    long long reservedSpace(0LL);
+    for (auto it = mSpaceReservations.begin(); it != mSpaceReservations.end();)
+    {
+        // Only the space of the queue itself, as anything else written to the drive since the
+        // reservation was made is not part of it
+        const auto pendingSpace = it->bytes - it->writtenBytes;
+
+        if (pendingSpace <= 0 || !TransferMetaDataContainer::getAppDataById(it.key()))
+        {
+            it = mSpaceReservations.erase(it);
+            continue;
+        }
+
+        if (it.key() != excludedAppDataId && it->rootPath == rootPath)
+        {
+            reservedSpace += pendingSpace;
+        }
+        ++it;
+    }
+
+    return reservedSpace;
+}
+
+void DownloadQueueController::onTransferUpdate(MegaTransfer* transfer)
+{
+    updateWrittenBytes(transfer, false);
+}
+
+void DownloadQueueController::onTransferFinish(MegaTransfer* transfer)
+{
+    updateWrittenBytes(transfer, true);
+}
+
+void DownloadQueueController::updateWrittenBytes(MegaTransfer* transfer, bool finished)
+{
+    // A folder transfer reports the bytes of its files, which are counted on their own
+    if (transfer->isFolderTransfer())
+    {
+        return;
+    }
+
+    {
+        QMutexLocker lock(&mSpaceReservationsMutex);
+        if (mSpaceReservations.isEmpty())
+        {
+            return;
+        }
+    }
+
+    // Looked up before locking the reservations, as getReservedSpace locks them in reverse order
+    auto appData = TransferMetaDataContainer::getAppData(transfer);
+    if (!appData)
+    {
+        return;
+    }
+
+    QMutexLocker lock(&mSpaceReservationsMutex);
+    auto reservationIt = mSpaceReservations.find(appData->getAppId());
+    if (reservationIt == mSpaceReservations.end())
+    {
+        return;
+    }
+
+    const auto transferredBytes = transfer->getTransferredBytes();
+    auto& writtenBytes = reservationIt->writtenBytesByTransfer[transfer->getTag()];
+    reservationIt->writtenBytes += transferredBytes - writtenBytes;
+    writtenBytes = transferredBytes;
+
+    if (finished)
+    {
+        reservationIt->writtenBytesByTransfer.remove(transfer->getTag());
+    }
+}
+
 void DownloadQueueController::askUserForChoice()
 {
     QStorageInfo destinationDrive(mCurrentTargetPath);
@@ -149,17 +320,30 @@ void DownloadQueueController::askUserForChoice()
     const QString driveName = getDriveName(destinationDrive);
 
     LowDiskSpaceDialog* dialog = new LowDiskSpaceDialog(mTotalQueueDiskSize,
+                                                        mTotalQueueDiskSizeIsLowerBound,
                                                         mCachedDriveData.mAvailableSpace,
                                                         mCachedDriveData.mTotalSpace,
                                                         driveName);
 
-    DialogOpener::showDialog<LowDiskSpaceDialog>(dialog,
-                                                 [this, dialog]()
-                                                 {
-                                                     dialog->result() == QDialog::Accepted ?
-                                                         tryDownload() :
-                                                         emit finishedAvailableSpaceCheck(false);
-                                                 });
+    DialogOpener::showDialog<LowDiskSpaceDialog>(
+        dialog,
+        [this, dialog]()
+        {
+            if (dialog->result() != QDialog::Accepted)
+            {
+                emit finishedAvailableSpaceCheck(false);
+            }
+            // A size known only in part would reserve less than the queue needs, so it is
+            // computed again once there may be enough space for it
+            else if (mTotalQueueDiskSizeIsLowerBound)
+            {
+                startAvailableSpaceChecking();
+            }
+            else
+            {
+                tryDownload();
+            }
+        });
 }
 
 QString DownloadQueueController::getDriveName(const QStorageInfo& driveInfo) const
@@ -1,16 +1,22 @@
 #ifndef DOWNLOADQUEUECONTROLLER_H
 #define DOWNLOADQUEUECONTROLLER_H
 
+#include "FolderInfoRequests.h"
 #include "TransferBatch.h"
 #include "Utilities.h"
 #include "megaapi.h"
 #include "drivedata.h"
 
+#include <QHash>
 #include <QMap>
+#include <QMutex>
 #include <QObject>
+#include <QQueue>
 #include <QString>
 #include <QStorageInfo>
 
+#include <memory>
+
 class DownloadQueueController : public QObject
 {
     Q_OBJECT
@@ -38,13 +44,35 @@ public:
 
     void onRequestFinish(mega::MegaRequest *request, mega::MegaError *e);
 
+    // Counts the bytes written by a download against the space reserved for its queue
+    static void onTransferUpdate(mega::MegaTransfer* transfer);
+    static void onTransferFinish(mega::MegaTransfer* transfer);
+
 signals:
     void finishedAvailableSpaceCheck(bool isDownloadPossible);
 
 private:
 
+    // Space promised to download queues which passed the check, until it is really used
+    struct SpaceReservation
+    {
+        QString rootPath;
+        long long bytes;
+        // Bytes written by the transfers of the queue, which are already out of the available
+        // space. The transfers in progress are kept by tag, as they report their total
+        long long writtenBytes = 0LL;
+        QHash<int, long long> writtenBytesByTransfer;
+    };
+
+    void requestPendingFolderInfo();
+    bool isKnownSizeOverAvailableSpace() const;
+    void stopSizeComputation();
     void tryDownload();
     bool hasEnoughSpaceForDownloads();
+    void reserveSpace();
+    static long long getReservedSpace(const QString& rootPath,
+                                      unsigned long long excludedAppDataId);
+    static void updateWrittenBytes(mega::MegaTransfer* transfer, bool finished);
     void askUserForChoice();
     QString getDriveName(const QStorageInfo& driveInfo) const;
     QString getDefaultDriveName() const;
@@ -53,12 +81,20 @@ private:
     mega::MegaApi *mMegaApi;
     const QMap<mega::MegaHandle, QString>& mPathMap;
     std::atomic<long> mFolderCountPendingSizeComputation;
+    // Folders whose size is not in the local node tree, asked with a bounded number of requests
+    QQueue<std::shared_ptr<mega::MegaNode>> mFoldersPendingInfo;
+    FolderInfoRequests mFolderInfoRequestsInFlight;
     std::atomic<long long> mTotalQueueDiskSize;
+    // The check stopped before knowing the size of every folder, so the size is a lower bound
+    bool mTotalQueueDiskSizeIsLowerBound;
     unsigned long long mCurrentAppDataId;
     QString mCurrentTargetPath;
     BlockingBatch* mDownloadBatches;
     QQueue<WrappedNode> mDownloadQueue;
 
     DriveSpaceData mCachedDriveData;
+
+    static QMap<unsigned long long, SpaceReservation> mSpaceReservations;
+    static QMutex mSpaceReservationsMutex;
 };
 #endif // DOWNLOADQUEUECONTROLLER_H
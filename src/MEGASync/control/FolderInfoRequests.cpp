@@ -0,0 +1,44 @@
+#include "FolderInfoRequests.h"
+
+FolderInfoRequests::FolderInfoRequests(int maxInFlight):
+    mMaxInFlight(maxInFlight),
+    mInFlightCount(0)
+{}
+
+void FolderInfoRequests::clear()
+{
+    mInFlightByHandle.clear();
+    mInFlightCount = 0;
+}
+
+bool FolderInfoRequests::canStart() const
+{
+    return mInFlightCount < mMaxInFlight;
+}
+
+void FolderInfoRequests::start(mega::MegaHandle handle)
+{
+    ++mInFlightByHandle[handle];
+    ++mInFlightCount;
+}
+
+bool FolderInfoRequests::finish(mega::MegaHandle handle)
+{
+    auto it(mInFlightByHandle.find(handle));
+    if (it == mInFlightByHandle.end())
+    {
+        return false;
+    }
+
+    if (--it.value() == 0)
+    {
+        mInFlightByHandle.erase(it);
+    }
+    --mInFlightCount;
+    return true;
+}
+
+int FolderInfoRequests::getInFlightCount() const
+{
+    return mInFlightCount;
+}
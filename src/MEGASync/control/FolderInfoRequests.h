@@ -0,0 +1,30 @@
+#ifndef FOLDERINFOREQUESTS_H
+#define FOLDERINFOREQUESTS_H
+
+#include "megaapi.h"
+
+#include <QHash>
+
+// Folder info requests in flight, counted per folder. The same folder can be queued more than
+// once, and each of its requests must be matched by its own response.
+class FolderInfoRequests
+{
+public:
+    explicit FolderInfoRequests(int maxInFlight);
+
+    void clear();
+
+    bool canStart() const;
+    void start(mega::MegaHandle handle);
+    // False for responses of requests which were not started, or started before clear()
+    bool finish(mega::MegaHandle handle);
+
+    int getInFlightCount() const;
+
+private:
+    int mMaxInFlight;
+    int mInFlightCount;
+    QHash<mega::MegaHandle, int> mInFlightByHandle;
+};
+
+#endif // FOLDERINFOREQUESTS_H
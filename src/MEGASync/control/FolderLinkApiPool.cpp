@@ -0,0 +1,135 @@
+#include "FolderLinkApiPool.h"
+
+#include <algorithm>
+
+const int FolderLinkApiPool::DEFAULT_MAX_SESSIONS = 4;
+
+FolderLinkApiPool::FolderLinkApiPool(mega::MegaApi* primaryApi,
+                                     ApiFactory factory,
+                                     ApiLogout logout,
+                                     int maxSessions,
+                                     QObject* parent):
+    QObject(parent),
+    mFactory(std::move(factory)),
+    mLogout(std::move(logout)),
+    mMaxSessions(std::max(1, maxSessions))
+{
+    mApis.append(primaryApi);
+}
+
+mega::MegaApi* FolderLinkApiPool::acquire()
+{
+    for (auto api : qAsConst(mApis))
+    {
+        if (!mBusyApis.contains(api))
+        {
+            mBusyApis.insert(api);
+            return api;
+        }
+    }
+
+    if (mApis.size() >= mMaxSessions || !mFactory)
+    {
+        return nullptr;
+    }
+
+    auto api = mFactory();
+    if (!api)
+    {
+        return nullptr;
+    }
+
+    mApis.append(api);
+    mBusyApis.insert(api);
+    return api;
+}
+
+void FolderLinkApiPool::release(mega::MegaApi* api)
+{
+    if (mBusyApis.remove(api))
+    {
+        emit sessionReleased();
+    }
+}
+
+void FolderLinkApiPool::releaseAfterLogout(mega::MegaApi* api)
+{
+    if (!mBusyApis.contains(api))
+    {
+        return;
+    }
+
+    if (!mLogout)
+    {
+        release(api);
+        return;
+    }
+
+    // The session stays busy until the logout finishes
+    QPointer<FolderLinkApiPool> pool(this);
+    mLogout(api,
+            [pool, api]()
+            {
+                if (pool)
+                {
+                    pool->release(api);
+                }
+            });
+}
+
+const QList<mega::MegaApi*>& FolderLinkApiPool::getApis() const
+{
+    return mApis;
+}
+
+void FolderLinkApiPool::setMaxSessions(int maxSessions)
+{
+    // Sessions already created are kept, only new ones are limited
+    mMaxSessions = std::max(1, maxSessions);
+}
+
+int FolderLinkApiPool::getMaxSessions() const
+{
+    return mMaxSessions;
+}
+
+FolderLinkApiLeases::FolderLinkApiLeases(FolderLinkApiPool* pool):
+    mPool(pool)
+{
+}
+
+FolderLinkApiLeases::~FolderLinkApiLeases()
+{
+    if (!mPool)
+    {
+        return;
+    }
+
+    for (auto api : qAsConst(mApis))
+    {
+        mPool->releaseAfterLogout(api);
+    }
+}
+
+mega::MegaApi* FolderLinkApiLeases::acquire()
+{
+    auto api = mPool ? mPool->acquire() : nullptr;
+    if (api)
+    {
+        mApis.insert(api);
+    }
+    return api;
+}
+
+void FolderLinkApiLeases::release(mega::MegaApi* api)
+{
+    if (mApis.remove(api) && mPool)
+    {
+        mPool->release(api);
+    }
+}
+
+int FolderLinkApiLeases::getCount() const
+{
+    return static_cast<int>(mApis.size());
+}
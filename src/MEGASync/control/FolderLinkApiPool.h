@@ -0,0 +1,75 @@
+#ifndef FOLDERLINKAPIPOOL_H
+#define FOLDERLINKAPIPOOL_H
+
+#include "megaapi.h"
+
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+
+#include <functional>
+
+// Folder link sessions, so several folder links can be logged in and fetched at the same time.
+// The first session is the app folder links MegaApi, the rest are created when they are needed and
+// kept for the following links. Sessions are not owned by the pool.
+// To be used from the GUI thread only.
+class FolderLinkApiPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    using ApiFactory = std::function<mega::MegaApi*()>;
+    // Logs the session out of its folder and calls the callback when it is done
+    using ApiLogout = std::function<void(mega::MegaApi*, std::function<void()>)>;
+
+    static const int DEFAULT_MAX_SESSIONS;
+
+    FolderLinkApiPool(mega::MegaApi* primaryApi,
+                      ApiFactory factory,
+                      ApiLogout logout,
+                      int maxSessions = DEFAULT_MAX_SESSIONS,
+                      QObject* parent = nullptr);
+
+    // Returns a session which is not in use, or nullptr if all of them are busy
+    mega::MegaApi* acquire();
+    void release(mega::MegaApi* api);
+    // For sessions whose requests were abandoned: they are logged out before they are released,
+    // so the next user does not get the folder or the requests of the previous one
+    void releaseAfterLogout(mega::MegaApi* api);
+
+    // All the sessions created so far, to apply the app settings to them
+    const QList<mega::MegaApi*>& getApis() const;
+
+    void setMaxSessions(int maxSessions);
+    int getMaxSessions() const;
+
+signals:
+    void sessionReleased();
+
+private:
+    ApiFactory mFactory;
+    ApiLogout mLogout;
+    QList<mega::MegaApi*> mApis;
+    QSet<mega::MegaApi*> mBusyApis;
+    int mMaxSessions;
+};
+
+// Sessions of the pool in use by one owner. The sessions still in use when it is destroyed are
+// logged out and given back to the pool, as the owner will not get the end of their requests.
+class FolderLinkApiLeases
+{
+public:
+    explicit FolderLinkApiLeases(FolderLinkApiPool* pool);
+    ~FolderLinkApiLeases();
+
+    mega::MegaApi* acquire();
+    void release(mega::MegaApi* api);
+    int getCount() const;
+
+private:
+    QPointer<FolderLinkApiPool> mPool;
+    QSet<mega::MegaApi*> mApis;
+};
+
+#endif // FOLDERLINKAPIPOOL_H
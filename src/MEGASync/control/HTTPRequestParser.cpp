@@ -0,0 +1,197 @@
+#include "HTTPRequestParser.h"
+
+#include <algorithm>
+
+namespace
+{
+const QByteArray HEAD_TERMINATOR("\r\n\r\n");
+const QByteArray LINE_TERMINATOR("\r\n");
+}
+
+const int HTTPRequestParser::MAX_HEADER_SIZE = 16 * 1024;
+const qint64 HTTPRequestParser::MAX_BODY_SIZE = 64 * 1024 * 1024;
+
+HTTPRequestParser::HTTPRequestParser():
+    mScanFrom(0),
+    mHeadSize(-1),
+    mContentLength(0),
+    mKeepAlive(false)
+{}
+
+bool HTTPRequestParser::feed(const QByteArray& data)
+{
+    mBuffer.append(data);
+    return mBuffer.size() <= MAX_HEADER_SIZE + MAX_BODY_SIZE;
+}
+
+HTTPRequestParser::Status HTTPRequestParser::parse()
+{
+    if (mHeadSize < 0)
+    {
+        resetRequest();
+
+        // Empty lines before a request line must be ignored
+        while (mBuffer.startsWith(LINE_TERMINATOR))
+        {
+            mBuffer.remove(0, LINE_TERMINATOR.size());
+            mScanFrom = 0;
+        }
+
+        // Only the bytes received since the last call are scanned
+        int headEnd = mBuffer.indexOf(HEAD_TERMINATOR, mScanFrom);
+        if (headEnd < 0)
+        {
+            mScanFrom = std::max(0, mBuffer.size() - (HEAD_TERMINATOR.size() - 1));
+            return mBuffer.size() > MAX_HEADER_SIZE ? Status::PAYLOAD_TOO_LARGE :
+                                                      Status::INCOMPLETE;
+        }
+
+        int headSize = headEnd + HEAD_TERMINATOR.size();
+        if (headSize > MAX_HEADER_SIZE)
+        {
+            return Status::PAYLOAD_TOO_LARGE;
+        }
+
+        auto status = parseHead(headSize);
+        if (status != Status::COMPLETE)
+        {
+            return status;
+        }
+    }
+
+    if (mBuffer.size() - mHeadSize < mContentLength)
+    {
+        return Status::INCOMPLETE;
+    }
+
+    mBody = mBuffer.mid(mHeadSize, static_cast<int>(mContentLength));
+    mBuffer.remove(0, mHeadSize + static_cast<int>(mContentLength));
+    mScanFrom = 0;
+    mHeadSize = -1;
+
+    return Status::COMPLETE;
+}
+
+bool HTTPRequestParser::hasPendingData() const
+{
+    return !mBuffer.isEmpty();
+}
+
+const QByteArray& HTTPRequestParser::method() const
+{
+    return mMethod;
+}
+
+const QByteArray& HTTPRequestParser::target() const
+{
+    return mTarget;
+}
+
+const QStringList& HTTPRequestParser::headers() const
+{
+    return mHeaders;
+}
+
+const QByteArray& HTTPRequestParser::body() const
+{
+    return mBody;
+}
+
+bool HTTPRequestParser::keepAlive() const
+{
+    return mKeepAlive;
+}
+
+void HTTPRequestParser::resetRequest()
+{
+    mContentLength = 0;
+    mMethod.clear();
+    mTarget.clear();
+    mHeaders.clear();
+    mBody.clear();
+    mKeepAlive = false;
+}
+
+HTTPRequestParser::Status HTTPRequestParser::parseHead(int headSize)
+{
+    mHeadSize = headSize;
+
+    const auto lines(mBuffer.left(headSize - HEAD_TERMINATOR.size()).split('\n'));
+    mHeaders.reserve(lines.size());
+
+    bool hasContentLength(false);
+    for (int index = 0; index < lines.size(); ++index)
+    {
+        QByteArray line(lines.at(index));
+        if (line.endsWith('\r'))
+        {
+            line.chop(1);
+        }
+        mHeaders.append(QString::fromUtf8(line));
+
+        if (index == 0)
+        {
+            const auto requestLine(line.split(' '));
+            if (requestLine.size() != 3 || !requestLine.at(2).startsWith("HTTP/1."))
+            {
+                return Status::BAD_REQUEST;
+            }
+
+            mMethod = requestLine.at(0);
+            mTarget = requestLine.at(1);
+            // Persistent connections are the default since HTTP/1.1
+            mKeepAlive = (requestLine.at(2) == "HTTP/1.1");
+            continue;
+        }
+
+        int colon(line.indexOf(':'));
+        if (colon <= 0)
+        {
+            return Status::BAD_REQUEST;
+        }
+
+        const QByteArray name(line.left(colon).trimmed().toLower());
+        const QByteArray value(line.mid(colon + 1).trimmed());
+        if (name == "content-length")
+        {
+            bool ok(false);
+            qint64 contentLength(value.toLongLong(&ok));
+            if (!ok || contentLength < 0 || (hasContentLength && contentLength != mContentLength))
+            {
+                return Status::BAD_REQUEST;
+            }
+
+            mContentLength = contentLength;
+            hasContentLength = true;
+        }
+        else if (name == "connection")
+        {
+            const QByteArray connection(value.toLower());
+            if (connection.contains("close"))
+            {
+                mKeepAlive = false;
+            }
+            else if (connection.contains("keep-alive"))
+            {
+                mKeepAlive = true;
+            }
+        }
+        else if (name == "transfer-encoding")
+        {
+            // The webclient always sends the body length, chunked bodies are not supported
+            return Status::LENGTH_REQUIRED;
+        }
+    }
+
+    if (mMethod == "POST" && !hasContentLength)
+    {
+        return Status::LENGTH_REQUIRED;
+    }
+
+    if (mContentLength > MAX_BODY_SIZE)
+    {
+        return Status::PAYLOAD_TOO_LARGE;
+    }
+
+    return Status::COMPLETE;
+}
@@ -0,0 +1,60 @@
+#ifndef HTTPREQUESTPARSER_H
+#define HTTPREQUESTPARSER_H
+
+#include <QByteArray>
+#include <QStringList>
+
+// Incremental HTTP/1.x request parser for the webclient server.
+// Socket data is fed as raw bytes and each complete request is extracted without rescanning
+// what was already seen. Bytes following a complete request are kept, so pipelined requests
+// on a keep-alive connection are parsed one after another.
+class HTTPRequestParser
+{
+public:
+    enum class Status
+    {
+        INCOMPLETE = 0,
+        COMPLETE,
+        BAD_REQUEST,
+        LENGTH_REQUIRED,
+        PAYLOAD_TOO_LARGE
+    };
+
+    static const int MAX_HEADER_SIZE;
+    static const qint64 MAX_BODY_SIZE;
+
+    HTTPRequestParser();
+
+    // Returns false if the buffered data exceeds the size of the biggest acceptable request
+    bool feed(const QByteArray& data);
+    // Tries to extract the next request. Once it returns COMPLETE, the accessors below describe
+    // that request until parse() is called again
+    Status parse();
+    bool hasPendingData() const;
+
+    const QByteArray& method() const;
+    const QByteArray& target() const;
+    // Request line first, followed by the header lines
+    const QStringList& headers() const;
+    const QByteArray& body() const;
+    bool keepAlive() const;
+
+private:
+    void resetRequest();
+    Status parseHead(int headSize);
+
+    QByteArray mBuffer;
+    // Where the search for the end of the head is resumed
+    int mScanFrom;
+    // Size of the head including the blank line, -1 while it is not complete
+    int mHeadSize;
+    qint64 mContentLength;
+
+    QByteArray mMethod;
+    QByteArray mTarget;
+    QStringList mHeaders;
+    QByteArray mBody;
+    bool mKeepAlive;
+};
+
+#endif // HTTPREQUESTPARSER_H
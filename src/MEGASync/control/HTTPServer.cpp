@@ -7,12 +7,19 @@
 #include "Utilities.h"
 
 #include <QtConcurrent/QtConcurrent>
+#include <QUrlQuery>
 
 #include <algorithm>
 
 using namespace mega;
 
 const unsigned int HTTPServer::MAX_REQUEST_TIME_SECS = 1800;
+const int HTTPServer::KEEP_ALIVE_TIMEOUT_MS = 30000;
+const QString HTTPServer::TRANSFER_EVENTS_PATH = QString::fromUtf8("/transfers/events");
+const int HTTPServer::TRANSFER_EVENTS_DEFAULT_INTERVAL_MS = 500;
+const int HTTPServer::TRANSFER_EVENTS_MIN_INTERVAL_MS = 100;
+const int HTTPServer::TRANSFER_EVENTS_MAX_INTERVAL_MS = 10000;
+const qint64 HTTPServer::TRANSFER_EVENTS_MAX_PENDING_BYTES = 256 * 1024;
 
 bool ts_comparator(RequestData* i, RequestData *j)
 {
@@ -30,6 +37,7 @@ RequestData::RequestData()
 
 RequestTransferData::RequestTransferData()
 {
+    requestId = 0;
     state = MegaTransfer::STATE_NONE;
     progress = 0;
     size = 0;
@@ -39,9 +47,84 @@ RequestTransferData::RequestTransferData()
     tPath = QString();
 }
 
+int TransferEventsSubscriber::getInterval(const QUrl& url)
+{
+    bool ok = false;
+    int interval = QUrlQuery(url).queryItemValue(QString::fromUtf8("interval")).toInt(&ok);
+    if (!ok)
+    {
+        interval = HTTPServer::TRANSFER_EVENTS_DEFAULT_INTERVAL_MS;
+    }
+
+    return qBound(HTTPServer::TRANSFER_EVENTS_MIN_INTERVAL_MS,
+                  interval,
+                  HTTPServer::TRANSFER_EVENTS_MAX_INTERVAL_MS);
+}
+
+QByteArray TransferEventsSubscriber::getStreamHead(const QString& origin)
+{
+    return QString::fromUtf8("HTTP/1.1 200 Ok\r\n"
+                             "Access-Control-Allow-Origin: %1\r\n"
+                             "Content-Type: text/event-stream\r\n"
+                             "Cache-Control: no-cache\r\n"
+                             "Connection: keep-alive\r\n"
+                             "\r\n"
+                             "retry: 3000\r\n"
+                             "\r\n").arg(origin).toUtf8();
+}
+
+void TransferEventsSubscriber::queue(MegaHandle handle)
+{
+    mPendingHandles.insert(handle);
+}
+
+QByteArray TransferEventsSubscriber::takeEvent(
+    const QHash<MegaHandle, RequestTransferData*>& transfers, qint64 bytesToWrite)
+{
+    // Backpressure: while the browser has not read what was already sent, updates keep
+    // being coalesced in mPendingHandles instead of piling up in the socket buffer
+    if (mPendingHandles.isEmpty() || bytesToWrite > HTTPServer::TRANSFER_EVENTS_MAX_PENDING_BYTES)
+    {
+        return QByteArray();
+    }
+
+    QString data;
+    for (MegaHandle handle : qAsConst(mPendingHandles))
+    {
+        RequestTransferData* tData = transfers.value(handle);
+        if (!tData)
+        {
+            continue;
+        }
+
+        std::unique_ptr<char[]> base64Handle(MegaApi::handleToBase64(handle));
+        data.append(data.isEmpty() ? QString::fromUtf8("[") : QString::fromUtf8(","));
+        data.append(QString::fromUtf8("{\"h\":\"%1\",\"s\":%2,\"p\":%3,\"t\":%4,\"v\":%5}")
+                        .arg(QString::fromUtf8(base64Handle.get()))
+                        .arg(tData->state)
+                        .arg(tData->progress)
+                        .arg(tData->size)
+                        .arg(tData->speed));
+    }
+    mPendingHandles.clear();
+
+    if (data.isEmpty())
+    {
+        return QByteArray();
+    }
+
+    data.append(QString::fromUtf8("]"));
+    return QString::fromUtf8("event: transfers\r\ndata: %1\r\n\r\n").arg(data).toUtf8();
+}
+
 bool HTTPServer::isFirstWebDownloadDone = false;
-QMultiMap<QString, RequestData*> HTTPServer::webDataRequests;
-QMap<mega::MegaHandle, RequestTransferData*> HTTPServer::webTransferStateRequests;
+QMultiHash<QString, RequestData*> HTTPServer::webDataRequests;
+QList<QPair<QString, RequestData*>> HTTPServer::openWebDataRequests;
+QHash<mega::MegaHandle, RequestTransferData*> HTTPServer::webTransferStateRequests;
+unsigned long long HTTPServer::lastTransferStateRequestId = 0;
+QQueue<HTTPServer::DataRequestExpiry> HTTPServer::webDataRequestsExpiry;
+QQueue<HTTPServer::TransferStateExpiry> HTTPServer::webTransferStateRequestsExpiry;
+QList<HTTPServer*> HTTPServer::servers;
 
 HTTPServer::HTTPServer(MegaApi *megaApi, quint16 port)
     : QTcpServer(), disabled(false)
@@ -51,11 +134,13 @@ HTTPServer::HTTPServer(MegaApi *megaApi, quint16 port)
 
     connect(&mVersionCommandWatcher, &QFutureWatcher<VersionCommandAnswer>::finished,
             this, &HTTPServer::onVersionCommandFinished);
+
+    servers.append(this);
 }
 
 HTTPServer::~HTTPServer()
 {
-
+    servers.removeOne(this);
 }
 
 void HTTPServer::incomingConnection(qintptr socket)
@@ -73,7 +158,13 @@ void HTTPServer::incomingConnection(qintptr socket)
     connect(s, SIGNAL(disconnected()), this, SLOT(discardClient()));
 
     s->setSocketDescriptor(socket);
-    requests.insert(s, new HTTPRequest());
+
+    auto connection = std::make_shared<HTTPConnection>();
+    connection->idleTimer.setSingleShot(true);
+    connection->idleTimer.setInterval(KEEP_ALIVE_TIMEOUT_MS);
+    connect(&connection->idleTimer, &QTimer::timeout, s, &QTcpSocket::disconnectFromHost);
+    connection->idleTimer.start();
+    connections.insert(s, connection);
 }
 
 void HTTPServer::pause()
@@ -88,68 +179,67 @@ void HTTPServer::resume()
 
 void HTTPServer::checkAndPurgeRequests()
 {
-    for (QMultiMap<QString, RequestData*>::iterator it = webDataRequests.begin() ; it != webDataRequests.end();)
+    const long long now = QDateTime::currentMSecsSinceEpoch() / 1000;
+
+    while (!webDataRequestsExpiry.isEmpty()
+           && (now - webDataRequestsExpiry.head().tsEnd) > MAX_REQUEST_TIME_SECS)
     {
-        RequestData *requestData = it.value();
-        if ((requestData->status == RequestData::STATE_OK || requestData->status == RequestData::STATE_CANCELLED)
-                && (((QDateTime::currentMSecsSinceEpoch() / 1000) - requestData->tsEnd) > MAX_REQUEST_TIME_SECS))
-        {
-            webDataRequests.erase(it++);
-            delete requestData;
-        }
-        else
-        {
-            it++;
-        }
+        DataRequestExpiry expiry = webDataRequestsExpiry.dequeue();
+        webDataRequests.remove(expiry.bid, expiry.requestData);
+        delete expiry.requestData;
     }
 
-    for (QMap<MegaHandle, RequestTransferData*>::iterator it = webTransferStateRequests.begin() ; it != webTransferStateRequests.end();)
+    while (!webTransferStateRequestsExpiry.isEmpty()
+           && (now - webTransferStateRequestsExpiry.head().tsEnd) > MAX_REQUEST_TIME_SECS)
     {
+        TransferStateExpiry expiry = webTransferStateRequestsExpiry.dequeue();
+
+        // Skip entries replaced by a newer request for the same node, or finished again later
+        QHash<MegaHandle, RequestTransferData*>::iterator it = webTransferStateRequests.find(expiry.handle);
+        if (it == webTransferStateRequests.end() || it.value()->requestId != expiry.requestId)
+        {
+            continue;
+        }
+
         RequestTransferData *transferData = it.value();
         if ((transferData->state == MegaTransfer::STATE_CANCELLED
              || transferData->state == MegaTransfer::STATE_COMPLETED
              || transferData->state == MegaTransfer::STATE_FAILED)
-                && (((QDateTime::currentMSecsSinceEpoch() / 1000) - transferData->tsEnd) > MAX_REQUEST_TIME_SECS))
+                && transferData->tsEnd == expiry.tsEnd)
         {
-            webTransferStateRequests.erase(it++);
+            webTransferStateRequests.erase(it);
             delete transferData;
         }
-        else
-        {
-            it++;
-        }
     }
 }
 
 void HTTPServer::onUploadSelectionAccepted(qsizetype files, qsizetype folders)
 {
-    for (QMultiMap<QString, RequestData*>::iterator it = webDataRequests.begin() ; it != webDataRequests.end(); it++)
+    const long long tsEnd = QDateTime::currentMSecsSinceEpoch() / 1000;
+    for (const auto& openRequest : qAsConst(openWebDataRequests))
     {
-        if (it.value()->status == RequestData::STATE_OPEN)
-        {
-            it.value()->status = RequestData::STATE_OK;
-            it.value()->files = files;
-            it.value()->folders = folders;
-            it.value()->tsEnd = QDateTime::currentMSecsSinceEpoch() / 1000;
-        }
+        openRequest.second->status = RequestData::STATE_OK;
+        openRequest.second->files = files;
+        openRequest.second->folders = folders;
+        openRequest.second->tsEnd = tsEnd;
     }
+    expireOpenDataRequests();
 }
 
 void HTTPServer::onUploadSelectionDiscarded()
 {
-    for (QMultiMap<QString, RequestData*>::iterator it = webDataRequests.begin() ; it != webDataRequests.end(); it++)
+    const long long tsEnd = QDateTime::currentMSecsSinceEpoch() / 1000;
+    for (const auto& openRequest : qAsConst(openWebDataRequests))
     {
-        if (it.value()->status == RequestData::STATE_OPEN)
-        {
-            it.value()->status = RequestData::STATE_CANCELLED;
-            it.value()->tsEnd  = QDateTime::currentMSecsSinceEpoch() / 1000;
-        }
+        openRequest.second->status = RequestData::STATE_CANCELLED;
+        openRequest.second->tsEnd = tsEnd;
     }
+    expireOpenDataRequests();
 }
 
 void HTTPServer::onTransferDataUpdate(MegaHandle handle, int state, long long progress, long long size, long long speed, QString localPath)
 {
-    QMap<MegaHandle, RequestTransferData*>::iterator it = webTransferStateRequests.find(handle);
+    QHash<MegaHandle, RequestTransferData*>::iterator it = webTransferStateRequests.find(handle);
     if (it == webTransferStateRequests.end())
     {
         return;
@@ -177,7 +267,17 @@ void HTTPServer::onTransferDataUpdate(MegaHandle handle, int state, long long pr
             || state == MegaTransfer::STATE_COMPLETED
             || state == MegaTransfer::STATE_FAILED)
     {
-        tData->tsEnd = QDateTime::currentMSecsSinceEpoch() / 1000;
+        long long tsEnd = QDateTime::currentMSecsSinceEpoch() / 1000;
+        if (tData->tsEnd != tsEnd)
+        {
+            tData->tsEnd = tsEnd;
+            webTransferStateRequestsExpiry.enqueue({tsEnd, handle, tData->requestId});
+        }
+    }
+
+    for (HTTPServer* server : qAsConst(servers))
+    {
+        server->queueTransferEvent(handle);
     }
 }
 
@@ -185,36 +285,71 @@ void HTTPServer::readClient()
 {
     MegaApi::log(MegaApi::LOG_LEVEL_DEBUG, QString::fromUtf8("Processing webclient request via HTTP").toUtf8().constData());
     QAbstractSocket *socket = (QAbstractSocket*)sender();
-    HTTPRequest *request = requests.value(socket);
-    if (disabled || !request)
+    std::shared_ptr<HTTPConnection> connection = connections.value(socket);
+    if (disabled || !connection)
     {
         MegaApi::log(MegaApi::LOG_LEVEL_WARNING, "Webclient request not found");
         discardClient();
         return;
     }
 
-    QByteArray socketData = socket->readAll();
-    request->data.append(QString::fromUtf8(socketData.data()));
-    if (request->data.contains(QString::fromUtf8("\r\n\r\n")))
+    if (!connection->parser.feed(socket->readAll()))
+    {
+        MegaApi::log(MegaApi::LOG_LEVEL_WARNING, "Webclient request too large");
+        rejectRequest(socket, getRejectResponse(HTTPRequestParser::Status::PAYLOAD_TOO_LARGE));
+        return;
+    }
+
+    if (!connection->busy)
+    {
+        connection->idleTimer.start();
+    }
+
+    processPendingRequests(socket);
+}
+
+void HTTPServer::processPendingRequests(QAbstractSocket* socket)
+{
+    QPointer<QAbstractSocket> safeSocket = socket;
+    QPointer<HTTPServer> safeServer = this;
+
+    std::shared_ptr<HTTPConnection> connection = connections.value(socket);
+    while (connection && !connection->busy)
     {
-        QStringList tokens = request->data.split(QString::fromUtf8("\r\n\r\n"));
-        QStringList headers = tokens[0].split(QString::fromUtf8("\r\n"));
-        bool requestIsPost = isRequestOfType(headers, "POST");
-        bool requestIsOption = isRequestOfType(headers, "OPTION");
+        HTTPRequestParser::Status status = connection->parser.parse();
+        if (status == HTTPRequestParser::Status::INCOMPLETE)
+        {
+            return;
+        }
+
+        if (status != HTTPRequestParser::Status::COMPLETE)
+        {
+            MegaApi::log(MegaApi::LOG_LEVEL_WARNING, "Malformed webclient request");
+            rejectRequest(socket, getRejectResponse(status));
+            return;
+        }
 
-        if (!headers.size() || (!requestIsPost && !requestIsOption))
+        const QStringList& headers = connection->parser.headers();
+        const QUrl url(QString::fromUtf8(connection->parser.target()));
+        bool requestIsPost = (connection->parser.method() == "POST");
+        bool requestIsOption = (connection->parser.method() == "OPTIONS");
+        bool requestIsEvents = (connection->parser.method() == "GET" && url.path() == TRANSFER_EVENTS_PATH);
+        if (!requestIsPost && !requestIsOption && !requestIsEvents)
         {
             MegaApi::log(MegaApi::LOG_LEVEL_WARNING, "Method not allowed for webclient request");
             rejectRequest(socket, QString::fromUtf8("405 Method Not Allowed"));
             return;
         }
 
+        HTTPRequest request;
+        request.keepAlive = connection->parser.keepAlive();
+
         if (Preferences::HTTPS_ORIGIN_CHECK_ENABLED)
         {
             QString foundOrigin = findCorrespondingAllowedOrigin(headers);
             if (!foundOrigin.isEmpty())
             {
-                request->origin = foundOrigin;
+                request.origin = foundOrigin;
             }
             else
             {
@@ -224,43 +359,96 @@ void HTTPServer::readClient()
             }
         }
 
+        // Pipelined requests wait until this one is answered (some answers are asynchronous)
+        connection->busy = true;
+        connection->idleTimer.stop();
+
         if (requestIsPost)
         {
-            processPostRequest(socket, request, headers, tokens[1]);
+            request.contentLength = connection->parser.body().size();
+            request.data = QString::fromUtf8(connection->parser.body());
+            processRequest(socket, request);
+        }
+        else if (requestIsEvents)
+        {
+            // The connection is kept busy from now on, it only carries events
+            subscribeToTransferEvents(socket, request, url);
         }
         else // requestIsOption
         {
-            processOptionRequest(socket, request, headers);
+            processOptionRequest(socket, &request, headers);
+        }
+
+        if (!safeServer || !safeSocket)
+        {
+            return;
         }
     }
 }
-void HTTPServer::discardClient()
+
+void HTTPServer::finishConnectionRequest(QAbstractSocket* socket, bool keepAlive)
 {
-    QAbstractSocket* socket = (QSslSocket*)sender();
+    std::shared_ptr<HTTPConnection> connection = connections.value(socket);
+    if (keepAlive && connection)
+    {
+        connection->busy = false;
+        connection->idleTimer.start();
+
+        if (connection->parser.hasPendingData())
+        {
+            QPointer<QAbstractSocket> safeSocket = socket;
+            QMetaObject::invokeMethod(this, [this, safeSocket]()
+            {
+                if (safeSocket)
+                {
+                    processPendingRequests(safeSocket);
+                }
+            }, Qt::QueuedConnection);
+        }
+        return;
+    }
+
+    forgetClient(socket);
+    socket->disconnectFromHost();
     socket->deleteLater();
+}
 
-    HTTPRequest *request = requests.value(socket);
-    if (request)
-    {
-        requests.remove(socket);
-        delete request;
+void HTTPServer::forgetClient(QAbstractSocket* socket)
+{
+    connections.remove(socket);
+    transferEventsSubscribers.remove(socket);
+}
+
+QString HTTPServer::getRejectResponse(HTTPRequestParser::Status status)
+{
+    switch (status)
+    {
+    case HTTPRequestParser::Status::BAD_REQUEST:
+        return QString::fromUtf8("400 Bad Request");
+    case HTTPRequestParser::Status::LENGTH_REQUIRED:
+        return QString::fromUtf8("411 Length Required");
+    case HTTPRequestParser::Status::PAYLOAD_TOO_LARGE:
+        return QString::fromUtf8("413 Payload Too Large");
+    default:
+        return QString::fromUtf8("403 Forbidden");
     }
 }
 
+void HTTPServer::discardClient()
+{
+    QAbstractSocket* socket = (QSslSocket*)sender();
+    socket->deleteLater();
+    forgetClient(socket);
+}
+
 void HTTPServer::rejectRequest(QAbstractSocket *socket, QString response)
 {
     socket->write(QString::fromUtf8("HTTP/1.0 %1\r\n"
                   "\r\n").arg(response).toUtf8());
     socket->flush();
+    forgetClient(socket);
     socket->disconnectFromHost();
     socket->deleteLater();
-
-    HTTPRequest *request = requests.value(socket);
-    if (request)
-    {
-        requests.remove(socket);
-        delete request;
-    }
 }
 
 void HTTPServer::processRequest(QPointer<QAbstractSocket> socket, HTTPRequest request)
@@ -342,22 +530,109 @@ void HTTPServer::endProcessRequest(QPointer<QAbstractSocket> socket,const HTTPRe
             MegaApi::log(MegaApi::LOG_LEVEL_DEBUG, QString::fromUtf8("Response to HTTP request: %1").arg(response).toUtf8().constData());
         }
 
-        QString fullResponse = QString::fromUtf8("HTTP/1.0 200 Ok\r\n"
-                                                 "Access-Control-Allow-Origin: %1\r\n"
+        QByteArray content = response.toUtf8();
+        QString fullResponse = QString::fromUtf8("%1 200 Ok\r\n"
+                                                 "Access-Control-Allow-Origin: %2\r\n"
                                                  "Content-Type: text/html; charset=\"utf-8\"\r\n"
-                                                 "Content-Length: %2\r\n"
-                                                 "\r\n"
-                                                 "%3").arg(request.origin).arg(response.size()).arg(response);
+                                                 "Content-Length: %3\r\n"
+                                                 "%4"
+                                                 "\r\n")
+                                   .arg(request.keepAlive ? QString::fromUtf8("HTTP/1.1") : QString::fromUtf8("HTTP/1.0"),
+                                        request.origin,
+                                        QString::number(content.size()),
+                                        request.keepAlive ? QString::fromUtf8("Connection: keep-alive\r\n") : QString());
         if (safeServer && socket)
         {
-            socket->write(fullResponse.toUtf8());
+            socket->write(fullResponse.toUtf8() + content);
             socket->flush();
-            socket->disconnectFromHost();
-            socket->deleteLater();
+            finishConnectionRequest(socket, request.keepAlive);
+        }
+    }
+}
+
+void HTTPServer::subscribeToTransferEvents(QAbstractSocket* socket, const HTTPRequest& request, const QUrl& url)
+{
+    MegaApi::log(MegaApi::LOG_LEVEL_DEBUG, "Transfer events stream requested by the webclient");
+
+    socket->write(TransferEventsSubscriber::getStreamHead(request.origin));
+    socket->flush();
+
+    auto subscriber = std::make_shared<TransferEventsSubscriber>();
+    // The first event carries the state of every transfer requested so far
+    for (auto it = webTransferStateRequests.cbegin(); it != webTransferStateRequests.cend(); ++it)
+    {
+        subscriber->queue(it.key());
+    }
+
+    QPointer<QAbstractSocket> safeSocket = socket;
+    subscriber->flushTimer.setInterval(TransferEventsSubscriber::getInterval(url));
+    connect(&subscriber->flushTimer, &QTimer::timeout, this, [this, safeSocket]()
+    {
+        if (safeSocket)
+        {
+            flushTransferEvents(safeSocket);
         }
+    });
+    subscriber->flushTimer.start();
+    transferEventsSubscribers.insert(socket, subscriber);
+
+    flushTransferEvents(socket);
+}
+
+void HTTPServer::queueTransferEvent(MegaHandle handle)
+{
+    for (const auto& subscriber : qAsConst(transferEventsSubscribers))
+    {
+        subscriber->queue(handle);
+    }
+}
+
+void HTTPServer::flushTransferEvents(QAbstractSocket* socket)
+{
+    std::shared_ptr<TransferEventsSubscriber> subscriber = transferEventsSubscribers.value(socket);
+    if (!subscriber)
+    {
+        return;
+    }
+
+    const QByteArray event = subscriber->takeEvent(webTransferStateRequests,
+                                                   socket->bytesToWrite());
+    if (!event.isEmpty())
+    {
+        socket->write(event);
     }
 }
 
+qsizetype HTTPServer::getTransferEventsSubscribersCount() const
+{
+    return transferEventsSubscribers.size();
+}
+
+void HTTPServer::addTransferStateRequest(MegaHandle handle)
+{
+    // A new request for the same node replaces the previous state
+    RequestTransferData*& transferData = webTransferStateRequests[handle];
+    delete transferData;
+    transferData = new RequestTransferData();
+    transferData->requestId = ++lastTransferStateRequestId;
+}
+
+void HTTPServer::addUploadSelectionRequest(const QString& bid)
+{
+    RequestData* requestData = new RequestData();
+    webDataRequests.insert(bid, requestData);
+    openWebDataRequests.append(qMakePair(bid, requestData));
+}
+
+void HTTPServer::expireOpenDataRequests()
+{
+    for (const auto& openRequest : qAsConst(openWebDataRequests))
+    {
+        webDataRequestsExpiry.enqueue({openRequest.second->tsEnd, openRequest.first, openRequest.second});
+    }
+    openWebDataRequests.clear();
+}
+
 void HTTPServer::versionCommand(const HTTPRequest& request, QPointer<QAbstractSocket> socket)
 {
     auto future = QtConcurrent::run([this, socket, request]() -> VersionCommandAnswer
@@ -415,12 +690,7 @@ void HTTPServer::openLinkRequest(QString &response, const HTTPRequest& request)
         auto preferences = Preferences::instance();
         QString defaultPath = preferences->downloadFolder();
         MegaHandle megaHandle = megaApi->base64ToHandle(handle.toUtf8().constData());
-        QMap<MegaHandle, RequestTransferData*>::iterator it = webTransferStateRequests.find(megaHandle);
-        if (it != webTransferStateRequests.end())
-        {
-            delete it.value();
-        }
-        webTransferStateRequests.insert(megaHandle, new RequestTransferData());
+        addTransferStateRequest(megaHandle);
 
         if (preferences->hasDefaultDownloadFolder() && QFile(defaultPath).exists())
         {
@@ -569,12 +839,7 @@ void HTTPServer::externalDownloadRequest(QString &response, const HTTPRequest& r
                             WrappedNode(WrappedNode::TransferOrigin::FROM_WEBSERVER,
                                         node,
                                         undelete));
-                        QMap<MegaHandle, RequestTransferData*>::iterator it = webTransferStateRequests.find(h);
-                        if (it != webTransferStateRequests.end())
-                        {
-                            delete it.value();
-                        }
-                        webTransferStateRequests.insert(h, new RequestTransferData());
+                        addTransferStateRequest(h);
                     }
                     else
                     {
@@ -653,7 +918,7 @@ void HTTPServer::externalFileUploadRequest(QString &response, const HTTPRequest&
         QString bid = Utilities::extractJSONString(request.data, QString::fromUtf8("bid"));
         if (!bid.isEmpty())
         {
-            webDataRequests.insert(bid, new RequestData());
+            addUploadSelectionRequest(bid);
             emit onExternalFileUploadRequested(handle);
             response = QString::number(MegaError::API_OK);
         }
@@ -685,7 +950,7 @@ void HTTPServer::externalFileFolderUploadRequest(QString& response, const HTTPRe
         QString bid = Utilities::extractJSONString(request.data, QString::fromUtf8("bid"));
         if (!bid.isEmpty())
         {
-            webDataRequests.insert(bid, new RequestData());
+            addUploadSelectionRequest(bid);
             emit onExternalFileFolderUploadRequested(handle);
             response = QString::number(MegaError::API_OK);
         }
@@ -717,7 +982,7 @@ void HTTPServer::externalFolderUploadRequest(QString &response, const HTTPReques
         QString bid = Utilities::extractJSONString(request.data, QString::fromUtf8("bid"));
         if (!bid.isEmpty())
         {
-            webDataRequests.insert(bid, new RequestData());
+            addUploadSelectionRequest(bid);
             emit onExternalFolderUploadRequested(handle);
             response = QString::number(MegaError::API_OK);
         }
@@ -1071,57 +1336,6 @@ QString HTTPServer::findCorrespondingAllowedOrigin(const QStringList& headers)
     return QString();
 }
 
-void HTTPServer::processPostRequest(QAbstractSocket *socket, HTTPRequest* request,
-                                    const QStringList& headers, const QString& content)
-{
-    QString contentLengthId = QString::fromUtf8("Content-length: ");
-    QStringList contentLengthHeader = headers.filter(
-        QRegularExpression(contentLengthId, QRegularExpression::CaseInsensitiveOption));
-    if (!contentLengthHeader.size())
-    {
-        MegaApi::log(MegaApi::LOG_LEVEL_WARNING, "Missing Content-length header");
-        rejectRequest(socket);
-        return;
-    }
-
-    bool ok;
-    request->contentLength =
-        contentLengthHeader[0]
-            .mid(contentLengthId.size(), contentLengthHeader[0].size() - contentLengthId.size())
-            .toInt(&ok);
-    if (!ok || request->contentLength < content.size())
-    {
-        if (!ok)
-        {
-            MegaApi::log(MegaApi::LOG_LEVEL_WARNING, QString::fromUtf8("Unable to parse Content-length header: %1")
-                         .arg(contentLengthHeader[0]).toUtf8().constData());
-        }
-        else
-        {
-            MegaApi::log(MegaApi::LOG_LEVEL_WARNING, QString::fromUtf8("Invalid Content-length header. Header: %1 - Data: %2")
-                         .arg(request->contentLength).arg(content.size()).toUtf8().constData());
-        }
-        rejectRequest(socket);
-        return;
-    }
-
-    if (request->contentLength > content.size())
-    {
-        return;
-    }
-
-    request->data = content;
-
-
-    QPointer<QAbstractSocket> safeSocket = socket;
-    QPointer<HTTPServer> safeServer = this;
-    processRequest(socket, *request);
-    if (!safeServer || !safeSocket)
-    {
-        return;
-    }
-}
-
 void HTTPServer::sendPreFlightResponse(QAbstractSocket* socket, HTTPRequest* request, bool sendPrivateNetworkField)
 {
     QPointer<QAbstractSocket> safeSocket = socket;
@@ -1135,15 +1349,16 @@ void HTTPServer::sendPreFlightResponse(QAbstractSocket* socket, HTTPRequest* req
     if (sendPrivateNetworkField)
         fullResponse += QString::fromUtf8("Access-Control-Allow-Private-Network: true\r\n");
 
-    fullResponse += QString::fromUtf8(   "Access-Control-Max-Age: 86400\r\n"
-                                         "\r\n");
+    fullResponse += QString::fromUtf8("Access-Control-Max-Age: 86400\r\n");
+    if (request->keepAlive)
+        fullResponse += QString::fromUtf8("Connection: keep-alive\r\n");
+    fullResponse += QString::fromUtf8("\r\n");
 
     if (safeServer && safeSocket)
     {
         safeSocket->write(fullResponse.toUtf8());
         safeSocket->flush();
-        safeSocket->disconnectFromHost();
-        safeSocket->deleteLater();
+        finishConnectionRequest(safeSocket, request->keepAlive);
     }
 }
 
@@ -1151,7 +1366,12 @@ void HTTPServer::processOptionRequest(QAbstractSocket* socket, HTTPRequest* requ
 {
     bool isCors = isPreFlightCorsRequest(headers);
     if (!isCors)
+    {
+        // Nothing else is served through OPTIONS. Close it instead of leaving it unanswered,
+        // as it would block any request pipelined behind it
+        rejectRequest(socket);
         return;
+    }
 
     bool hasPrivateNetworkField = hasFieldWithValue(headers, "Access-Control-Request-Private-Network", "true");
 
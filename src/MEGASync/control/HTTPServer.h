@@ -1,6 +1,7 @@
 #ifndef HTTPSERVER_H
 #define HTTPSERVER_H
 
+#include "HTTPRequestParser.h"
 #include "megaapi.h"
 #include "Utilities.h"
 
@@ -9,10 +10,15 @@
 #include <QFutureWatcher>
 #include <QPointer>
 #include <QQueue>
+#include <QSet>
 #include <QSslKey>
 #include <QSslSocket>
 #include <QStringList>
 #include <QTcpServer>
+#include <QTimer>
+#include <QUrl>
+
+#include <memory>
 
 class RequestData
 {
@@ -36,6 +42,8 @@ class RequestTransferData
 {
 public:
     RequestTransferData();
+    // Unique for every request, as the addresses of deleted requests are reused
+    unsigned long long requestId;
     int state;
     long long progress;
     long long size;
@@ -48,10 +56,43 @@ public:
 class HTTPRequest
 {
 public:
-    HTTPRequest() : contentLength(0), origin(QString::fromUtf8("*")) {}
+    HTTPRequest() : contentLength(0), origin(QString::fromUtf8("*")), keepAlive(false) {}
     QString data;
     int contentLength;
     QString origin;
+    bool keepAlive;
+};
+
+class HTTPConnection
+{
+public:
+    HTTPConnection() : busy(false) {}
+    HTTPRequestParser parser;
+    // Set while a request is being answered, so pipelined requests are answered in order
+    bool busy;
+    QTimer idleTimer;
+};
+
+// Webclient connection subscribed to the transfer events stream
+class TransferEventsSubscriber
+{
+public:
+    // From the "interval" query item, bounded to the allowed range
+    static int getInterval(const QUrl& url);
+    // Response head, followed by the reconnection time for the browser
+    static QByteArray getStreamHead(const QString& origin);
+
+    void queue(mega::MegaHandle handle);
+    // "transfers" event with the latest state of the handles updated since the last one. Empty if
+    // there is nothing to send, or while the browser has not read what was already sent
+    QByteArray takeEvent(const QHash<mega::MegaHandle, RequestTransferData*>& transfers,
+                         qint64 bytesToWrite);
+
+    QTimer flushTimer;
+
+private:
+    // Only the latest state of each one is sent
+    QSet<mega::MegaHandle> mPendingHandles;
 };
 
 class HTTPServer: public QTcpServer
@@ -80,10 +121,18 @@ class HTTPServer: public QTcpServer
 
     public:
         static const unsigned int MAX_REQUEST_TIME_SECS;
+        static const int KEEP_ALIVE_TIMEOUT_MS;
+        static const QString TRANSFER_EVENTS_PATH;
+        static const int TRANSFER_EVENTS_DEFAULT_INTERVAL_MS;
+        static const int TRANSFER_EVENTS_MIN_INTERVAL_MS;
+        static const int TRANSFER_EVENTS_MAX_INTERVAL_MS;
+        static const qint64 TRANSFER_EVENTS_MAX_PENDING_BYTES;
 
         HTTPServer(mega::MegaApi *megaApi, quint16 port);
         ~HTTPServer();
 
+        qsizetype getTransferEventsSubscribersCount() const;
+
         void incomingConnection(qintptr socket);
         void pause();
         void resume();
@@ -120,8 +169,11 @@ class HTTPServer: public QTcpServer
     private:
         QString findCorrespondingAllowedOrigin(const QStringList& headers);
 
-        void processPostRequest(QAbstractSocket* socket, HTTPRequest* request,
-                                const QStringList& headers, const QString& content);
+        void processPendingRequests(QAbstractSocket* socket);
+        void finishConnectionRequest(QAbstractSocket* socket, bool keepAlive);
+        void forgetClient(QAbstractSocket* socket);
+        static QString getRejectResponse(HTTPRequestParser::Status status);
+
         void processOptionRequest(QAbstractSocket* socket, HTTPRequest* request, const QStringList& headers);
         void sendPreFlightResponse(QAbstractSocket* socket, HTTPRequest* request, bool sendPrivateNetworkField);
         bool hasFieldWithValue(const QStringList& headers, const char* fieldName, const char* value);
@@ -152,13 +204,44 @@ class HTTPServer: public QTcpServer
 
         void endProcessRequest(QPointer<QAbstractSocket> socket, const HTTPRequest &request, QString response);
 
+        void subscribeToTransferEvents(QAbstractSocket* socket, const HTTPRequest& request, const QUrl& url);
+        void queueTransferEvent(mega::MegaHandle handle);
+        void flushTransferEvents(QAbstractSocket* socket);
+
         RequestType GetRequestType(const HTTPRequest& request);
         bool disabled;
         mega::MegaApi *megaApi;
-        QMap<QAbstractSocket*, HTTPRequest*> requests;
+        static void addTransferStateRequest(mega::MegaHandle handle);
+        static void addUploadSelectionRequest(const QString& bid);
+        static void expireOpenDataRequests();
+
+        QHash<QAbstractSocket*, std::shared_ptr<HTTPConnection>> connections;
+        QHash<QAbstractSocket*, std::shared_ptr<TransferEventsSubscriber>> transferEventsSubscribers;
+        // Servers notified from the static transfer updates
+        static QList<HTTPServer*> servers;
         static bool isFirstWebDownloadDone;
-        static QMultiMap<QString, RequestData*> webDataRequests;
-        static QMap<mega::MegaHandle, RequestTransferData*> webTransferStateRequests;
+        static QMultiHash<QString, RequestData*> webDataRequests;
+        // Selection requests still waiting for the user, so they are resolved without a full scan
+        static QList<QPair<QString, RequestData*>> openWebDataRequests;
+        static QHash<mega::MegaHandle, RequestTransferData*> webTransferStateRequests;
+        static unsigned long long lastTransferStateRequestId;
+
+        // Finished requests in the order they finished. As they all live for
+        // MAX_REQUEST_TIME_SECS, only the head of each queue has to be checked when purging
+        struct DataRequestExpiry
+        {
+            long long tsEnd;
+            QString bid;
+            RequestData* requestData;
+        };
+        struct TransferStateExpiry
+        {
+            long long tsEnd;
+            mega::MegaHandle handle;
+            unsigned long long requestId;
+        };
+        static QQueue<DataRequestExpiry> webDataRequestsExpiry;
+        static QQueue<TransferStateExpiry> webTransferStateRequestsExpiry;
         QFutureWatcher<VersionCommandAnswer> mVersionCommandWatcher;
 };
 
@@ -0,0 +1,317 @@
+#include "ImageCache.h"
+
+#include "megaapi.h"
+#include "MegaApplication.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+#include <algorithm>
+
+namespace
+{
+const QLatin1String CACHE_FOLDER_NAME("images");
+const QLatin1String INDEX_FILE_NAME("index.json");
+
+const QLatin1String URL_KEY("url");
+const QLatin1String HASH_KEY("hash");
+const QLatin1String ETAG_KEY("eTag");
+const QLatin1String LAST_MODIFIED_KEY("lastModified");
+const QLatin1String SIZE_KEY("size");
+const QLatin1String VALIDATED_AT_KEY("validatedAt");
+const QLatin1String LAST_ACCESS_KEY("lastAccess");
+
+QString getContentHash(const QByteArray& content)
+{
+    const auto hash(QCryptographicHash::hash(content, QCryptographicHash::Sha256));
+    return QString::fromLatin1(hash.toHex());
+}
+}
+
+ImageCache::ImageCache(const QString& directory, qint64 maxSize, std::chrono::seconds maxAge):
+    mDirectory(directory),
+    mMaxSize(maxSize),
+    mMaxAge(maxAge),
+    mSize(0),
+    mAccessCounter(0)
+{
+    QDir().mkpath(mDirectory);
+    load();
+
+    mSaveTimer.setSingleShot(true);
+    mSaveTimer.setInterval(ACCESS_SAVE_DELAY_MS);
+    QObject::connect(&mSaveTimer,
+                     &QTimer::timeout,
+                     [this]()
+                     {
+                         save();
+                     });
+    // The shared cache is destroyed after the app, too late to use the timer
+    if (auto app = QCoreApplication::instance())
+    {
+        QObject::connect(app,
+                         &QCoreApplication::aboutToQuit,
+                         &mSaveTimer,
+                         [this]()
+                         {
+                             if (mSaveTimer.isActive())
+                             {
+                                 save();
+                             }
+                         });
+    }
+}
+
+ImageCache::~ImageCache()
+{
+    if (mSaveTimer.isActive())
+    {
+        save();
+    }
+}
+
+std::shared_ptr<ImageCache> ImageCache::instance()
+{
+    static std::shared_ptr<ImageCache> cache(
+        new ImageCache(QDir(MegaApplication::applicationDataPath()).filePath(CACHE_FOLDER_NAME)));
+    return cache;
+}
+
+std::optional<ImageCache::Entry> ImageCache::getEntry(const QString& url)
+{
+    auto entryIt(mEntries.find(url));
+    if (entryIt == mEntries.end())
+    {
+        return std::nullopt;
+    }
+
+    entryIt->lastAccess = ++mAccessCounter;
+    if (!mSaveTimer.isActive())
+    {
+        mSaveTimer.start();
+    }
+    return *entryIt;
+}
+
+bool ImageCache::isFresh(const Entry& entry) const
+{
+    const auto ageMs(QDateTime::currentMSecsSinceEpoch() - entry.validatedAtMs);
+    return ageMs >= 0 &&
+           ageMs < std::chrono::duration_cast<std::chrono::milliseconds>(mMaxAge).count();
+}
+
+QByteArray ImageCache::read(const Entry& entry)
+{
+    QFile file(getFilePath(entry.hash));
+    QByteArray content;
+    if (file.open(QIODevice::ReadOnly))
+    {
+        content = file.readAll();
+    }
+
+    // The file may have been removed or truncated out of the app
+    if (content.isEmpty() || getContentHash(content) != entry.hash)
+    {
+        mega::MegaApi::log(mega::MegaApi::LOG_LEVEL_WARNING,
+                           QString::fromUtf8("Discarding invalid cached image for %1")
+                               .arg(entry.url)
+                               .toUtf8()
+                               .constData());
+        remove(entry.url);
+        return QByteArray();
+    }
+
+    return content;
+}
+
+void ImageCache::store(const QString& url,
+                       const QByteArray& content,
+                       const QByteArray& eTag,
+                       const QByteArray& lastModified)
+{
+    Entry entry;
+    entry.url = url;
+    entry.hash = getContentHash(content);
+    entry.eTag = eTag;
+    entry.lastModified = lastModified;
+    entry.size = content.size();
+    entry.validatedAtMs = QDateTime::currentMSecsSinceEpoch();
+    entry.lastAccess = ++mAccessCounter;
+
+    removeEntry(url);
+
+    if (entry.size > mMaxSize)
+    {
+        save();
+        return;
+    }
+
+    if (!mFileUsers.contains(entry.hash))
+    {
+        QSaveFile file(getFilePath(entry.hash));
+        if (!file.open(QIODevice::WriteOnly) || file.write(content) != content.size() ||
+            !file.commit())
+        {
+            mega::MegaApi::log(mega::MegaApi::LOG_LEVEL_WARNING,
+                               QString::fromUtf8("Unable to write cached image for %1")
+                                   .arg(url)
+                                   .toUtf8()
+                                   .constData());
+            save();
+            return;
+        }
+        mSize += entry.size;
+    }
+
+    mFileUsers[entry.hash]++;
+    mEntries.insert(url, entry);
+
+    evict();
+    save();
+}
+
+void ImageCache::markValidated(const QString& url)
+{
+    auto entryIt(mEntries.find(url));
+    if (entryIt != mEntries.end())
+    {
+        entryIt->validatedAtMs = QDateTime::currentMSecsSinceEpoch();
+        save();
+    }
+}
+
+void ImageCache::remove(const QString& url)
+{
+    removeEntry(url);
+    save();
+}
+
+qint64 ImageCache::getSize() const
+{
+    return mSize;
+}
+
+QString ImageCache::getFilePath(const QString& hash) const
+{
+    return QDir(mDirectory).filePath(hash);
+}
+
+void ImageCache::removeEntry(const QString& url)
+{
+    auto entryIt(mEntries.find(url));
+    if (entryIt == mEntries.end())
+    {
+        return;
+    }
+
+    const auto hash(entryIt->hash);
+    const auto size(entryIt->size);
+    mEntries.erase(entryIt);
+
+    if (--mFileUsers[hash] <= 0)
+    {
+        mFileUsers.remove(hash);
+        QFile::remove(getFilePath(hash));
+        mSize -= size;
+    }
+}
+
+void ImageCache::evict()
+{
+    if (mSize <= mMaxSize)
+    {
+        return;
+    }
+
+    auto entries(mEntries.values());
+    std::sort(entries.begin(),
+              entries.end(),
+              [](const Entry& first, const Entry& second)
+              {
+                  return first.lastAccess < second.lastAccess;
+              });
+
+    for (const auto& entry: entries)
+    {
+        if (mSize <= mMaxSize)
+        {
+            break;
+        }
+        removeEntry(entry.url);
+    }
+}
+
+void ImageCache::load()
+{
+    QFile indexFile(QDir(mDirectory).filePath(INDEX_FILE_NAME));
+    if (!indexFile.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    const auto entries(QJsonDocument::fromJson(indexFile.readAll()).array());
+    for (const auto& value: entries)
+    {
+        const auto object(value.toObject());
+
+        Entry entry;
+        entry.url = object.value(URL_KEY).toString();
+        entry.hash = object.value(HASH_KEY).toString();
+        entry.eTag = object.value(ETAG_KEY).toString().toUtf8();
+        entry.lastModified = object.value(LAST_MODIFIED_KEY).toString().toUtf8();
+        entry.size = static_cast<qint64>(object.value(SIZE_KEY).toDouble());
+        entry.validatedAtMs = static_cast<qint64>(object.value(VALIDATED_AT_KEY).toDouble());
+        entry.lastAccess = static_cast<quint64>(object.value(LAST_ACCESS_KEY).toDouble());
+
+        // Files removed out of the app are dropped from the index
+        if (entry.url.isEmpty() || entry.hash.isEmpty() ||
+            QFileInfo(getFilePath(entry.hash)).size() != entry.size)
+        {
+            continue;
+        }
+
+        if (!mFileUsers.contains(entry.hash))
+        {
+            mSize += entry.size;
+        }
+        mFileUsers[entry.hash]++;
+        mAccessCounter = std::max(mAccessCounter, entry.lastAccess);
+        mEntries.insert(entry.url, entry);
+    }
+
+    evict();
+}
+
+void ImageCache::save()
+{
+    mSaveTimer.stop();
+
+    QJsonArray entries;
+    for (const auto& entry: mEntries)
+    {
+        QJsonObject object;
+        object.insert(URL_KEY, entry.url);
+        object.insert(HASH_KEY, entry.hash);
+        object.insert(ETAG_KEY, QString::fromUtf8(entry.eTag));
+        object.insert(LAST_MODIFIED_KEY, QString::fromUtf8(entry.lastModified));
+        object.insert(SIZE_KEY, static_cast<double>(entry.size));
+        object.insert(VALIDATED_AT_KEY, static_cast<double>(entry.validatedAtMs));
+        object.insert(LAST_ACCESS_KEY, static_cast<double>(entry.lastAccess));
+        entries.append(object);
+    }
+
+    QSaveFile indexFile(QDir(mDirectory).filePath(INDEX_FILE_NAME));
+    if (indexFile.open(QIODevice::WriteOnly))
+    {
+        indexFile.write(QJsonDocument(entries).toJson(QJsonDocument::Compact));
+        indexFile.commit();
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef IMAGE_CACHE_H
+#define IMAGE_CACHE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QTimer>
+
+#include <chrono>
+#include <memory>
+#include <optional>
+
+/// Responsibility: keeps the downloaded images on disk, so they are not fetched again each time
+/// they are shown. The files are named by the hash of their content, so URLs serving the same
+/// image share one file. Each URL keeps the validators of its last response (ETag and
+/// Last-Modified) to revalidate it with a conditional request once it is older than the max age.
+/// When the files take more than the max size, the least recently used URLs are evicted.
+/// The index is saved when files are added or removed. Cache hits only change the access order,
+/// which is saved a few seconds later, when the app quits or when the cache is destroyed.
+/// Only used from the GUI thread.
+class ImageCache
+{
+public:
+    struct Entry
+    {
+        QString url;
+        QString hash;
+        QByteArray eTag;
+        QByteArray lastModified;
+        qint64 size = 0;
+        qint64 validatedAtMs = 0;
+        quint64 lastAccess = 0;
+    };
+
+    static constexpr qint64 DEFAULT_MAX_SIZE = 20 * 1024 * 1024;
+    static constexpr std::chrono::seconds DEFAULT_MAX_AGE = std::chrono::hours(24);
+
+    explicit ImageCache(const QString& directory,
+                        qint64 maxSize = DEFAULT_MAX_SIZE,
+                        std::chrono::seconds maxAge = DEFAULT_MAX_AGE);
+    ~ImageCache();
+
+    // Cache in the app data folder, shared by all the image downloaders
+    static std::shared_ptr<ImageCache> instance();
+
+    // Marks the entry as the most recently used
+    std::optional<Entry> getEntry(const QString& url);
+    bool isFresh(const Entry& entry) const;
+    // Empty if the file is missing or corrupt, in which case the entry is removed
+    QByteArray read(const Entry& entry);
+
+    void store(const QString& url,
+               const QByteArray& content,
+               const QByteArray& eTag,
+               const QByteArray& lastModified);
+    // The server answered the conditional request with "Not Modified"
+    void markValidated(const QString& url);
+    void remove(const QString& url);
+
+    qint64 getSize() const;
+
+private:
+    QString getFilePath(const QString& hash) const;
+    void removeEntry(const QString& url);
+    void evict();
+    void load();
+    void save();
+
+    static constexpr int ACCESS_SAVE_DELAY_MS = 5000;
+
+    QString mDirectory;
+    qint64 mMaxSize;
+    std::chrono::seconds mMaxAge;
+    QHash<QString, Entry> mEntries;
+    // Number of entries using each file
+    QHash<QString, int> mFileUsers;
+    qint64 mSize;
+    quint64 mAccessCounter;
+    // Running while there are access changes not saved yet
+    QTimer mSaveTimer;
+};
+
+#endif // IMAGE_CACHE_H
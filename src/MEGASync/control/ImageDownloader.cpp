@@ -2,12 +2,38 @@
 
 #include "megaapi.h"
 
+#include <QCoreApplication>
+#include <QFutureWatcher>
 #include <QNetworkRequest>
+#include <QtConcurrent/QtConcurrent>
 
 namespace
 {
 constexpr int DefaultTimeout = 30000;
 constexpr int StatusCodeOK = 200;
+constexpr int StatusCodeNotModified = 304;
+
+// Run in a worker thread, so big images do not block the GUI
+QImage decodeImage(const QByteArray& bytes, const ImageData& imageData)
+{
+    QImage image;
+    if (!image.loadFromData(bytes))
+    {
+        return QImage();
+    }
+
+    if (image.format() != imageData.format)
+    {
+        image = image.convertToFormat(imageData.format);
+    }
+
+    if (imageData.size.isValid() && image.size() != imageData.size)
+    {
+        image = image.scaled(imageData.size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+
+    return image;
+}
 }
 
 ImageDownloader::ImageDownloader(QObject* parent)
@@ -17,14 +43,18 @@ ImageDownloader::ImageDownloader(QObject* parent)
 
 ImageDownloader::ImageDownloader(unsigned int timeout, QObject* parent)
     : QObject(parent)
-    , mManager(std::make_unique<QNetworkAccessManager>(nullptr))
     , mTimeout(timeout)
 {
-    connect(mManager.get(), &QNetworkAccessManager::finished,
-            this, &ImageDownloader::onRequestImgFinished);
 }
 
-void ImageDownloader::downloadImage(const QString& imageUrl, QImage::Format format)
+void ImageDownloader::setCache(std::shared_ptr<ImageCache> cache)
+{
+    mCache = cache;
+}
+
+void ImageDownloader::downloadImage(const QString& imageUrl,
+                                    QImage::Format format,
+                                    const QSize& size)
 {
     QUrl url(imageUrl);
     if (!url.isValid())
@@ -32,15 +62,67 @@ void ImageDownloader::downloadImage(const QString& imageUrl, QImage::Format form
         return;
     }
 
+    if (!mCache)
+    {
+        mCache = ImageCache::instance();
+    }
+
+    auto imageData = std::make_shared<ImageData>(imageUrl, format, size);
+
+    // Join the request in flight for the same URL and cache, if any
+    const PendingDownloadKey key(mCache.get(), imageUrl);
+    auto& pendingDownloads(getPendingDownloads());
+    auto pendingIt(pendingDownloads.find(key));
+    if (pendingIt != pendingDownloads.end())
+    {
+        (*pendingIt)->requesters.append(qMakePair(QPointer<ImageDownloader>(this), imageData));
+        return;
+    }
+
+    auto cachedEntry(mCache->getEntry(imageUrl));
+    if (cachedEntry.has_value() && mCache->isFresh(cachedEntry.value()))
+    {
+        const auto bytes(mCache->read(cachedEntry.value()));
+        if (!bytes.isEmpty())
+        {
+            processImageData(bytes, imageData);
+            return;
+        }
+        cachedEntry.reset();
+    }
+
     QNetworkRequest request(url);
     request.setTransferTimeout(static_cast<int>(mTimeout));
     request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+    if (cachedEntry.has_value())
+    {
+        // Revalidate the cached image: the server answers "Not Modified" if it is still valid
+        if (!cachedEntry->eTag.isEmpty())
+        {
+            request.setRawHeader("If-None-Match", cachedEntry->eTag);
+        }
+        if (!cachedEntry->lastModified.isEmpty())
+        {
+            request.setRawHeader("If-Modified-Since", cachedEntry->lastModified);
+        }
+    }
 
-    QNetworkReply* reply = mManager->get(request);
+    QNetworkReply* reply = getNetworkManager()->get(request);
     if (reply)
     {
-        auto imageData = std::make_shared<ImageData>(imageUrl, format);
-        mReplies.insert(reply, imageData);
+        auto pendingDownload(std::make_shared<PendingDownload>());
+        pendingDownload->cache = mCache;
+        pendingDownload->cachedEntry = cachedEntry;
+        pendingDownload->requesters.append(qMakePair(QPointer<ImageDownloader>(this), imageData));
+        pendingDownloads.insert(key, pendingDownload);
+
+        connect(reply,
+                &QNetworkReply::finished,
+                reply,
+                [reply, key]()
+                {
+                    onRequestImgFinished(reply, key);
+                });
     }
     else
     {
@@ -49,70 +131,138 @@ void ImageDownloader::downloadImage(const QString& imageUrl, QImage::Format form
     }
 }
 
-void ImageDownloader::onRequestImgFinished(QNetworkReply* reply)
+QNetworkAccessManager* ImageDownloader::getNetworkManager()
+{
+    // Shared by all the downloaders, so the requests for the same URL can be joined
+    static QPointer<QNetworkAccessManager> manager;
+    if (!manager)
+    {
+        manager = new QNetworkAccessManager(QCoreApplication::instance());
+    }
+    return manager;
+}
+
+QHash<ImageDownloader::PendingDownloadKey, std::shared_ptr<ImageDownloader::PendingDownload>>&
+    ImageDownloader::getPendingDownloads()
+{
+    static QHash<PendingDownloadKey, std::shared_ptr<PendingDownload>> pendingDownloads;
+    return pendingDownloads;
+}
+
+void ImageDownloader::onRequestImgFinished(QNetworkReply* reply, const PendingDownloadKey& key)
 {
     reply->deleteLater();
 
-    auto imageData = mReplies.take(reply);
-    if (!imageData)
+    const auto& url(key.second);
+    auto pendingDownload(getPendingDownloads().take(key));
+    if (!pendingDownload)
     {
         mega::MegaApi::log(mega::MegaApi::LOG_LEVEL_WARNING,
                            "Received finished signal for unknown QNetworkReply");
-        emit downloadFinishedWithError(QString(), Error::InvalidUrl);
         return;
     }
 
     QByteArray bytes;
-    if (!validateReply(reply, imageData->url, bytes))
+    Error error(Error::NoError);
+    const int statusCode(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt());
+    if (reply->error() == QNetworkReply::NoError && statusCode == StatusCodeNotModified &&
+        pendingDownload->cachedEntry.has_value())
     {
-        return;
+        bytes = pendingDownload->cache->read(pendingDownload->cachedEntry.value());
+        if (!bytes.isEmpty())
+        {
+            pendingDownload->cache->markValidated(url);
+        }
+        else
+        {
+            error = Error::EmptyData;
+        }
     }
-
-    processImageData(bytes, imageData);
-}
-
-bool ImageDownloader::validateReply(QNetworkReply* reply,
-                                    const QString& url,
-                                    QByteArray& bytes)
-{
-    bool success = true;
-    QVariant statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute);
-    if (!statusCode.isValid() || (statusCode.toInt() != StatusCodeOK) || (reply->error() != QNetworkReply::NoError))
+    else if (reply->error() == QNetworkReply::NoError && statusCode == StatusCodeOK)
+    {
+        bytes = reply->readAll();
+        if (!bytes.isEmpty())
+        {
+            pendingDownload->cache->store(url,
+                                          bytes,
+                                          reply->rawHeader("ETag"),
+                                          reply->rawHeader("Last-Modified"));
+        }
+        else
+        {
+            mega::MegaApi::log(mega::MegaApi::LOG_LEVEL_WARNING,
+                               "Downloaded image data is empty");
+            error = Error::EmptyData;
+        }
+    }
+    else
     {
         mega::MegaApi::log(mega::MegaApi::LOG_LEVEL_WARNING,
                            "Error downloading image %s : %d",
                            reply->errorString().toUtf8().constData(), reply->error());
-        emit downloadFinishedWithError(url, Error::NetworkError, reply->error());
-        success = false;
+        error = Error::NetworkError;
+
+        // Better an outdated image than none
+        if (pendingDownload->cachedEntry.has_value())
+        {
+            bytes = pendingDownload->cache->read(pendingDownload->cachedEntry.value());
+            if (!bytes.isEmpty())
+            {
+                error = Error::NoError;
+            }
+        }
     }
 
-    if(success)
+    for (const auto& requester: qAsConst(pendingDownload->requesters))
     {
-        bytes = reply->readAll();
-        if (bytes.isEmpty())
+        if (!requester.first)
         {
-            mega::MegaApi::log(mega::MegaApi::LOG_LEVEL_WARNING,
-                               "Downloaded image data is empty");
-            emit downloadFinishedWithError(url, Error::EmptyData, reply->error());
-            success = false;
+            continue;
         }
-    }
 
-    return success;
+        if (error == Error::NoError)
+        {
+            requester.first->processImageData(bytes, requester.second);
+        }
+        else
+        {
+            emit requester.first->downloadFinishedWithError(url, error, reply->error());
+        }
+    }
 }
 
 void ImageDownloader::processImageData(const QByteArray& bytes,
                                        const std::shared_ptr<ImageData>& imageData)
 {
-    QImage image(QSize(), imageData->format);
-    if (image.loadFromData(bytes))
-    {
-        emit downloadFinished(image, imageData->url);
-    }
-    else
-    {
-        mega::MegaApi::log(mega::MegaApi::LOG_LEVEL_WARNING,
-                           "Failed to load image from downloaded data");
-        emit downloadFinishedWithError(imageData->url, Error::InvalidImage, QNetworkReply::UnknownContentError);
-    }
+    auto watcher(new QFutureWatcher<QImage>(this));
+    connect(watcher,
+            &QFutureWatcher<QImage>::finished,
+            this,
+            [this, watcher, imageData]()
+            {
+                const auto image(watcher->result());
+                watcher->deleteLater();
+
+                if (!image.isNull())
+                {
+                    emit downloadFinished(image, imageData->url);
+                }
+                else
+                {
+                    mega::MegaApi::log(mega::MegaApi::LOG_LEVEL_WARNING,
+                                       "Failed to load image from downloaded data");
+                    if (mCache)
+                    {
+                        mCache->remove(imageData->url);
+                    }
+                    emit downloadFinishedWithError(imageData->url,
+                                                   Error::InvalidImage,
+                                                   QNetworkReply::UnknownContentError);
+                }
+            });
+    watcher->setFuture(QtConcurrent::run(
+        [bytes, imageData]()
+        {
+            return decodeImage(bytes, *imageData);
+        }));
 }
@@ -1,22 +1,32 @@
 #ifndef IMAGE_DOWNLOADER_H
 #define IMAGE_DOWNLOADER_H
 
+#include "ImageCache.h"
+
+#include <QHash>
 #include <QImage>
-#include <QMap>
+#include <QList>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QObject>
+#include <QPointer>
 
 #include <memory>
+#include <optional>
 
 struct ImageData
 {
     QString url = QString();
     QImage::Format format;
+    // If valid, the image is scaled to fit in it, keeping the aspect ratio
+    QSize size;
 
-    ImageData(const QString& url, QImage::Format format = QImage::Format_ARGB32_Premultiplied):
+    ImageData(const QString& url,
+              QImage::Format format = QImage::Format_ARGB32_Premultiplied,
+              const QSize& size = QSize()):
         url(url),
-        format(format)
+        format(format),
+        size(size)
     {
     }
 };
@@ -39,9 +49,13 @@ public:
     explicit ImageDownloader(unsigned int timeout, QObject* parent = nullptr);
     virtual ~ImageDownloader() = default;
 
+    // By default the images are kept in the cache shared by the whole app
+    void setCache(std::shared_ptr<ImageCache> cache);
+
 public slots:
     void downloadImage(const QString& imageUrl,
-                       QImage::Format format = QImage::Format_ARGB32_Premultiplied);
+                       QImage::Format format = QImage::Format_ARGB32_Premultiplied,
+                       const QSize& size = QSize());
 
 signals:
     void downloadFinished(const QImage& image,
@@ -50,18 +64,26 @@ signals:
                                    Error error,
                                    QNetworkReply::NetworkError networkError = QNetworkReply::NoError);
 
-private slots:
-    void onRequestImgFinished(QNetworkReply* reply);
-
 private:
-    QMap<QNetworkReply*, std::shared_ptr<ImageData>> mReplies;
-    std::unique_ptr<QNetworkAccessManager> mManager;
+    // A request in flight, shared by all the downloaders asking for the same URL with the same
+    // cache, which stores the response
+    struct PendingDownload
+    {
+        std::shared_ptr<ImageCache> cache;
+        std::optional<ImageCache::Entry> cachedEntry;
+        QList<QPair<QPointer<ImageDownloader>, std::shared_ptr<ImageData>>> requesters;
+    };
+    // The download keeps its cache alive, so the address is not reused while it is in flight
+    using PendingDownloadKey = QPair<const ImageCache*, QString>;
+
+    std::shared_ptr<ImageCache> mCache;
     unsigned int mTimeout;
 
-    bool validateReply(QNetworkReply* reply, const QString& url, QByteArray& bytes);
-    void processImageData(const QByteArray& bytes, const std::shared_ptr<ImageData>& imageData);
+    static QNetworkAccessManager* getNetworkManager();
+    static QHash<PendingDownloadKey, std::shared_ptr<PendingDownload>>& getPendingDownloads();
+    static void onRequestImgFinished(QNetworkReply* reply, const PendingDownloadKey& key);
 
+    void processImageData(const QByteArray& bytes, const std::shared_ptr<ImageData>& imageData);
 };
 
 #endif // IMAGE_DOWNLOADER_H
-
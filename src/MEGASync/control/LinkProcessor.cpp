@@ -8,38 +8,67 @@
 
 #include <QDir>
 
+#include <algorithm>
+
 using namespace mega;
 
-LinkProcessor::LinkProcessor(MegaApi* megaApi, MegaApi* megaApiFolders)
-    : LinkProcessor(QStringList(), megaApi, megaApiFolders) // Delegate to the second constructor with an empty QStringList
+const int LinkProcessor::DEFAULT_MAX_CONCURRENT_LINK_INFO_REQUESTS = 8;
+const int LinkProcessor::MAX_RESOLVED_LINKS = 500;
+const qint64 LinkProcessor::RESOLVED_LINK_EXPIRATION_MS = 10 * 60 * 1000;
+
+LinkProcessor::LinkProcessor(MegaApi* megaApi, FolderLinkApiPool* folderApiPool)
+    : LinkProcessor(QStringList(), megaApi, folderApiPool) // Delegate to the second constructor with an empty QStringList
 {
 }
 
 LinkProcessor::LinkProcessor(const QStringList& linkList,
                              MegaApi* megaApi,
-                             MegaApi* megaApiFolders):
+                             FolderLinkApiPool* folderApiPool):
     mMegaApi(megaApi),
-    mMegaApiFolders(megaApiFolders),
+    mFolderApiPool(folderApiPool),
+    mFolderApis(folderApiPool),
     mLinkList(linkList),
     mImportParentFolder(mega::INVALID_HANDLE),
     mDownloader(std::make_shared<MegaDownloader>(megaApi, this)),
-    mCurrentIndex(0)
+    mResolvedLinks(MAX_RESOLVED_LINKS),
+    mNextLinkIndex(0),
+    mLinkInfoRequestsInFlight(0),
+    mLinkInfoAvailableCount(0),
+    mMaxConcurrentLinkInfoRequests(DEFAULT_MAX_CONCURRENT_LINK_INFO_REQUESTS),
+    mLinkListId(0)
 {
     resetAndSetLinkList(linkList);
 
     // Register for SDK Request callbacks
     mDelegateListener = RequestListenerManager::instance().registerAndGetFinishListener(this);
+
+    // Folder links waiting for a session may continue
+    connect(mFolderApiPool, &FolderLinkApiPool::sessionReleased, this, [this]() {
+        if (!mFolderLinksWaitingForSession.isEmpty())
+        {
+            requestLinkInfo();
+        }
+    });
 }
 
 LinkProcessor::~LinkProcessor()
 {
+    // The sessions still resolving links are released when mFolderApis is destroyed, which must
+    // not resume this processor
+    disconnect(mFolderApiPool, nullptr, this, nullptr);
 }
 
 void LinkProcessor::resetAndSetLinkList(const QStringList& linkList)
 {
     mLinkObjects.clear();
-    mCurrentIndex = 0;
     mLinkList = linkList;
+    mLinkInfoAvailable = QVector<bool>(linkList.size(), false);
+    mFolderLinksWaitingForSession.clear();
+    mSetLinksInFlight.clear();
+    mNextLinkIndex = 0;
+    mLinkInfoRequestsInFlight = 0;
+    mLinkInfoAvailableCount = 0;
+    ++mLinkListId;
 
     for (int i = 0; i < linkList.size(); i++)
     {
@@ -86,18 +115,6 @@ void LinkProcessor::sendLinkInfoAvailableSignal(int index)
                              linkObject->showFolderIcon());
 }
 
-void LinkProcessor::continueOrFinishLinkInfoReq()
-{
-    if (mCurrentIndex == mLinkList.size())
-    {
-        emit onLinkInfoRequestFinish();
-    }
-    else
-    {
-        requestLinkInfo();
-    }
-}
-
 void LinkProcessor::createInvalidLinkObject(int index, int error, const QString& name)
 {
     if (!isValidIndex(mLinkObjects, index)) { return; }
@@ -186,38 +203,6 @@ void LinkProcessor::onRequestFinish(MegaRequest* request, MegaError* e)
 
     switch (request->getType())
     {
-    case MegaRequest::TYPE_GET_PUBLIC_NODE:
-    {
-        if (!isValidIndex(mLinkObjects, mCurrentIndex)) { return; }
-
-        if (error != MegaError::API_OK)
-        {
-            // Invalid Link
-            createInvalidLinkObject(mCurrentIndex, error, getReasonForExpiredLink(request, e));
-        }
-        else    // API_OK
-        {
-            MegaNode* node = request->getPublicMegaNode();
-
-            if (!node)
-            {
-                // Invalid Link
-                createInvalidLinkObject(mCurrentIndex, error, getReasonForExpiredLink(request, e));
-            }
-            else    // Valid Link
-            {
-                mLinkObjects[mCurrentIndex] = std::make_shared<LinkNode>(mMegaApi,
-                                                                         MegaNodeSPtr(node),
-                                                                         mLinkList[mCurrentIndex]);
-            }
-        }
-
-        mCurrentIndex++;
-        sendLinkInfoAvailableSignal(mCurrentIndex - 1);
-        continueOrFinishLinkInfoReq();
-        break;
-    }
-
     // Response to MegaApi::createFolder() request
     case MegaRequest::TYPE_CREATE_FOLDER:
     {
@@ -246,130 +231,285 @@ void LinkProcessor::onRequestFinish(MegaRequest* request, MegaError* e)
         break;
     }
 
-    case MegaRequest::TYPE_LOGIN:
-    {
-        if (!isValidIndex(mLinkObjects, mCurrentIndex)) { return; }
+    default:
+        break;
+    }
+}
 
-        if (error == MegaError::API_OK)
-        {
-            mMegaApiFolders->fetchNodes(mDelegateListener.get());
-        }
-        else
+void LinkProcessor::addTransfersAndStartIfNotStartedYet(LinkTransferType transferType)
+{
+    for (int i = 0; i < mLinkObjects.size(); i++)
+    {
+        if (isSelected(i))
         {
-            createInvalidLinkObject(mCurrentIndex, error, getReasonForExpiredLink(request, e));
-            mCurrentIndex++;
-            sendLinkInfoAvailableSignal(mCurrentIndex - 1);
-            continueOrFinishLinkInfoReq();
+            mTransferQueue.push_back({mLinkObjects[i], transferType});
+            processNextTransfer();
         }
-        break;
     }
+}
 
-    case MegaRequest::TYPE_FETCH_NODES:
+void LinkProcessor::requestLinkInfo()
+{
+    // Folder links waiting for a session go first, as they were found before
+    while (!mFolderLinksWaitingForSession.isEmpty() &&
+           mLinkInfoRequestsInFlight < mMaxConcurrentLinkInfoRequests)
     {
-        if (!isValidIndex(mLinkObjects, mCurrentIndex))
+        auto folderApi = mFolderApis.acquire();
+        if (!folderApi)
         {
             break;
         }
+        requestFolderLinkInfo(mFolderLinksWaitingForSession.dequeue(), folderApi);
+    }
 
-        if (error == MegaError::API_OK)
+    while (isValidIndex(mLinkList, mNextLinkIndex) &&
+           mLinkInfoRequestsInFlight < mMaxConcurrentLinkInfoRequests)
+    {
+        const int index = mNextLinkIndex++;
+        if (setLinkNodeFromCache(index))
         {
-            std::unique_ptr<MegaNode> rootNode(nullptr);
-            QString currentStr = mLinkList[mCurrentIndex];
-            QString splitSeparator;
-
-            if (currentStr.count(QChar::fromLatin1('!')) == 3)
-            {
-                splitSeparator = QString::fromUtf8("!");
-            }
-            else if (currentStr.count(QChar::fromLatin1('!')) == 2
-                     && currentStr.count(QChar::fromLatin1('?')) == 1)
-            {
-                splitSeparator = QString::fromUtf8("?");
-            }
-            else if (currentStr.count(QString::fromUtf8("/folder/")) == 2)
-            {
-                splitSeparator = QString::fromUtf8("/folder/");
-            }
-            else if (currentStr.count(QString::fromUtf8("/folder/")) == 1
-                     && currentStr.count(QString::fromUtf8("/file/")) == 1)
-            {
-                splitSeparator = QString::fromUtf8("/file/");
-            }
+            continue;
+        }
 
-            if (splitSeparator.isEmpty())
+        const QString& link = mLinkList[index];
+        if (ServiceUrls::instance()->isFolderLink(link))
+        {
+            auto folderApi = mFolderApis.acquire();
+            if (folderApi)
             {
-                rootNode.reset(mMegaApiFolders->getRootNode());
+                requestFolderLinkInfo(index, folderApi);
             }
             else
             {
-                QStringList linkparts = currentStr.split(splitSeparator, Qt::KeepEmptyParts);
-                MegaHandle handle = MegaApi::base64ToHandle(linkparts.last().toUtf8().constData());
-                rootNode.reset(mMegaApiFolders->getNodeByHandle(handle));
-            }
-
-            if (!rootNode)
-            {
-                break;
+                mFolderLinksWaitingForSession.enqueue(index);
             }
-
-            Preferences::instance()->setLastPublicHandle(request->getNodeHandle(), MegaApi::AFFILIATE_TYPE_FILE_FOLDER);
-            mega::MegaNode* node = mMegaApiFolders->authorizeNode(rootNode.get());
-            mLinkObjects[mCurrentIndex] = std::make_shared<LinkNode>(mMegaApi,
-                                                                     MegaNodeSPtr(node),
-                                                                     mLinkList[mCurrentIndex]);
+        }
+        else if (ServiceUrls::instance()->isSetLink(link))
+        {
+            // Sets are fetched one by one by the SetManager
+            mLinkInfoRequestsInFlight++;
+            mSetLinksInFlight.append(index);
+            emit requestFetchSetFromLink(link);
         }
         else
         {
-            // Invalid Link
-            createInvalidLinkObject(mCurrentIndex, error, getReasonForExpiredLink(request, e));
+            requestPublicNode(index);
         }
+    }
+}
 
-        mCurrentIndex++;
-        sendLinkInfoAvailableSignal(mCurrentIndex - 1);
-        continueOrFinishLinkInfoReq();
+void LinkProcessor::setMaxConcurrentLinkInfoRequests(int maxRequests)
+{
+    mMaxConcurrentLinkInfoRequests = std::max(1, maxRequests);
+}
 
-        break;
+bool LinkProcessor::isCurrentLinkInfoRequest(int index, unsigned int linkListId) const
+{
+    return linkListId == mLinkListId && isValidIndex(mLinkObjects, index);
+}
+
+bool LinkProcessor::setLinkNodeFromCache(int index)
+{
+    const QString& link = mLinkList[index];
+    auto resolvedLink = mResolvedLinks.object(link);
+    if (!resolvedLink)
+    {
+        return false;
     }
 
-    default:
-        break;
+    // The link may have been removed or changed since it was resolved
+    if (resolvedLink->age.hasExpired(RESOLVED_LINK_EXPIRATION_MS))
+    {
+        mResolvedLinks.remove(link);
+        return false;
     }
+
+    mLinkObjects[index] = std::make_shared<LinkNode>(mMegaApi, resolvedLink->node, link);
+    setLinkInfoAvailable(index);
+    return true;
 }
 
-void LinkProcessor::addTransfersAndStartIfNotStartedYet(LinkTransferType transferType)
+void LinkProcessor::setLinkNode(int index, MegaNodeSPtr node)
 {
-    for (int i = 0; i < mLinkObjects.size(); i++)
+    auto resolvedLink = new ResolvedLink{node, QElapsedTimer()};
+    resolvedLink->age.start();
+    mResolvedLinks.insert(mLinkList[index], resolvedLink);
+
+    mLinkObjects[index] = std::make_shared<LinkNode>(mMegaApi, node, mLinkList[index]);
+}
+
+void LinkProcessor::requestPublicNode(int index)
+{
+    mLinkInfoRequestsInFlight++;
+
+    const unsigned int linkListId(mLinkListId);
+    auto listener = RequestListenerManager::instance().registerAndGetCustomFinishListener(
+        this,
+        [this, index, linkListId](MegaRequest* request, MegaError* e)
+        {
+            onPublicNodeRequestFinish(index, linkListId, request, e);
+        });
+    mMegaApi->getPublicNode(mLinkList[index].toUtf8().constData(), listener.get());
+}
+
+void LinkProcessor::requestFolderLinkInfo(int index, MegaApi* folderApi)
+{
+    mLinkInfoRequestsInFlight++;
+
+    std::unique_ptr<char []> authToken(mMegaApi->getAccountAuth());
+    if (authToken)
     {
-        if (isSelected(i))
+        folderApi->setAccountAuth(authToken.get());
+    }
+
+    const unsigned int linkListId(mLinkListId);
+    auto listener = RequestListenerManager::instance().registerAndGetCustomFinishListener(
+        this,
+        [this, index, linkListId, folderApi](MegaRequest* request, MegaError* e)
         {
-            mTransferQueue.push_back({mLinkObjects[i], transferType});
-            processNextTransfer();
-        }
+            onFolderLoginFinish(index, linkListId, folderApi, request, e);
+        });
+    folderApi->loginToFolder(mLinkList[index].toUtf8().constData(), listener.get());
+}
+
+void LinkProcessor::onPublicNodeRequestFinish(int index,
+                                              unsigned int linkListId,
+                                              MegaRequest* request,
+                                              MegaError* e)
+{
+    if (!isCurrentLinkInfoRequest(index, linkListId)) { return; }
+
+    const int error = e->getErrorCode();
+    MegaNode* node = (error == MegaError::API_OK) ? request->getPublicMegaNode() : nullptr;
+    if (node)
+    {
+        setLinkNode(index, MegaNodeSPtr(node));
+    }
+    else
+    {
+        // Invalid Link
+        createInvalidLinkObject(index, error, getReasonForExpiredLink(request, e));
     }
+
+    onLinkInfoRequestDone(index);
 }
 
-void LinkProcessor::requestLinkInfo()
+void LinkProcessor::onFolderLoginFinish(int index,
+                                        unsigned int linkListId,
+                                        MegaApi* folderApi,
+                                        MegaRequest* request,
+                                        MegaError* e)
 {
-    if (!isValidIndex(mLinkList, mCurrentIndex)) { return; }
+    if (!isCurrentLinkInfoRequest(index, linkListId))
+    {
+        mFolderApis.release(folderApi);
+        return;
+    }
 
-    const QString link = mLinkList[mCurrentIndex];
-    if (ServiceUrls::instance()->isFolderLink(link))
+    const int error = e->getErrorCode();
+    if (error == MegaError::API_OK)
     {
-        std::unique_ptr<char []> authToken(mMegaApi->getAccountAuth());
-        if (authToken)
+        auto listener = RequestListenerManager::instance().registerAndGetCustomFinishListener(
+            this,
+            [this, index, linkListId, folderApi](MegaRequest* fetchRequest, MegaError* fetchError)
+            {
+                onFolderFetchNodesFinish(index, linkListId, folderApi, fetchRequest, fetchError);
+            });
+        folderApi->fetchNodes(listener.get());
+    }
+    else
+    {
+        createInvalidLinkObject(index, error, getReasonForExpiredLink(request, e));
+        mFolderApis.release(folderApi);
+        onLinkInfoRequestDone(index);
+    }
+}
+
+void LinkProcessor::onFolderFetchNodesFinish(int index,
+                                             unsigned int linkListId,
+                                             MegaApi* folderApi,
+                                             MegaRequest* request,
+                                             MegaError* e)
+{
+    if (!isCurrentLinkInfoRequest(index, linkListId))
+    {
+        mFolderApis.release(folderApi);
+        return;
+    }
+
+    const int error = e->getErrorCode();
+    std::unique_ptr<MegaNode> rootNode(nullptr);
+    if (error == MegaError::API_OK)
+    {
+        QString currentStr = mLinkList[index];
+        QString splitSeparator;
+
+        if (currentStr.count(QChar::fromLatin1('!')) == 3)
+        {
+            splitSeparator = QString::fromUtf8("!");
+        }
+        else if (currentStr.count(QChar::fromLatin1('!')) == 2
+                 && currentStr.count(QChar::fromLatin1('?')) == 1)
+        {
+            splitSeparator = QString::fromUtf8("?");
+        }
+        else if (currentStr.count(QString::fromUtf8("/folder/")) == 2)
+        {
+            splitSeparator = QString::fromUtf8("/folder/");
+        }
+        else if (currentStr.count(QString::fromUtf8("/folder/")) == 1
+                 && currentStr.count(QString::fromUtf8("/file/")) == 1)
         {
-            mMegaApiFolders->setAccountAuth(authToken.get());
+            splitSeparator = QString::fromUtf8("/file/");
         }
 
-        mMegaApiFolders->loginToFolder(link.toUtf8().constData(), mDelegateListener.get());
+        if (splitSeparator.isEmpty())
+        {
+            rootNode.reset(folderApi->getRootNode());
+        }
+        else
+        {
+            QStringList linkparts = currentStr.split(splitSeparator, Qt::KeepEmptyParts);
+            MegaHandle handle = MegaApi::base64ToHandle(linkparts.last().toUtf8().constData());
+            rootNode.reset(folderApi->getNodeByHandle(handle));
+        }
     }
-    else if (ServiceUrls::instance()->isSetLink(link))
+
+    MegaNodeSPtr authorizedNode(rootNode ? folderApi->authorizeNode(rootNode.get()) : nullptr);
+    if (authorizedNode)
     {
-        emit requestFetchSetFromLink(link);
+        Preferences::instance()->setLastPublicHandle(request->getNodeHandle(), MegaApi::AFFILIATE_TYPE_FILE_FOLDER);
+        setLinkNode(index, authorizedNode);
     }
     else
     {
-        mMegaApi->getPublicNode(link.toUtf8().constData(), mDelegateListener.get());
+        // Invalid Link
+        createInvalidLinkObject(index, error, getReasonForExpiredLink(request, e));
+    }
+
+    // The authorized nodes do not depend on the session anymore
+    mFolderApis.release(folderApi);
+    onLinkInfoRequestDone(index);
+}
+
+void LinkProcessor::onLinkInfoRequestDone(int index)
+{
+    mLinkInfoRequestsInFlight--;
+    setLinkInfoAvailable(index);
+    requestLinkInfo();
+}
+
+void LinkProcessor::setLinkInfoAvailable(int index)
+{
+    if (mLinkInfoAvailable[index]) { return; }
+
+    mLinkInfoAvailable[index] = true;
+    mLinkInfoAvailableCount++;
+    sendLinkInfoAvailableSignal(index);
+
+    if (mLinkInfoAvailableCount == mLinkList.size())
+    {
+        emit onLinkInfoRequestFinish();
     }
 }
 
@@ -380,13 +520,19 @@ void LinkProcessor::requestLinkInfo()
 // ----------------------------------------------------------------------------
 void LinkProcessor::onFetchSetFromLink(const AlbumCollection& collection)
 {
-    if (mCurrentIndex >= mLinkObjects.size()) { return; }
-
-    mLinkObjects[mCurrentIndex] = std::make_shared<LinkSet>(mMegaApi, collection);
-    mCurrentIndex++;
-
-    sendLinkInfoAvailableSignal(mCurrentIndex - 1);
-    continueOrFinishLinkInfoReq();
+    auto setIt = std::find_if(mSetLinksInFlight.begin(),
+                              mSetLinksInFlight.end(),
+                              [this, &collection](int index)
+                              {
+                                  return mLinkList[index] == collection.link;
+                              });
+    if (setIt == mSetLinksInFlight.end()) { return; }
+
+    const int index = *setIt;
+    mSetLinksInFlight.erase(setIt);
+
+    mLinkObjects[index] = std::make_shared<LinkSet>(mMegaApi, collection);
+    onLinkInfoRequestDone(index);
 }
 
 // ----------------------------------------------------------------------------
@@ -637,8 +783,11 @@ void LinkProcessor::onLinkSelected(int index, bool selected)
 //!
 void LinkProcessor::refreshLinkInfo()
 {
-    for (int i = 0; i < mCurrentIndex; i++)
+    for (int i = 0; i < mLinkInfoAvailable.size(); i++)
     {
-        sendLinkInfoAvailableSignal(i);
+        if (mLinkInfoAvailable[i])
+        {
+            sendLinkInfoAvailableSignal(i);
+        }
     }
 }
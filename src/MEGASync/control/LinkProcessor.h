@@ -1,17 +1,21 @@
 #ifndef LINKPROCESSOR_H
 #define LINKPROCESSOR_H
 
+#include "FolderLinkApiPool.h"
 #include "LinkObject.h"
 #include "megaapi.h"
 #include "QTMegaTransferListener.h"
 #include "SetTypes.h"
 
+#include <QCache>
+#include <QElapsedTimer>
 #include <QList>
 #include <QObject>
 #include <QPointer>
 #include <QQueue>
 #include <QSharedPointer>
 #include <QStringList>
+#include <QVector>
 
 #include <memory>
 
@@ -40,15 +44,17 @@ class LinkProcessor: public QObject, public mega::MegaTransferListener
     Q_OBJECT
 
 public:
-    LinkProcessor(mega::MegaApi* megaApi, mega::MegaApi* megaApiFolders);
-    LinkProcessor(const QStringList& linkList, mega::MegaApi* megaApi, mega::MegaApi* megaApiFolders);
+    LinkProcessor(mega::MegaApi* megaApi, FolderLinkApiPool* folderApiPool);
+    LinkProcessor(const QStringList& linkList, mega::MegaApi* megaApi, FolderLinkApiPool* folderApiPool);
     virtual ~LinkProcessor();
 
     void resetAndSetLinkList(const QStringList& linkList);
     QString getLink(int index) const;
     bool isSelected(int index) const;
     MegaNodeSPtr getNode(int index) const;
+    // Resolves the links which are not resolved yet, several of them at a time
     void requestLinkInfo();
+    void setMaxConcurrentLinkInfoRequests(int maxRequests);
     void importLinks(const QString& nodePath);
     mega::MegaHandle getImportParentFolder();
     void downloadLinks(const QString& localPath);
@@ -93,7 +99,27 @@ private:
 
     inline bool isLinkObjectValid(int index) const;
     void sendLinkInfoAvailableSignal(int index);
-    void continueOrFinishLinkInfoReq();
+    bool isCurrentLinkInfoRequest(int index, unsigned int linkListId) const;
+    bool setLinkNodeFromCache(int index);
+    void setLinkNode(int index, MegaNodeSPtr node);
+    void requestPublicNode(int index);
+    void requestFolderLinkInfo(int index, mega::MegaApi* folderApi);
+    void onPublicNodeRequestFinish(int index,
+                                   unsigned int linkListId,
+                                   mega::MegaRequest* request,
+                                   mega::MegaError* e);
+    void onFolderLoginFinish(int index,
+                             unsigned int linkListId,
+                             mega::MegaApi* folderApi,
+                             mega::MegaRequest* request,
+                             mega::MegaError* e);
+    void onFolderFetchNodesFinish(int index,
+                                  unsigned int linkListId,
+                                  mega::MegaApi* folderApi,
+                                  mega::MegaRequest* request,
+                                  mega::MegaError* e);
+    void onLinkInfoRequestDone(int index);
+    void setLinkInfoAvailable(int index);
     void createInvalidLinkObject(int index, int error, const QString& name = QString::fromUtf8(""));
 
     void addTransfersAndStartIfNotStartedYet(LinkTransferType transferType);
@@ -104,8 +130,20 @@ private:
     unsigned long long getAppDataId();
 
 private:
+    // Link metadata already resolved, so processing the same links again needs no requests
+    struct ResolvedLink
+    {
+        MegaNodeSPtr node;
+        QElapsedTimer age;
+    };
+
+    static const int DEFAULT_MAX_CONCURRENT_LINK_INFO_REQUESTS;
+    static const int MAX_RESOLVED_LINKS;
+    static const qint64 RESOLVED_LINK_EXPIRATION_MS;
+
     mega::MegaApi* mMegaApi;
-    mega::MegaApi* mMegaApiFolders;
+    FolderLinkApiPool* mFolderApiPool;
+    FolderLinkApiLeases mFolderApis;
     QStringList mLinkList;
     QList<std::shared_ptr<LinkObject>> mLinkObjects;
     mega::MegaHandle mImportParentFolder;
@@ -114,7 +152,16 @@ private:
     std::shared_ptr<MegaDownloader> mDownloader;
     QQueue<WrappedNode> mNodesToDownload;
     uint32_t mRequestCounter;
-    int mCurrentIndex;
+    QCache<QString, ResolvedLink> mResolvedLinks;
+    QVector<bool> mLinkInfoAvailable;
+    QQueue<int> mFolderLinksWaitingForSession;
+    QList<int> mSetLinksInFlight;
+    int mNextLinkIndex;
+    int mLinkInfoRequestsInFlight;
+    int mLinkInfoAvailableCount;
+    int mMaxConcurrentLinkInfoRequests;
+    // Changes with the link list, to discard the responses to the previous one
+    unsigned int mLinkListId;
     QQueue<LinkTransfer> mTransferQueue;
 };
 
@@ -55,6 +55,7 @@ void MegaDownloader::processDownloadQueue(DownloadInfo& info)
     }
 
     mNoTransferStarted = true;
+    mSetInitialTransfers = info.setInitialTransfers;
 
     if (info.appId == TransferMetaData::INVALID_ID && info.createAppId)
     {
@@ -126,7 +127,10 @@ void MegaDownloader::onAvailableSpaceCheckFinished(bool isDownloadPossible)
             appData = TransferMetaDataContainer::getAppDataById<DownloadTransferMetaData>(mQueueData.getCurrentAppDataId());
             if(appData)
             {
-                appData->setInitialTransfers(mQueueData.getDownloadQueueSize());
+                if (mSetInitialTransfers)
+                {
+                    appData->setInitialTransfers(mQueueData.getDownloadQueueSize());
+                }
                 batch.reset(new TransferBatch(appData->getAppId()));
                 mQueueData.addTransferBatch(batch);
             }
@@ -37,6 +37,9 @@ public:
         QString path;
         unsigned long long appId = TransferMetaData::INVALID_ID;
         bool createAppId = true;
+        // False when the app id is shared by several queues, and its owner sets how many
+        // transfers it expects
+        bool setInitialTransfers = true;
 
         bool checkLocalSpace = true;
     };
@@ -72,6 +75,7 @@ private:
     static QString createPathWithSeparator(const QString& path);
 
     bool mNoTransferStarted = true;
+    bool mSetInitialTransfers = true;
     std::shared_ptr<mega::MegaTransferListener> mTransferListener;
     std::shared_ptr<mega::QTMegaTransferListener> mTransferListenerDelegate;
     DownloadQueueController mQueueData;
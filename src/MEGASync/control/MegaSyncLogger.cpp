@@ -7,16 +7,22 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QString>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrent>
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <condition_variable>
 #include <ctime>
+#include <deque>
 #include <fstream>
 #include <future>
 #include <iostream>
 #include <sstream>
 #include <thread>
+#include <vector>
 #include <zlib.h>
 
 #ifdef WIN32
@@ -48,45 +54,108 @@
 #endif
 
 
+#define GZIP_MEMBER_CHUNK_SIZE (4 * 1024 * 1024)
+#define GZIP_MAX_WORKERS 4
+
+// Compresses a chunk of the log as a standalone gzip member
+bool gzipCompressChunk(const char* data, size_t size, std::string& output)
+{
+    z_stream stream{};
+    // 15 window bits + 16 to write a gzip header and trailer instead of a zlib one
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        return false;
+    }
+
+    output.resize(deflateBound(&stream, static_cast<uLong>(size)));
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    stream.avail_in = static_cast<uInt>(size);
+    stream.next_out = reinterpret_cast<Bytef*>(&output[0]);
+    stream.avail_out = static_cast<uInt>(output.size());
+
+    auto result = deflate(&stream, Z_FINISH);
+    output.resize(stream.total_out);
+    deflateEnd(&stream);
+
+    return result == Z_STREAM_END;
+}
+
+// The rotated log is read in chunks which are compressed in parallel. Concatenated gzip members
+// are a valid gzip file which decompresses to the whole log. Only a few chunks are in memory at a
+// time: a chunk is not read until an earlier one has been compressed and written.
 void gzipCompressOnRotate(const QString filename, const QString destinationFilename)
 {
-#ifdef WIN32
-    std::ifstream file(filename.toStdWString().data(), std::ofstream::out);
-#else
-    std::ifstream file(filename.toUtf8().data(), std::ofstream::out);
-#endif
-    if (!file.is_open())
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly))
     {
         std::cerr << "Unable to open log file for reading: "; CERRQSTRING(filename) << std::endl;
         return;
     }
 
-    auto gzdeleter = [](gzFile_s* f) { if (f) gzclose(f); };
-
-#ifdef _WIN32
-    std::unique_ptr<gzFile_s, decltype(gzdeleter)> gzfile{ gzopen_w(destinationFilename.toStdWString().data(), "wb"), gzdeleter};
-#else
-    std::unique_ptr<gzFile_s, decltype(gzdeleter)> gzfile{ gzopen(destinationFilename.toUtf8().data(), "wb"), gzdeleter };
-#endif
-    if (!gzfile)
+    QFile gzfile(destinationFilename);
+    if (!gzfile.open(QIODevice::WriteOnly | QIODevice::Truncate))
     {
         std::cerr << "Unable to open gzfile for writing: "; CERRQSTRING(filename) << std::endl;
         return;
     }
 
-    std::string line;
-    while (std::getline(file, line))
+    QThreadPool pool;
+    pool.setMaxThreadCount(std::max(1, std::min(QThread::idealThreadCount(), GZIP_MAX_WORKERS)));
+    const size_t maxChunksInFlight = static_cast<size_t>(2 * pool.maxThreadCount());
+
+    auto compressChunk = [](const QByteArray& chunk) {
+        std::pair<bool, std::string> member;
+        member.first = gzipCompressChunk(chunk.constData(), static_cast<size_t>(chunk.size()), member.second);
+        return member;
+    };
+
+    bool failed = false;
+    std::deque<QFuture<std::pair<bool, std::string>>> members;
+    auto writeFirstMember = [&failed, &members, &gzfile]() {
+        auto compressed = members.front().result();
+        members.pop_front();
+        failed = failed || !compressed.first
+                 || gzfile.write(compressed.second.data(), static_cast<qint64>(compressed.second.size()))
+                        != static_cast<qint64>(compressed.second.size());
+    };
+
+    // An empty log still produces a valid (empty) gzip file
+    bool emptyLog = true;
+    while (!failed && !file.atEnd())
     {
-        line.push_back('\n');
-        if (gzputs(gzfile.get(), line.c_str()) == -1)
+        const QByteArray chunk = file.read(GZIP_MEMBER_CHUNK_SIZE);
+        if (chunk.isEmpty())
         {
-            std::cerr << "Unable to compress log file: "; CERRQSTRING(filename) << std::endl;
-            return;
+            failed = true;
+            break;
         }
+
+        emptyLog = false;
+        members.push_back(QtConcurrent::run(&pool, compressChunk, chunk));
+        if (members.size() >= maxChunksInFlight)
+        {
+            writeFirstMember();
+        }
+    }
+
+    if (emptyLog && !failed)
+    {
+        members.push_back(QtConcurrent::run(&pool, compressChunk, QByteArray()));
+    }
+
+    while (!members.empty())
+    {
+        writeFirstMember();
     }
 
-    gzfile.reset();
     file.close();
+    gzfile.close();
+    if (failed)
+    {
+        std::cerr << "Unable to compress log file: "; CERRQSTRING(filename) << std::endl;
+        return;
+    }
+
     QFile::remove(filename);
 }
 
@@ -783,6 +852,11 @@ void MegaSyncLogger::resumeAfterReporting()
 {
 }
 
+std::unique_lock<std::mutex> MegaSyncLogger::lockRotation()
+{
+    return std::unique_lock<std::mutex>(g_loggingThread->logRotationMutex);
+}
+
 void MegaSyncLogger::flushAndClose()
 {
     try
@@ -8,6 +8,7 @@
 #include <QXmlStreamWriter>
 
 #include <memory>
+#include <mutex>
 
 #define LOGS_FOLDER_LEAFNAME_QSTRING QString::fromUtf8("logs")
 
@@ -42,6 +43,10 @@ public:
     bool cleanLogs();
     void resumeAfterReporting();
 
+    // The log files are not rotated, compressed nor removed while the returned lock is held, so
+    // they can be listed and read meanwhile. The messages logged in the meantime wait in memory
+    std::unique_lock<std::mutex> lockRotation();
+
 signals:
     void logReadyForReporting();
     void logCleaned();
@@ -3,6 +3,7 @@
 #include "MegaApiSynchronizedRequest.h"
 #include "MegaApplication.h"
 #include "MoveToMEGABin.h"
+#include "UniqueNameAllocator.h"
 #include "Utilities.h"
 
 MergeMEGAFolders::MergeMEGAFolders(ActionForDuplicates action,
@@ -159,8 +160,9 @@ int MergeMEGAFolders::finishMerge(mega::MegaNode* folderTarget, mega::MegaNode*
         }
         else if (mAction == ActionForDuplicates::Rename)
         {
-            QStringList itemsBeingRenamed;
-            error = rename(folderToMerge, folderTarget, itemsBeingRenamed);
+            UniqueNameAllocator nameAllocator;
+            nameAllocator.addRemoteFolderNames(folderTarget, false);
+            error = rename(folderToMerge, folderTarget, nameAllocator);
         }
     }
 
@@ -172,13 +174,20 @@ int MergeMEGAFolders::mergeNestedNodesIntoTargetFolder(
     mega::MegaNode* folderToMerge,
     QMap<QString, std::shared_ptr<mega::MegaNode>>& targetNodeWithoutNameConflict)
 {
-    QStringList itemsBeingRenamed;
-
     int error(mega::MegaError::API_OK);
 
     std::unique_ptr<mega::MegaNodeList> folderToMergeNodes(
         MegaSyncApp->getMegaApi()->getChildren(folderToMerge));
 
+    // Read both folders once: renamed items must not collide with the current target items nor
+    // with the nested items which are going to be moved later
+    UniqueNameAllocator nameAllocator;
+    nameAllocator.addRemoteFolderNames(folderTarget, false);
+    for (int index = 0; index < folderToMergeNodes->size(); ++index)
+    {
+        nameAllocator.reserve(QString::fromUtf8(folderToMergeNodes->get(index)->getName()));
+    }
+
     for (int index = 0; index < folderToMergeNodes->size(); ++index)
     {
         auto nestedNodeToMerge(folderToMergeNodes->get(index));
@@ -207,7 +216,7 @@ int MergeMEGAFolders::mergeNestedNodesIntoTargetFolder(
                 }
                 else
                 {
-                    error = rename(nestedNodeToMerge, folderTarget, itemsBeingRenamed);
+                    error = rename(nestedNodeToMerge, folderTarget, nameAllocator);
                 }
             }
             else if (nestedNodeToMerge->isFolder() && targetNode->isFolder())
@@ -216,7 +225,7 @@ int MergeMEGAFolders::mergeNestedNodesIntoTargetFolder(
             }
             else
             {
-                error = rename(nestedNodeToMerge, folderTarget, itemsBeingRenamed);
+                error = rename(nestedNodeToMerge, folderTarget, nameAllocator);
             }
         }
         // We can simply move the node, as there is no item with the same name in the target node
@@ -275,14 +284,11 @@ void MergeMEGAFolders::logError(int error)
 
 int MergeMEGAFolders::rename(mega::MegaNode* nodeToRename,
                              mega::MegaNode* parentNode,
-                             QStringList& itemsBeingRenamed)
+                             UniqueNameAllocator& nameAllocator)
 {
     QString currentName(getNodeName(nodeToRename));
-    QString newName = Utilities::getNonDuplicatedNodeName(nodeToRename,
-                                                          parentNode,
-                                                          currentName,
-                                                          true,
-                                                          itemsBeingRenamed);
+    QString newName =
+        Utilities::getNonDuplicatedNodeName(nodeToRename, currentName, true, nameAllocator);
 
     auto result = MegaApiSynchronizedRequest::runRequestLambda(
         [this](mega::MegaNode* node,
@@ -306,14 +312,7 @@ int MergeMEGAFolders::rename(mega::MegaNode* nodeToRename,
         parentNode,
         newName.toUtf8().constData());
 
-    auto error = result ? result->getErrorCode() : mega::MegaError::API_OK;
-
-    if (error == mega::MegaError::API_OK)
-    {
-        itemsBeingRenamed.append(newName);
-    }
-
-    return error;
+    return result ? result->getErrorCode() : mega::MegaError::API_OK;
 }
 
 QString MergeMEGAFolders::getNodeName(mega::MegaNode* node)
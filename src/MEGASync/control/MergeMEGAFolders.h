@@ -7,6 +7,8 @@
 
 #include <memory>
 
+class UniqueNameAllocator;
+
 //FOLDER MERGE LOGIC
 /*
    1. Detect if there are more than 1 folder with the same name in the name conflict received from the SDK
@@ -68,7 +70,7 @@ private:
     void logError(int error);
     int rename(mega::MegaNode* nodeToRename,
                mega::MegaNode* parentNode,
-               QStringList& itemsBeingRenamed);
+               UniqueNameAllocator& nameAllocator);
     QString getNodeName(mega::MegaNode* node);
 
     Qt::CaseSensitivity mCaseSensitivity;
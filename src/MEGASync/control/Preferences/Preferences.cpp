@@ -2842,6 +2842,12 @@ QMap<mega::MegaHandle, std::shared_ptr<SyncSettings> > Preferences::getLoadedSyn
     return loadedSyncsMap;
 }
 
+std::shared_ptr<SyncSettings> Preferences::getLoadedSyncSetting(mega::MegaHandle backupId)
+{
+    QMutexLocker qm(&mutex);
+    return loadedSyncsMap.value(backupId, nullptr);
+}
+
 void Preferences::readFolders()
 {
     mutex.lock();
@@ -2893,6 +2899,11 @@ void Preferences::removeSyncSetting(std::shared_ptr<SyncSettings> syncSettings)
 }
 
 void Preferences::writeSyncSetting(std::shared_ptr<SyncSettings> syncSettings)
+{
+    writeSyncSettings({syncSettings});
+}
+
+void Preferences::writeSyncSettings(const QList<std::shared_ptr<SyncSettings>>& syncSettings)
 {
     if (logged())
     {
@@ -2900,11 +2911,14 @@ void Preferences::writeSyncSetting(std::shared_ptr<SyncSettings> syncSettings)
 
         mSettings->beginGroup(syncsGroupByTagKey);
 
-        mSettings->beginGroup(QString::number(syncSettings->backupId()));
+        for (const auto& syncSetting : syncSettings)
+        {
+            mSettings->beginGroup(QString::number(syncSetting->backupId()));
 
-        mSettings->setValue(configuredSyncsKey, syncSettings->toString());
+            mSettings->setValue(configuredSyncsKey, syncSetting->toString());
 
-        mSettings->endGroup();
+            mSettings->endGroup();
+        }
 
         mSettings->endGroup();
     }
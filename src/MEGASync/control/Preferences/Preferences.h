@@ -328,8 +328,10 @@ public:
 
     // sync related
     void writeSyncSetting(std::shared_ptr<SyncSettings> syncSettings); // write sync into cache
+    void writeSyncSettings(const QList<std::shared_ptr<SyncSettings>>& syncSettings); // write several syncs at once
     void removeSyncSetting(std::shared_ptr<SyncSettings> syncSettings); //remove one sync from cache
     QMap<mega::MegaHandle, std::shared_ptr<SyncSettings> > getLoadedSyncsMap() const; //return loaded syncs when loggedin/entered user
+    std::shared_ptr<SyncSettings> getLoadedSyncSetting(mega::MegaHandle backupId); //return one loaded sync, without copying the map
     void removeAllFolders(); // remove all syncs from cache
 
     bool isOneTimeActionDone(int action);
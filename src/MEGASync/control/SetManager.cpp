@@ -9,11 +9,21 @@
 
 using namespace mega;
 
+namespace
+{
+constexpr int MAX_ELEMENT_NODE_REQUESTS_IN_FLIGHT = 50;
+// Downloads of a Set from a link start with the first Elements received
+constexpr int ELEMENT_DOWNLOAD_BATCH_SIZE = 100;
+}
+
 SetManager::SetManager(MegaApi* megaApi, MegaApi* megaApiFolders):
     AsyncHandler(),
     mMegaApi(megaApi),
     mMegaApiFolders(megaApiFolders),
+    mElementNodeRequestsInFlight(0),
+    mElementNodeRequestsGeneration(0),
     mDownloadedCounter(0),
+    mCurrentAppDataId(TransferMetaData::INVALID_ID),
     mDownloader(std::make_shared<MegaDownloader>(megaApi, this)),
     mSetManagerState(SetManagerState::INIT)
 {
@@ -314,10 +324,14 @@ void SetManager::handleStateWaitForPreviewSetToGetData(const ActionParams& actio
         break;
 
     case ActionType::HANDLE_ELEMENT_IN_PREVIEW_MODE:
-        if (mCurrentSet.isComplete())
+        if (allPreviewElementNodesReceived())
         {
-            // Notify observers
-            emit onFetchSetFromLink(mCurrentSet);
+            finishPreviewElementNodes();
+            if (mCurrentSet.isComplete())
+            {
+                // Notify observers
+                emit onFetchSetFromLink(mCurrentSet);
+            }
 
             // End preview
             mMegaApi->stopPublicSetPreview();
@@ -355,12 +369,31 @@ void SetManager::handleStateWaitForPreviewSetToDownloadFromLink(const ActionPara
         break;
 
     case ActionType::HANDLE_ELEMENT_IN_PREVIEW_MODE:
-        // A new Set Element node has been fetched
-        if (!mCurrentSet.nodeList.isEmpty())
+    {
+        // A new Set Element node has been fetched: download the Elements in batches, the first
+        // ones while the rest are still being fetched
+        const bool allReceived(allPreviewElementNodesReceived());
+        if (mCurrentSet.nodeList.size() >= ELEMENT_DOWNLOAD_BATCH_SIZE ||
+            (allReceived && !mCurrentSet.nodeList.isEmpty()))
         {
             startDownload(mCurrentSet.nodeList, mCurrentDownloadPath);
         }
+
+        if (allReceived)
+        {
+            finishPreviewElementNodes();
+            updateExpectedDownloads();
+            // Nothing to download, or every download finished before the last Elements failed
+            if (mCurrentSet.elementHandleList.isEmpty() ||
+                mDownloadedCounter == mCurrentSet.elementHandleList.size())
+            {
+                mDownloadedCounter = 0;
+                mMegaApi->stopPublicSetPreview();
+                resetAndHandleStates();
+            }
+        }
         break;
+    }
 
     default:
         break;
@@ -420,11 +453,6 @@ void SetManager::onRequestFinish(MegaRequest* request, MegaError* error)
         handleFetchPublicSetResponse(request, error);
         break;
 
-    // Response to MegaApi::getPreviewElementNode() request
-    case MegaRequest::TYPE_GET_EXPORTED_SET_ELEMENT:
-        handleGetPreviewElementNodeResponse(request, error);
-        break;
-
     // Response to MegaApi::createFolder() request
     case MegaRequest::TYPE_CREATE_FOLDER:
         handleCreateFolderResponse(request, error);
@@ -527,20 +555,44 @@ void SetManager::handleFetchPublicSetResponse(MegaRequest* request, MegaError* e
     handleStates();
 }
 
-void SetManager::handleGetPreviewElementNodeResponse(MegaRequest* request, MegaError* error)
+void SetManager::handleGetPreviewElementNodeResponse(MegaRequest* request,
+                                                     MegaError* error,
+                                                     unsigned long long generation)
 {
+    // Responses to a Set which is not in preview anymore
+    if (generation != mElementNodeRequestsGeneration || mElementNodeRequestsInFlight <= 0)
+    {
+        return;
+    }
+
     // Verify Precondition
     if (!request || !error ||
-        (request->getType() != MegaRequest::TYPE_GET_EXPORTED_SET_ELEMENT) ||
-        (error->getErrorCode() != MegaError::API_OK))
+        (request->getType() != MegaRequest::TYPE_GET_EXPORTED_SET_ELEMENT))
     {
         resetAndHandleStates();
         return;
     }
+    mElementNodeRequestsInFlight--;
 
     // Do not expose the raw pointer in a variable, to prevent 'double-free' vulnerability
-    MegaNodeSPtr nodeSPtr(request->getPublicMegaNode());
-    mCurrentSet.nodeList.push_back(WrappedNode(WrappedNode::FROM_LINK, nodeSPtr, false));
+    MegaNodeSPtr nodeSPtr(error->getErrorCode() == MegaError::API_OK ? request->getPublicMegaNode() :
+                                                                       nullptr);
+    if (nodeSPtr)
+    {
+        mCurrentSet.nodeList.push_back(WrappedNode(WrappedNode::FROM_LINK, nodeSPtr, false));
+        mReceivedElementHandles.push_back(request->getNodeHandle());
+    }
+    else
+    {
+        // The rest of the Set is still usable without this Element
+        MegaApi::log(MegaApi::LOG_LEVEL_WARNING,
+                     QString::fromUtf8("Set Element node not available: %1")
+                         .arg(QString::fromUtf8(error->getErrorString()))
+                         .toUtf8()
+                         .constData());
+    }
+
+    requestNextPreviewElementNodes();
 
     // Delegate to State Machine
     ActionParams action;
@@ -647,8 +699,16 @@ void SetManager::checkandHandleFinishedImport()
 
 unsigned long long SetManager::getAppDataId()
 {
-    auto data = TransferMetaDataContainer::createImportedLinkTransferMetaData(mCurrentDownloadPath);
-    return data->getAppId();
+    if (mCurrentAppDataId == TransferMetaData::INVALID_ID)
+    {
+        auto data =
+            TransferMetaDataContainer::createImportedLinkTransferMetaData(mCurrentDownloadPath);
+        // The first batch is not the whole Set, so the metadata expects every Element from the start
+        data->setInitialTransfers(mCurrentSet.elementHandleList.size());
+        mCurrentAppDataId = data->getAppId();
+    }
+
+    return mCurrentAppDataId;
 }
 
 //!
@@ -742,20 +802,77 @@ bool SetManager::getPreviewElementNodes()
     if (mCurrentSet.elementHandleList.isEmpty()) { return false; }
 
     // Fetch all Elements
+    mPendingElementNodeRequests.clear();
+    mReceivedElementHandles.clear();
+    mElementNodeRequestsInFlight = 0;
+    mElementNodeRequestsGeneration++;
     for (const auto& handle: std::as_const(mCurrentSet.elementHandleList))
     {
-        mMegaApi->getPreviewElementNode(handle, mDelegateListener.get());
+        mPendingElementNodeRequests.enqueue(handle);
     }
+    requestNextPreviewElementNodes();
 
     return true;
 }
 
+void SetManager::requestNextPreviewElementNodes()
+{
+    while (!mPendingElementNodeRequests.isEmpty() &&
+           mElementNodeRequestsInFlight < MAX_ELEMENT_NODE_REQUESTS_IN_FLIGHT)
+    {
+        mElementNodeRequestsInFlight++;
+
+        // Each request remembers the Set it was made for
+        const auto generation(mElementNodeRequestsGeneration);
+        auto listener = RequestListenerManager::instance().registerAndGetCustomFinishListener(
+            this,
+            [this, generation](MegaRequest* request, MegaError* error)
+            {
+                handleGetPreviewElementNodeResponse(request, error, generation);
+            });
+        mMegaApi->getPreviewElementNode(mPendingElementNodeRequests.dequeue(), listener.get());
+    }
+}
+
+bool SetManager::allPreviewElementNodesReceived() const
+{
+    return mPendingElementNodeRequests.isEmpty() && mElementNodeRequestsInFlight == 0;
+}
+
+//!
+//! \brief SetManager::finishPreviewElementNodes
+//! \Keeps only the Elements whose node was received, in the order of @mCurrentSet.nodeList,
+//! \which is the order the responses arrived in
+void SetManager::finishPreviewElementNodes()
+{
+    mCurrentSet.elementHandleList = mReceivedElementHandles;
+    mReceivedElementHandles.clear();
+}
+
+//!
+//! \brief SetManager::updateExpectedDownloads
+//! \The download metadata expects every Element of the Set, update it with the Elements whose
+//! \node was received
+void SetManager::updateExpectedDownloads()
+{
+    auto appData = TransferMetaDataContainer::getAppDataById(mCurrentAppDataId);
+    if (appData)
+    {
+        appData->setInitialTransfers(mCurrentSet.elementHandleList.size());
+    }
+}
+
 void SetManager::reset()
 {
     mSetManagerState = SetManagerState::INIT;
     mCurrentSet.reset();
+    mPendingElementNodeRequests.clear();
+    mReceivedElementHandles.clear();
+    mElementNodeRequestsInFlight = 0;
+    mElementNodeRequestsGeneration++;
     mCurrentElementHandleList.clear();
     mCurrentDownloadPath = QString::fromUtf8("");
+    mCurrentAppDataId = TransferMetaData::INVALID_ID;
     mCurrentImportParentNode = nullptr;
     mFailedDownloadedElements.clear();
     mSucceededDownloadedElements.clear();
@@ -797,6 +914,7 @@ void SetManager::startDownload(QQueue<WrappedNode>& nodes, const QString& localP
 
     MegaDownloader::DownloadInfo info;
     info.appId = getAppDataId();
+    info.setInitialTransfers = false;
     info.checkLocalSpace = false;
     info.downloadQueue = nodes;
     info.path = localPath + QDir::separator();
@@ -93,13 +93,19 @@ private:
     bool handleFetchPublicSetResponseToDownloadFromLink();
     bool handleFetchPublicSetResponseToDownloadCollection();
     bool handleFetchPublicSetResponseToImportCollection();
-    void handleGetPreviewElementNodeResponse(mega::MegaRequest* request, mega::MegaError* error);
+    void handleGetPreviewElementNodeResponse(mega::MegaRequest* request,
+                                             mega::MegaError* error,
+                                             unsigned long long generation);
     void handleCreateFolderResponse(mega::MegaRequest* request, mega::MegaError* error);
     void handleCopyNodeResponse(mega::MegaRequest* request, mega::MegaError* error);
 
     bool createDirectory(const QString& path);
     bool getPreviewSetData();
     bool getPreviewElementNodes();
+    void requestNextPreviewElementNodes();
+    bool allPreviewElementNodesReceived() const;
+    void finishPreviewElementNodes();
+    void updateExpectedDownloads();
     AlbumCollection filterSet(const AlbumCollection& srcSet, const QList<mega::MegaHandle>& elementHandleList);
     void reset();
     void resetAndHandleStates();
@@ -116,9 +122,17 @@ private:
     std::shared_ptr<mega::QTMegaRequestListener> mDelegateListener;
 
     AlbumCollection mCurrentSet;
+    // Element nodes are requested with a sliding window, so big Sets don't flood the SDK
+    QQueue<mega::MegaHandle> mPendingElementNodeRequests;
+    QList<mega::MegaHandle> mReceivedElementHandles;
+    int mElementNodeRequestsInFlight;
+    // Increased for each Set, so the responses to the requests of a previous one are dropped
+    unsigned long long mElementNodeRequestsGeneration;
     QList<mega::MegaHandle> mCurrentElementHandleList;
     int mDownloadedCounter;
     QString mCurrentDownloadPath;
+    // All the download batches of a Set share the metadata, so there is a single notification
+    unsigned long long mCurrentAppDataId;
     MegaNodeSPtr mCurrentImportParentNode;
 
     QStringList mFailedDownloadedElements;
@@ -0,0 +1,159 @@
+#include "StartupProfiler.h"
+
+#include "megaapi.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+
+const QString StartupProfiler::TRAY_SHOWN_MILESTONE = QLatin1String("trayShown");
+const QString StartupProfiler::CRITICAL_PATH_MILESTONE = QLatin1String("criticalPathFinished");
+const QString StartupProfiler::DEFERRED_TASKS_MILESTONE = QLatin1String("deferredTasksFinished");
+
+StartupProfiler::StartupProfiler():
+    mCriticalPathFinished(false),
+    mFinished(false)
+{
+    mTimer.start();
+
+    // A zero timer fires when the event loop has processed the pending events
+    mIdleTimer.setInterval(0);
+    connect(&mIdleTimer, &QTimer::timeout, this, &StartupProfiler::runNextTask);
+}
+
+std::shared_ptr<StartupProfiler> StartupProfiler::instance()
+{
+    static std::shared_ptr<StartupProfiler> profiler(new StartupProfiler());
+    return profiler;
+}
+
+void StartupProfiler::startStage(const QString& name)
+{
+    // Only the first startup is traced, not the ones after a logout
+    if (mCriticalPathFinished)
+    {
+        return;
+    }
+
+    finishStage();
+
+    Stage stage;
+    stage.name = name;
+    stage.startMs = mTimer.elapsed();
+    mStages.append(stage);
+}
+
+void StartupProfiler::finishStage()
+{
+    if (!mStages.isEmpty() && mStages.last().durationMs < 0)
+    {
+        mStages.last().durationMs = mTimer.elapsed() - mStages.last().startMs;
+    }
+}
+
+void StartupProfiler::addMilestone(const QString& name)
+{
+    mMilestones.append(qMakePair(name, mTimer.elapsed()));
+}
+
+std::optional<qint64> StartupProfiler::getMilestone(const QString& name) const
+{
+    for (const auto& milestone: mMilestones)
+    {
+        if (milestone.first == name)
+        {
+            return milestone.second;
+        }
+    }
+    return std::nullopt;
+}
+
+void StartupProfiler::deferToIdle(const QString& name, std::function<void()> task)
+{
+    mTasks.enqueue({name, std::move(task)});
+    if (mCriticalPathFinished && !mIdleTimer.isActive())
+    {
+        mIdleTimer.start();
+    }
+}
+
+void StartupProfiler::finishCriticalPath()
+{
+    if (mCriticalPathFinished)
+    {
+        return;
+    }
+
+    finishStage();
+    addMilestone(CRITICAL_PATH_MILESTONE);
+    mCriticalPathFinished = true;
+    mIdleTimer.start();
+}
+
+bool StartupProfiler::isFinished() const
+{
+    return mFinished;
+}
+
+QList<StartupProfiler::Stage> StartupProfiler::getStages() const
+{
+    return mStages;
+}
+
+QJsonObject StartupProfiler::toJson() const
+{
+    QJsonArray stages;
+    for (const auto& stage: mStages)
+    {
+        QJsonObject stageObject;
+        stageObject.insert(QLatin1String("name"), stage.name);
+        stageObject.insert(QLatin1String("startMs"), stage.startMs);
+        stageObject.insert(QLatin1String("durationMs"), stage.durationMs);
+        stageObject.insert(QLatin1String("deferred"), stage.deferred);
+        stages.append(stageObject);
+    }
+
+    QJsonObject milestones;
+    for (const auto& milestone: mMilestones)
+    {
+        milestones.insert(milestone.first, milestone.second);
+    }
+
+    QJsonObject trace;
+    trace.insert(QLatin1String("stages"), stages);
+    trace.insert(QLatin1String("milestones"), milestones);
+    return trace;
+}
+
+void StartupProfiler::runNextTask()
+{
+    if (mTasks.isEmpty())
+    {
+        mIdleTimer.stop();
+
+        if (!mFinished)
+        {
+            mFinished = true;
+            addMilestone(DEFERRED_TASKS_MILESTONE);
+            mega::MegaApi::log(
+                mega::MegaApi::LOG_LEVEL_INFO,
+                QString::fromUtf8("Startup trace: %1")
+                    .arg(QString::fromUtf8(QJsonDocument(toJson()).toJson(QJsonDocument::Compact)))
+                    .toUtf8()
+                    .constData());
+            emit finished();
+        }
+        return;
+    }
+
+    auto task(mTasks.dequeue());
+
+    Stage stage;
+    stage.name = task.name;
+    stage.startMs = mTimer.elapsed();
+    stage.deferred = true;
+
+    task.function();
+
+    stage.durationMs = mTimer.elapsed() - stage.startMs;
+    mStages.append(stage);
+}
@@ -0,0 +1,83 @@
+#ifndef STARTUP_PROFILER_H
+#define STARTUP_PROFILER_H
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QQueue>
+#include <QString>
+#include <QTimer>
+
+#include <functional>
+#include <memory>
+#include <optional>
+
+/// Responsibility: records the wall time of each stage of the app startup, and runs the startup
+/// work that is not needed for the tray icon to be usable once the critical path is done. Deferred
+/// tasks run one per event loop iteration, so user input is served between them. When the first
+/// batch of them is done the trace is logged.
+/// Only used from the GUI thread.
+class StartupProfiler: public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Stage
+    {
+        QString name;
+        qint64 startMs = 0;
+        qint64 durationMs = -1;
+        bool deferred = false;
+    };
+
+    static std::shared_ptr<StartupProfiler> instance();
+
+    StartupProfiler(const StartupProfiler&) = delete;
+    StartupProfiler& operator=(const StartupProfiler&) = delete;
+
+    // Finishes the current stage, if any, and starts a new one
+    void startStage(const QString& name);
+    void finishStage();
+
+    // Points of the startup, in milliseconds since the profiler was created
+    void addMilestone(const QString& name);
+    std::optional<qint64> getMilestone(const QString& name) const;
+
+    // The task runs in an event loop iteration of its own, once the critical path is done
+    void deferToIdle(const QString& name, std::function<void()> task);
+    void finishCriticalPath();
+    bool isFinished() const;
+
+    QList<Stage> getStages() const;
+    QJsonObject toJson() const;
+
+    static const QString TRAY_SHOWN_MILESTONE;
+    static const QString CRITICAL_PATH_MILESTONE;
+    static const QString DEFERRED_TASKS_MILESTONE;
+
+signals:
+    void finished();
+
+private slots:
+    void runNextTask();
+
+private:
+    explicit StartupProfiler();
+
+    struct Task
+    {
+        QString name;
+        std::function<void()> function;
+    };
+
+    QElapsedTimer mTimer;
+    QList<Stage> mStages;
+    QList<QPair<QString, qint64>> mMilestones;
+    QQueue<Task> mTasks;
+    QTimer mIdleTimer;
+    bool mCriticalPathFinished;
+    bool mFinished;
+};
+
+#endif // STARTUP_PROFILER_H
@@ -0,0 +1,221 @@
+#include "ThroughputEstimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Estimations are capped, so they can always be converted to seconds
+constexpr double MAXIMUM_ESTIMATE_SECONDS{1e12};
+}
+
+ThroughputEstimator::ThroughputEstimator()
+{
+    reset();
+}
+
+void ThroughputEstimator::addRateSample(std::chrono::milliseconds timestamp, double rate)
+{
+    rate = std::max(rate, 0.0);
+
+    if (rate <= 0.0)
+    {
+        if (!mZeroRateSince.has_value())
+        {
+            mZeroRateSince = timestamp;
+        }
+
+        if (mRegime == Regime::STALLED ||
+            (mRegime != Regime::NO_SAMPLES &&
+             timestamp - mZeroRateSince.value() >= STALL_DETECTION_TIME))
+        {
+            mRegime = Regime::STALLED;
+            mLastRateTimestamp = timestamp;
+            mOutliers = 0;
+            mOutliersSum = 0.0;
+            return;
+        }
+        // Until then, it is taken as a slow sample
+    }
+    else
+    {
+        mZeroRateSince.reset();
+
+        if (mRegime == Regime::STALLED)
+        {
+            restart(timestamp, rate);
+            ++mRegimeChanges;
+            return;
+        }
+    }
+
+    if (mRegime == Regime::NO_SAMPLES)
+    {
+        restart(timestamp, rate);
+        return;
+    }
+
+    const auto elapsed(std::max(timestamp - mLastRateTimestamp, std::chrono::milliseconds(1)));
+    mLastRateTimestamp = timestamp;
+    ++mSamples;
+
+    // The weight depends on the time between samples. While warming up it is the plain average
+    // of the samples, so the first ones do not lag
+    double alpha(1.0 - std::exp(-static_cast<double>(elapsed.count()) /
+                                static_cast<double>(TIME_CONSTANT.count())));
+    alpha = std::max(alpha, 1.0 / static_cast<double>(mSamples));
+
+    double difference(rate - mRate);
+    bool isOutlier(false);
+    if (mSamples > WARM_UP_SAMPLES)
+    {
+        const double threshold(OUTLIER_THRESHOLD * getDeviation());
+        if (std::abs(difference) > threshold)
+        {
+            isOutlier = true;
+            const bool above(difference > 0.0);
+            if (mOutliers == 0 || above != mOutliersAbove)
+            {
+                mOutliers = 0;
+                mOutliersSum = 0.0;
+                mOutliersAbove = above;
+            }
+
+            ++mOutliers;
+            mOutliersSum += rate;
+            if (mOutliers >= REGIME_CHANGE_SAMPLES)
+            {
+                restart(timestamp, mOutliersSum / static_cast<double>(mOutliers));
+                ++mRegimeChanges;
+                return;
+            }
+
+            difference = above ? threshold : -threshold;
+        }
+        else
+        {
+            mOutliers = 0;
+            mOutliersSum = 0.0;
+        }
+    }
+
+    mRate += alpha * difference;
+    // Outliers do not widen the deviation, or a run of them would stop being detected
+    if (!isOutlier)
+    {
+        mVariance = (1.0 - alpha) * (mVariance + alpha * difference * difference);
+    }
+    mRegime = mSamples > WARM_UP_SAMPLES ? Regime::STEADY : Regime::WARMING_UP;
+}
+
+void ThroughputEstimator::addProgressSample(std::chrono::milliseconds timestamp,
+                                            unsigned long long value)
+{
+    if (!mHasProgressSample || value < mCurrentProgressValue)
+    {
+        reset();
+        mHasProgressSample = true;
+        mLastProgressTimestamp = timestamp;
+        mLastProgressValue = value;
+        mCurrentProgressValue = value;
+        return;
+    }
+
+    mCurrentProgressValue = value;
+
+    const auto elapsed(timestamp - mLastProgressTimestamp);
+    if (elapsed < MINIMUM_SAMPLE_INTERVAL)
+    {
+        return;
+    }
+
+    addRateSample(timestamp,
+                  static_cast<double>(value - mLastProgressValue) * 1000.0 /
+                      static_cast<double>(elapsed.count()));
+
+    mLastProgressTimestamp = timestamp;
+    mLastProgressValue = value;
+}
+
+double ThroughputEstimator::getRate() const
+{
+    return mRegime == Regime::NO_SAMPLES || mRegime == Regime::STALLED ? 0.0 : mRate;
+}
+
+double ThroughputEstimator::getDeviation() const
+{
+    return std::max(std::sqrt(mVariance), mRate * MINIMUM_RELATIVE_DEVIATION);
+}
+
+ThroughputEstimator::Regime ThroughputEstimator::getRegime() const
+{
+    return mRegime;
+}
+
+int ThroughputEstimator::getRegimeChanges() const
+{
+    return mRegimeChanges;
+}
+
+std::optional<ThroughputEstimator::Estimate>
+    ThroughputEstimator::getEstimate(unsigned long long remaining) const
+{
+    if (remaining == 0)
+    {
+        return Estimate{std::chrono::seconds(0), std::chrono::seconds(0), std::chrono::seconds(0)};
+    }
+
+    const double rate(getRate());
+    if (rate <= 0.0)
+    {
+        return std::nullopt;
+    }
+
+    const double work(static_cast<double>(remaining));
+    const double fastRate(rate + CONFIDENCE_DEVIATIONS * getDeviation());
+    const double slowRate(
+        std::max(rate - CONFIDENCE_DEVIATIONS * getDeviation(), rate * MINIMUM_RATE_FRACTION));
+
+    return Estimate{toSeconds(work / rate), toSeconds(work / fastRate), toSeconds(work / slowRate)};
+}
+
+std::optional<ThroughputEstimator::Estimate>
+    ThroughputEstimator::getEstimateForTotal(unsigned long long total) const
+{
+    return getEstimate(mCurrentProgressValue >= total ? 0 : total - mCurrentProgressValue);
+}
+
+void ThroughputEstimator::reset()
+{
+    mRate = 0.0;
+    mVariance = 0.0;
+    mRegime = Regime::NO_SAMPLES;
+    mSamples = 0;
+    mRegimeChanges = 0;
+    mLastRateTimestamp = std::chrono::milliseconds(0);
+    mZeroRateSince.reset();
+    mOutliers = 0;
+    mOutliersSum = 0.0;
+    mOutliersAbove = false;
+    mHasProgressSample = false;
+    mLastProgressTimestamp = std::chrono::milliseconds(0);
+    mLastProgressValue = 0;
+    mCurrentProgressValue = 0;
+}
+
+void ThroughputEstimator::restart(std::chrono::milliseconds timestamp, double rate)
+{
+    mRate = rate;
+    mVariance = 0.0;
+    mRegime = Regime::WARMING_UP;
+    mSamples = 1;
+    mLastRateTimestamp = timestamp;
+    mOutliers = 0;
+    mOutliersSum = 0.0;
+}
+
+std::chrono::seconds ThroughputEstimator::toSeconds(double seconds)
+{
+    return std::chrono::seconds(
+        static_cast<long long>(std::ceil(std::min(seconds, MAXIMUM_ESTIMATE_SECONDS))));
+}
@@ -0,0 +1,92 @@
+#ifndef THROUGHPUT_ESTIMATOR_H
+#define THROUGHPUT_ESTIMATOR_H
+
+#include <chrono>
+#include <optional>
+
+/// Responsibility: estimates a throughput (bytes, files or folders per second) and the time left
+/// to complete the remaining work, with bounds. The throughput is an exponentially weighted moving
+/// average whose weight depends on the time between samples. Isolated outliers only move it as if
+/// they were at the outlier threshold, while a run of outliers in the same direction (a bandwidth
+/// limit applied or lifted, quota throttling) is taken as a new regime and the average restarts
+/// from them. A throughput of zero kept for a while is a stall (paused or blocked transfer): there
+/// is no estimation until it resumes, and then it restarts from the new samples.
+/// Samples are given with their own timestamp, so the estimation is deterministic. Adding a sample
+/// is O(1) and does not allocate.
+class ThroughputEstimator
+{
+public:
+    enum class Regime
+    {
+        NO_SAMPLES,
+        WARMING_UP,
+        STEADY,
+        STALLED
+    };
+
+    struct Estimate
+    {
+        std::chrono::seconds remaining;
+        std::chrono::seconds lowerBound;
+        std::chrono::seconds upperBound;
+    };
+
+    ThroughputEstimator();
+
+    // Adds the throughput measured at the given time (the SDK speed of a transfer)
+    void addRateSample(std::chrono::milliseconds timestamp, double rate);
+    // Adds the value reached by a counter at the given time, the rate is computed from the previous
+    // value. If the value goes back, the counter is considered restarted
+    void addProgressSample(std::chrono::milliseconds timestamp, unsigned long long value);
+
+    double getRate() const;
+    double getDeviation() const;
+    Regime getRegime() const;
+    int getRegimeChanges() const;
+    // Time left to do the remaining work, if there is enough data to estimate it
+    std::optional<Estimate> getEstimate(unsigned long long remaining) const;
+    // Same, for a counter fed with addProgressSample
+    std::optional<Estimate> getEstimateForTotal(unsigned long long total) const;
+    void reset();
+
+    // Time the weight of a sample takes to decay to 1/e
+    static constexpr std::chrono::milliseconds TIME_CONSTANT{3000};
+    // Samples averaged before outliers are detected
+    static constexpr int WARM_UP_SAMPLES{3};
+    // Samples further than this (in deviations) from the average are outliers
+    static constexpr double OUTLIER_THRESHOLD{3.0};
+    // The deviation is never taken smaller than this fraction of the average
+    static constexpr double MINIMUM_RELATIVE_DEVIATION{0.1};
+    // Consecutive outliers in the same direction that start a new regime
+    static constexpr int REGIME_CHANGE_SAMPLES{3};
+    static constexpr std::chrono::milliseconds STALL_DETECTION_TIME{2000};
+    // Width of the confidence interval, in deviations
+    static constexpr double CONFIDENCE_DEVIATIONS{2.0};
+    // The slowest rate used for the upper bound, as a fraction of the average, so it stays finite
+    static constexpr double MINIMUM_RATE_FRACTION{0.25};
+    // Counter samples closer than this to the previous one are only used to update the value
+    static constexpr std::chrono::milliseconds MINIMUM_SAMPLE_INTERVAL{250};
+
+private:
+    void restart(std::chrono::milliseconds timestamp, double rate);
+    static std::chrono::seconds toSeconds(double seconds);
+
+    double mRate;
+    double mVariance;
+    Regime mRegime;
+    int mSamples;
+    int mRegimeChanges;
+    std::chrono::milliseconds mLastRateTimestamp;
+    std::optional<std::chrono::milliseconds> mZeroRateSince;
+
+    int mOutliers;
+    double mOutliersSum;
+    bool mOutliersAbove;
+
+    bool mHasProgressSample;
+    std::chrono::milliseconds mLastProgressTimestamp;
+    unsigned long long mLastProgressValue;
+    unsigned long long mCurrentProgressValue;
+};
+
+#endif
@@ -0,0 +1,106 @@
+#include "UniqueNameAllocator.h"
+
+#include "MegaApplication.h"
+
+#include <QDirIterator>
+
+#include <memory>
+
+void UniqueNameAllocator::addLocalFolderNames(const QString& folderPath, bool unescapeNames)
+{
+    QDirIterator filesIt(folderPath,
+                         QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks,
+                         QDirIterator::NoIteratorFlags);
+
+    while (filesIt.hasNext())
+    {
+        filesIt.next();
+
+        if (unescapeNames)
+        {
+            std::unique_ptr<char[]> unescapedName(
+                MegaSyncApp->getMegaApi()->unescapeFsIncompatible(
+                    filesIt.fileName().toUtf8().constData(),
+                    nullptr));
+            reserve(QString::fromUtf8(unescapedName.get()));
+        }
+        else
+        {
+            reserve(filesIt.fileName());
+        }
+    }
+}
+
+void UniqueNameAllocator::addRemoteFolderNames(mega::MegaNode* parentNode, bool unescapeNames)
+{
+    if (!parentNode)
+    {
+        return;
+    }
+
+    std::unique_ptr<mega::MegaNodeList> nodes(MegaSyncApp->getMegaApi()->getChildren(parentNode));
+    for (int index = 0; index < nodes->size(); ++index)
+    {
+        auto node(nodes->get(index));
+        if (unescapeNames)
+        {
+            std::unique_ptr<char[]> unescapedName(
+                MegaSyncApp->getMegaApi()->unescapeFsIncompatible(node->getName(), nullptr));
+            reserve(QString::fromUtf8(unescapedName.get()));
+        }
+        else
+        {
+            reserve(QString::fromUtf8(node->getName()));
+        }
+    }
+}
+
+void UniqueNameAllocator::reserve(const QString& name)
+{
+    mTakenNames.insert(fold(name));
+}
+
+void UniqueNameAllocator::reserve(const QStringList& names)
+{
+    for (const auto& name: names)
+    {
+        reserve(name);
+    }
+}
+
+bool UniqueNameAllocator::isTaken(const QString& name) const
+{
+    return mTakenNames.contains(fold(name));
+}
+
+int UniqueNameAllocator::allocateCounter(const QString& baseName, const QString& suffix)
+{
+    const QString key(fold(baseName) + QChar(0) + fold(suffix));
+    int& counter(mNextCounters[key]);
+    counter = std::max(counter, 1);
+
+    QString candidate(fold(buildName(baseName, counter, suffix)));
+    while (mTakenNames.contains(candidate))
+    {
+        ++counter;
+        candidate = fold(buildName(baseName, counter, suffix));
+    }
+
+    mTakenNames.insert(candidate);
+    return counter++;
+}
+
+QString UniqueNameAllocator::allocate(const QString& baseName, const QString& suffix)
+{
+    return buildName(baseName, allocateCounter(baseName, suffix), suffix);
+}
+
+QString UniqueNameAllocator::buildName(const QString& baseName, int counter, const QString& suffix)
+{
+    return baseName + QString(QLatin1String("(%1)")).arg(counter) + suffix;
+}
+
+QString UniqueNameAllocator::fold(const QString& name)
+{
+    return name.toCaseFolded();
+}
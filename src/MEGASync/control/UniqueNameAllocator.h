@@ -0,0 +1,41 @@
+#ifndef UNIQUENAMEALLOCATOR_H
+#define UNIQUENAMEALLOCATOR_H
+
+#include "megaapi.h"
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+// Hands out "name(n).suffix" style names that do not collide with the contents of a folder.
+// The folder (local or remote) is read only once into a case-folded set, so every allocation
+// is O(1) amortized instead of rescanning the folder for each candidate. Allocated names are
+// reserved, so the same allocator can be reused for a whole batch of renames in one folder.
+class UniqueNameAllocator
+{
+public:
+    UniqueNameAllocator() = default;
+
+    void addLocalFolderNames(const QString& folderPath, bool unescapeNames);
+    void addRemoteFolderNames(mega::MegaNode* parentNode, bool unescapeNames);
+
+    void reserve(const QString& name);
+    void reserve(const QStringList& names);
+    bool isTaken(const QString& name) const;
+
+    // Returns the first free counter for baseName(counter)suffix and reserves that name
+    int allocateCounter(const QString& baseName, const QString& suffix);
+    QString allocate(const QString& baseName, const QString& suffix);
+
+    static QString buildName(const QString& baseName, int counter, const QString& suffix);
+
+private:
+    static QString fold(const QString& name);
+
+    QSet<QString> mTakenNames;
+    // Next counter to try per folded (baseName, suffix), so repeated allocations do not restart at 1
+    QHash<QString, int> mNextCounters;
+};
+
+#endif // UNIQUENAMEALLOCATOR_H
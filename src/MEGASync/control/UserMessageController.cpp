@@ -12,6 +12,12 @@ UserMessageController::UserMessageController(QObject* parent)
     , mUserMessagesModel(std::make_unique<UserMessageModel>(nullptr))
     , mUserMessagesProxyModel(std::make_unique<UserMessageProxyModel>(nullptr))
     , mAllUnseenAlerts(0)
+    // Wait for the shared folders to be decrypted before processing the alerts
+    , mPendingAlertLists(USER_ALERT_PROCESS_DELAY_IN_SECONDS * 1000,
+                         [this](std::vector<std::unique_ptr<mega::MegaUserAlertList>> alertLists)
+                         {
+                             processPendingAlerts(std::move(alertLists));
+                         })
 {
     mUserMessagesProxyModel->setSourceModel(mUserMessagesModel.get());
     mUserMessagesProxyModel->setSortRole(Qt::UserRole); //Role used to sort the model by date.
@@ -77,6 +83,34 @@ void UserMessageController::populateUserAlerts(mega::MegaUserAlertList* alertLis
     emit userAlertsUpdated(alertList);
 }
 
+void UserMessageController::processPendingAlerts(
+    std::vector<std::unique_ptr<mega::MegaUserAlertList>> pendingAlertLists)
+{
+    if (MegaSyncApp->finished())
+    {
+        return;
+    }
+
+    QList<mega::MegaUserAlertList*> alertLists;
+    alertLists.reserve(static_cast<int>(pendingAlertLists.size()));
+    for (const auto& alertList: pendingAlertLists)
+    {
+        alertLists.append(alertList.get());
+    }
+
+    mUserMessagesModel->processAlerts(alertLists);
+    checkUseenNotifications();
+
+    emit userMessagesReceived();
+
+    // Used by DesktopNotifications because the current architecture
+    for (auto alertList: qAsConst(alertLists))
+    {
+        emit userAlertsUpdated(alertList);
+        alertList->clear();
+    }
+}
+
 void UserMessageController::onUserAlertsUpdate(mega::MegaApi* api, mega::MegaUserAlertList* list)
 {
     Q_UNUSED(api)
@@ -88,21 +122,7 @@ void UserMessageController::onUserAlertsUpdate(mega::MegaApi* api, mega::MegaUse
 
     if (list != nullptr)
     {
-        std::shared_ptr<mega::MegaUserAlertList> auxList(list->copy());
-        ThreadPoolSingleton::getInstance()->push(
-            [this, auxList]()
-            {
-                // Sleep and wait for the shared folders to be undecrypted
-                QThread::sleep(USER_ALERT_PROCESS_DELAY_IN_SECONDS);
-
-                Utilities::queueFunctionInAppThread(
-                    [this, auxList]()
-                    {
-                        // Process synchronously if list is provided
-                        populateUserAlerts(auxList.get());
-                        auxList->clear();
-                    });
-            });
+        mPendingAlertLists.add(std::unique_ptr<mega::MegaUserAlertList>(list->copy()));
     }
     else
     {
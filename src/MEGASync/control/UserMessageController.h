@@ -1,6 +1,7 @@
 #ifndef USER_MESSAGE_CONTROLLER_H
 #define USER_MESSAGE_CONTROLLER_H
 
+#include "DelayedBatcher.h"
 #include "megaapi.h"
 #include "QTMegaGlobalListener.h"
 #include "UserMessageModel.h"
@@ -10,6 +11,7 @@
 #include <QAbstractItemModel>
 
 #include <memory>
+#include <vector>
 
 namespace mega
 {
@@ -50,8 +52,12 @@ private:
     std::unique_ptr<UserMessageModel> mUserMessagesModel;
     std::unique_ptr<UserMessageProxyModel> mUserMessagesProxyModel;
     long long mAllUnseenAlerts;
+    // Each alert update waits for the processing delay, and the ones due are applied together
+    DelayedBatcher<std::unique_ptr<mega::MegaUserAlertList>> mPendingAlertLists;
 
     void populateUserAlerts(mega::MegaUserAlertList* alertList);
+    void processPendingAlerts(
+        std::vector<std::unique_ptr<mega::MegaUserAlertList>> pendingAlertLists);
     void checkUseenNotifications();
 
 };
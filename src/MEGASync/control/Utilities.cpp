@@ -2,7 +2,6 @@
 
 // clang-format off
 #include "Platform.h"
-#include "gzjoin.h"
 #include "MegaApiSynchronizedRequest.h"
 #include "MegaApplication.h"
 #include "MoveToMEGABin.h"
@@ -11,7 +10,9 @@
 #include "StatsEventHandler.h"
 #include "EnumConverters.h"
 #include "IconTokenizer.h"
+#include "LogBundleBuilder.h"
 #include "TokenParserWidgetManager.h"
+#include "UniqueNameAllocator.h"
 // clang-format on
 
 #include <QApplication>
@@ -1183,103 +1184,7 @@ QString Utilities::getDefaultBasePath()
 
 QString Utilities::joinLogZipFiles(MegaApi *megaApi, const QDateTime *timestampSince, QString appenHashReference)
 {
-    if (!megaApi)
-    {
-        return QString();
-    }
-
-    QDir logDir{MegaApplication::applicationDataPath().append(QString::fromUtf8("/") + LOGS_FOLDER_LEAFNAME_QSTRING)};
-    if (logDir.exists())
-    {
-        QString fileFormat{
-            QDir::separator() +
-            QString::fromUtf8("%1%2%3").arg(
-                QDateTime::currentDateTimeUtc().toString(QString::fromLatin1("yyMMdd_hhmmss")),
-                megaApi->getMyUser() ?
-                    QString::fromUtf8("_") +
-                        QString::fromUtf8(
-                            std::unique_ptr<MegaUser>(megaApi->getMyUser())->getEmail()) :
-                    QString::fromUtf8(""),
-                !appenHashReference.isEmpty() ? QString::fromUtf8("_") + appenHashReference :
-                                                QString::fromUtf8(""))};
-
-        QFileInfo joinLogsFile(
-            logDir.absolutePath().append(fileFormat).append(QString::fromUtf8(".gz")));
-#ifdef _WIN32
-        FILE * pFile = nullptr;
-        errno_t er = _wfopen_s(&pFile, joinLogsFile.absoluteFilePath().toStdWString().c_str(), L"a+b");
-        if (er)
-        {
-            megaApi->log(MegaApi::LOG_LEVEL_ERROR, QString::fromUtf8("Error opening file for joining log zip files (%1) : %2")
-                         .arg(er).arg(joinLogsFile.filePath()).toUtf8().constData());
-            pFile = nullptr; //just in case
-        }
-
-#else
-        FILE * pFile = fopen(joinLogsFile.absoluteFilePath().toUtf8().constData(), "a+b");
-#endif
-        if (!pFile)
-        {
-            std::cerr << "Error opening file for joining log zip files " << std::endl;
-            megaApi->log(MegaApi::LOG_LEVEL_ERROR, QString::fromUtf8("Error opening file for joining log zip files: %1").arg(joinLogsFile.filePath()).toUtf8().constData());
-            return QString();
-        }
-
-        unsigned long crc, tot;
-        gzinit(&crc, &tot, pFile);
-
-        QFileInfoList logFiles = logDir.entryInfoList(QStringList() << QString::fromUtf8("MEGAsync.[0-9]*.log"), QDir::Files);
-        int nLogFiles = static_cast<int>(logFiles.count());
-
-        std::sort(logFiles.begin(),
-                  logFiles.end(),
-                  [](const QFileInfo& v1, const QFileInfo& v2)
-                  {
-                      return v1.fileName()
-                                 .remove(QRegularExpression(QString::fromUtf8("[^\\d]")))
-                                 .toInt() >
-                             v2.fileName()
-                                 .remove(QRegularExpression(QString::fromUtf8("[^\\d]")))
-                                 .toInt();
-                  });
-
-        foreach (QFileInfo i, logFiles)
-        {
-            --nLogFiles;
-
-            if (timestampSince)
-            {
-                if ( i.lastModified() < *timestampSince && i.fileName() != QString::fromUtf8("MEGAsync.0.log")) //keep at least the last log
-                {
-                    continue;
-                }
-            }
-
-            try
-            {
-#ifdef _WIN32
-                gzcopy(i.absoluteFilePath().toStdWString().c_str(), nLogFiles, &crc, &tot, pFile);
-#else
-                gzcopy(i.absoluteFilePath().toUtf8().constData(), nLogFiles, &crc, &tot, pFile);
-#endif
-            }
-            catch (const std::exception& e)
-            {
-                std::cerr << "Error joining zip files for bug report " << e.what() << std::endl;
-                megaApi->log(MegaApi::LOG_LEVEL_ERROR, QString::fromUtf8("Error joining zip files for bug report : %1")
-                             .arg(QString::fromUtf8(e.what())).toUtf8().constData());
-
-                fclose(pFile);
-                QFile::remove(joinLogsFile.absoluteFilePath());
-                return QString();
-            }
-        }
-
-        fclose(pFile);
-        return joinLogsFile.absoluteFilePath();
-    }
-
-    return QString();
+    return LogBundleBuilder(megaApi).build(timestampSince, appenHashReference);
 }
 
 void Utilities::adjustToScreenFunc(QPoint position, QWidget *what)
@@ -1446,11 +1351,22 @@ void Utilities::getDaysAndHoursToTimestamp(int64_t secsTimestamps, int64_t &rema
 
 QString Utilities::getNonDuplicatedNodeName(MegaNode *node, MegaNode *parentNode, const QString &currentName, bool unescapeName, const QStringList& itemsBeingRenamed)
 {
-    QString newName;
+    UniqueNameAllocator allocator;
+    allocator.addRemoteFolderNames(parentNode, false);
+    allocator.reserve(itemsBeingRenamed);
+
+    return getNonDuplicatedNodeName(node, currentName, unescapeName, allocator);
+}
+
+QString Utilities::getNonDuplicatedNodeName(MegaNode* node,
+                                            const QString& currentName,
+                                            bool unescapeName,
+                                            UniqueNameAllocator& allocator)
+{
     QString nodeName;
     QString suffix;
 
-    if(node->isFile())
+    if(node && node->isFile())
     {
         QFileInfo fileInfo(currentName);
 
@@ -1472,118 +1388,50 @@ QString Utilities::getNonDuplicatedNodeName(MegaNode *node, MegaNode *parentNode
 
     if(unescapeName)
     {
-        nodeName = QString::fromUtf8(
+        std::unique_ptr<char[]> unescapedName(
             MegaSyncApp->getMegaApi()->unescapeFsIncompatible(nodeName.toUtf8().constData(),
                                                               nullptr));
+        nodeName = QString::fromUtf8(unescapedName.get());
     }
 
-    int counter(1);
-    while(newName.isEmpty())
-    {
-        bool nameFound = false;
-        QString suggestedName = nodeName + QString(QLatin1String("(%1)")).arg(QString::number(counter));
-        if(node)
-        {
-            if(node->isFile() && !suffix.isEmpty())
-            {
-                suggestedName.append(suffix);
-            }
-        }
-
-        if(!itemsBeingRenamed.contains(suggestedName, Qt::CaseInsensitive))
-        {
-            std::unique_ptr<MegaNodeList>nodes(MegaSyncApp->getMegaApi()->getChildren(parentNode));
-            for(int index = 0; index < nodes->size(); ++index)
-            {
-                QString nodeName(QString::fromUtf8(nodes->get(index)->getName()));
-                if(suggestedName.compare(nodeName, Qt::CaseInsensitive) == 0)
-                {
-                    nameFound = true;
-                }
-            }
-
-
-            if(!nameFound)
-            {
-                newName = suggestedName;
-            }
-        }
+    return allocator.allocate(nodeName, suffix);
+}
 
-        counter++;
-    }
+QString Utilities::getNonDuplicatedLocalName(const QFileInfo &currentFile, bool unescapeName, const QStringList& itemsBeingRenamed)
+{
+    UniqueNameAllocator allocator;
+    allocator.addLocalFolderNames(currentFile.path(), unescapeName);
+    allocator.reserve(itemsBeingRenamed);
 
-    return newName;
+    return getNonDuplicatedLocalName(currentFile, unescapeName, allocator);
 }
 
-QString Utilities::getNonDuplicatedLocalName(const QFileInfo &currentFile, bool unescapeName, const QStringList& itemsBeingRenamed)
+QString Utilities::getNonDuplicatedLocalName(const QFileInfo& currentFile,
+                                             bool unescapeName,
+                                             UniqueNameAllocator& allocator)
 {
-    QString repeatedName;
     QString suffix = currentFile.completeSuffix();
+    if(!suffix.isEmpty())
+    {
+        suffix.prepend(QLatin1Char('.'));
+    }
 
     QString fileName;
     if(unescapeName)
     {
-        fileName = QString::fromUtf8(MegaSyncApp->getMegaApi()->unescapeFsIncompatible(
+        std::unique_ptr<char[]> unescapedName(MegaSyncApp->getMegaApi()->unescapeFsIncompatible(
             currentFile.baseName().toUtf8().constData(),
             nullptr));
+        fileName = QString::fromUtf8(unescapedName.get());
     }
     else
     {
         fileName = currentFile.baseName();
     }
 
-    QDirIterator filesIt(currentFile.path(), QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks, QDirIterator::NoIteratorFlags);
-
-    int counter(0);
-    bool notFound(true);
-    do
-    {
-        notFound = true;
-        counter++;
-
-        QString suggestedName = fileName + QString(QLatin1String("(%1)")).arg(QString::number(counter));
-        if(!suffix.isEmpty())
-        {
-            suggestedName += QString(QLatin1String(".%1")).arg(suffix);
-        }
-
-        if(!itemsBeingRenamed.contains(suggestedName))
-        {
-            while (filesIt.hasNext())
-            {
-                QString checkFileName;
-
-                if(unescapeName)
-                {
-                    checkFileName =
-                        QString::fromUtf8(MegaSyncApp->getMegaApi()->unescapeFsIncompatible(
-                            filesIt.fileName().toUtf8().constData(),
-                            nullptr));
-                }
-                else
-                {
-                    checkFileName = filesIt.fileName();
-                }
-
-                if (checkFileName.compare(suggestedName, Qt::CaseInsensitive) == 0)
-                {
-                    notFound = false;
-                    break;
-                }
-
-                filesIt.next();
-            }
-        }
-
-    } while(!notFound);
-
-    repeatedName = currentFile.baseName() + QString(QLatin1String("(%1)")).arg(QString::number(counter));
-    if(!suffix.isEmpty())
-    {
-        repeatedName += QString(QLatin1String(".%1")).arg(suffix);
-    }
-
-    return repeatedName;
+    // The folder contents are compared unescaped, but the new name keeps the on-disk base name
+    auto counter(allocator.allocateCounter(fileName, suffix));
+    return UniqueNameAllocator::buildName(currentFile.baseName(), counter, suffix);
 }
 
 QPair<QString, QString> Utilities::getFilenameBasenameAndSuffix(const QString& fileName)
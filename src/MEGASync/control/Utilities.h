@@ -25,6 +25,8 @@
 
 #include <functional>
 
+class UniqueNameAllocator;
+
 #ifdef __APPLE__
 #define MEGA_SET_PERMISSIONS \
 chmod("/Applications/MEGAsync.app/Contents/MacOS/MEGAsync", \
@@ -443,6 +445,14 @@ public:
 
     static QString getNonDuplicatedNodeName(mega::MegaNode* node, mega::MegaNode* parentNode, const QString& currentName, bool unescapeName, const QStringList &itemsBeingRenamed);
     static QString getNonDuplicatedLocalName(const QFileInfo& currentFile, bool unescapeName, const QStringList &itemsBeingRenamed);
+    // Batch variants: the allocator keeps the folder contents and the names already handed out
+    static QString getNonDuplicatedNodeName(mega::MegaNode* node,
+                                            const QString& currentName,
+                                            bool unescapeName,
+                                            UniqueNameAllocator& allocator);
+    static QString getNonDuplicatedLocalName(const QFileInfo& currentFile,
+                                             bool unescapeName,
+                                             UniqueNameAllocator& allocator);
     static QPair<QString, QString> getFilenameBasenameAndSuffix(const QString& fileName);
 
     static void upgradeClicked();
@@ -6,6 +6,7 @@ set(DESKTOP_APP_CONTROL_HEADERS
     ${CMAKE_CURRENT_LIST_DIR}/AsyncHandler.h
     ${CMAKE_CURRENT_LIST_DIR}/ConnectivityChecker.h
     ${CMAKE_CURRENT_LIST_DIR}/CrashHandler.h
+    ${CMAKE_CURRENT_LIST_DIR}/DelayedBatcher.h
     ${CMAKE_CURRENT_LIST_DIR}/DialogOpener.h
     ${CMAKE_CURRENT_LIST_DIR}/DownloadQueueController.h
     ${CMAKE_CURRENT_LIST_DIR}/EmailRequester.h
@@ -14,8 +15,12 @@ set(DESKTOP_APP_CONTROL_HEADERS
     ${CMAKE_CURRENT_LIST_DIR}/ExportProcessor.h
     ${CMAKE_CURRENT_LIST_DIR}/FileFolderAttributes.h
     ${CMAKE_CURRENT_LIST_DIR}/FatalEventHandler.h
+    ${CMAKE_CURRENT_LIST_DIR}/FolderInfoRequests.h
+    ${CMAKE_CURRENT_LIST_DIR}/HTTPRequestParser.h
     ${CMAKE_CURRENT_LIST_DIR}/HTTPServer.h
+    ${CMAKE_CURRENT_LIST_DIR}/ImageCache.h
     ${CMAKE_CURRENT_LIST_DIR}/ImageDownloader.h
+    ${CMAKE_CURRENT_LIST_DIR}/FolderLinkApiPool.h
     ${CMAKE_CURRENT_LIST_DIR}/IntervalExecutioner.h
     ${CMAKE_CURRENT_LIST_DIR}/LinkProcessor.h
     ${CMAKE_CURRENT_LIST_DIR}/LinkObject.h
@@ -23,11 +28,13 @@ set(DESKTOP_APP_CONTROL_HEADERS
     ${CMAKE_CURRENT_LIST_DIR}/MegaDownloader.h
     ${CMAKE_CURRENT_LIST_DIR}/MegaSyncLogger.h
     ${CMAKE_CURRENT_LIST_DIR}/MegaUploader.h
+    ${CMAKE_CURRENT_LIST_DIR}/StartupProfiler.h
     ${CMAKE_CURRENT_LIST_DIR}/TextDecorator.h
     ${CMAKE_CURRENT_LIST_DIR}/ThreadPool.h
+    ${CMAKE_CURRENT_LIST_DIR}/ThroughputEstimator.h
     ${CMAKE_CURRENT_LIST_DIR}/TransferBatch.h
-    ${CMAKE_CURRENT_LIST_DIR}/TransferRemainingTime.h
     ${CMAKE_CURRENT_LIST_DIR}/QtMetaEnumUtils.h
+    ${CMAKE_CURRENT_LIST_DIR}/UniqueNameAllocator.h
     ${CMAKE_CURRENT_LIST_DIR}/UpdateTask.h
     ${CMAKE_CURRENT_LIST_DIR}/UserAttributesManager.h
     ${CMAKE_CURRENT_LIST_DIR}/RequestListenerManager.h
@@ -35,7 +42,6 @@ set(DESKTOP_APP_CONTROL_HEADERS
     ${CMAKE_CURRENT_LIST_DIR}/SetTypes.h
     ${CMAKE_CURRENT_LIST_DIR}/Utilities.h
     ${CMAKE_CURRENT_LIST_DIR}/Version.h
-    ${CMAKE_CURRENT_LIST_DIR}/gzjoin.h
     ${CMAKE_CURRENT_LIST_DIR}/qrcodegen.h
     ${CMAKE_CURRENT_LIST_DIR}/MegaApiSynchronizedRequest.h
     ${CMAKE_CURRENT_LIST_DIR}/MergeMEGAFolders.h
@@ -71,8 +77,12 @@ set(DESKTOP_APP_CONTROL_SOURCES
     ${CMAKE_CURRENT_LIST_DIR}/ExportProcessor.cpp
     ${CMAKE_CURRENT_LIST_DIR}/FileFolderAttributes.cpp
     ${CMAKE_CURRENT_LIST_DIR}/FatalEventHandler.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/FolderInfoRequests.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/HTTPRequestParser.cpp
     ${CMAKE_CURRENT_LIST_DIR}/HTTPServer.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/ImageCache.cpp
     ${CMAKE_CURRENT_LIST_DIR}/ImageDownloader.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/FolderLinkApiPool.cpp
     ${CMAKE_CURRENT_LIST_DIR}/IntervalExecutioner.cpp
     ${CMAKE_CURRENT_LIST_DIR}/LinkProcessor.cpp
     ${CMAKE_CURRENT_LIST_DIR}/LinkObject.cpp
@@ -82,10 +92,12 @@ set(DESKTOP_APP_CONTROL_SOURCES
     ${CMAKE_CURRENT_LIST_DIR}/MegaUploader.cpp
     ${CMAKE_CURRENT_LIST_DIR}/RequestListenerManager.cpp
     ${CMAKE_CURRENT_LIST_DIR}/SetManager.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/StartupProfiler.cpp
     ${CMAKE_CURRENT_LIST_DIR}/TextDecorator.cpp
     ${CMAKE_CURRENT_LIST_DIR}/ThreadPool.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/ThroughputEstimator.cpp
     ${CMAKE_CURRENT_LIST_DIR}/TransferBatch.cpp
-    ${CMAKE_CURRENT_LIST_DIR}/TransferRemainingTime.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/UniqueNameAllocator.cpp
     ${CMAKE_CURRENT_LIST_DIR}/UpdateTask.cpp
     ${CMAKE_CURRENT_LIST_DIR}/UserAttributesManager.cpp
     ${CMAKE_CURRENT_LIST_DIR}/Utilities.cpp
@@ -102,6 +114,8 @@ set(DESKTOP_APP_CONTROL_SOURCES
     ${CMAKE_CURRENT_LIST_DIR}/BugReport/BugReportController.h
     ${CMAKE_CURRENT_LIST_DIR}/BugReport/BugReportController.cpp
     ${CMAKE_CURRENT_LIST_DIR}/BugReport/BugReportData.h
+    ${CMAKE_CURRENT_LIST_DIR}/BugReport/LogBundleBuilder.h
+    ${CMAKE_CURRENT_LIST_DIR}/BugReport/LogBundleBuilder.cpp
     ${CMAKE_CURRENT_LIST_DIR}/ReloadingEventHandler.cpp
     ${CMAKE_CURRENT_LIST_DIR}/UsersUpdateListener.cpp
     ${CMAKE_CURRENT_LIST_DIR}/ServiceUrls.cpp
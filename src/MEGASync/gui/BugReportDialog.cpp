@@ -44,6 +44,11 @@ BugReportDialog::BugReportDialog(QWidget* parent, MegaSyncLogger& logger):
             this,
             &BugReportDialog::onReportUpdated);
 
+    connect(mController.get(),
+            &BugReportController::reportLogPackagingUpdated,
+            this,
+            &BugReportDialog::onReportLogPackagingUpdated);
+
     connect(mController.get(),
             &BugReportController::reportUploadFinished,
             this,
@@ -117,6 +122,27 @@ void BugReportDialog::onReportUpdated(int value)
     }
 }
 
+void BugReportDialog::onReportLogPackagingUpdated(int value)
+{
+    openProgressDialog();
+
+    if (mProgressIndicatorDialog)
+    {
+        // The same bar is reused for the upload once the log files are packaged
+        if (value < LogBundleBuilder::MAXIMUM_PERMIL)
+        {
+            mProgressIndicatorDialog->setDialogDescription(tr("Preparing log files"));
+            mProgressIndicatorDialog->setProgressBarValue(value);
+        }
+        else
+        {
+            mProgressIndicatorDialog->setDialogDescription(
+                tr("Bug report is uploading, it may take a few minutes"));
+            mProgressIndicatorDialog->setProgressBarValue(0);
+        }
+    }
+}
+
 void BugReportDialog::closeProgressDialog()
 {
     if (mProgressIndicatorDialog)
@@ -32,6 +32,7 @@ private slots:
     void onReportUploadedFinished();
 
     void onReportUpdated(int value);
+    void onReportLogPackagingUpdated(int value);
 
 private:
     bool isDescriptionValid() const;
@@ -14,6 +14,8 @@
 #include "SyncInfo.h"
 #include "syncs/control/MegaIgnoreManager.h"
 
+#include <QSet>
+
 #include <set>
 
 namespace
@@ -26,6 +28,8 @@ DeviceCentre::DeviceCentre(QObject* parent):
     QMLComponent(parent),
     mMegaApi(MegaSyncApp->getMegaApi()),
     mSyncModel(new SyncModel(this)),
+    mBackupInfoInFlight(false),
+    mBackupInfoPending(false),
     mDeviceModel(new DeviceModel(this))
 {
     registerQmlModules();
@@ -43,7 +47,7 @@ DeviceCentre::DeviceCentre(QObject* parent):
             this,
             [this]()
             {
-                mMegaApi->getBackupInfo();
+                requestBackupInfo();
             });
     SyncInfo::instance()->dismissUnattendedDisabledSyncs(
         {mega::MegaSync::SyncType::TYPE_BACKUP, mega::MegaSync::SyncType::TYPE_TWOWAY});
@@ -64,6 +68,16 @@ void DeviceCentre::onRequestFinish(mega::MegaApi* api,
                                request->getType() == mega::MegaRequest::TYPE_ADD_SYNC ||
                                request->getType() == mega::MegaRequest::TYPE_REMOVE_SYNC;
 
+    if (request->getType() == mega::MegaRequest::TYPE_BACKUP_INFO)
+    {
+        mBackupInfoInFlight = false;
+        if (mBackupInfoPending)
+        {
+            mBackupInfoPending = false;
+            scheduleBackupInfo();
+        }
+    }
+
     if (e->getErrorCode() == mega::MegaError::API_OK)
     {
         // Receiving device name
@@ -89,7 +103,7 @@ void DeviceCentre::onRequestFinish(mega::MegaApi* api,
             updateLocalData(*backupList);
             if (mSyncModel->hasUpdatingStatus())
             {
-                mSizeInfoTimer.start();
+                scheduleBackupInfo();
             }
             emit deviceDataUpdated();
         }
@@ -98,7 +112,7 @@ void DeviceCentre::onRequestFinish(mega::MegaApi* api,
             const QmlSyncData syncObject(request, mMegaApi);
             mSyncModel->addOrUpdate(syncObject);
 
-            mMegaApi->getBackupInfo();
+            requestBackupInfo();
             emit deviceDataUpdated();
         }
         else if (request->getType() == mega::MegaRequest::TYPE_REMOVE_SYNC)
@@ -139,7 +153,14 @@ void DeviceCentre::onSyncStatsUpdated(mega::MegaApi*, mega::MegaSyncStats* syncS
     }
     else
     {
-        mMegaApi->getBackupInfo();
+        // The status is known locally, only the size and the date need the server
+        auto syncSettings = SyncInfo::instance()->getSyncSettingByTag(syncStats->getBackupId());
+        if (syncSettings && syncSettings->getSync())
+        {
+            updateLocalData(QmlSyncData(syncSettings->getSync()));
+        }
+
+        scheduleBackupInfo();
     }
 }
 
@@ -196,7 +217,7 @@ void DeviceCentre::retrieveDeviceData(const QString& deviceId)
 {
     mDeviceIdFromLastRequest = deviceId;
     mMegaApi->getDeviceName(deviceId.toLatin1().constData());
-    mMegaApi->getBackupInfo();
+    requestBackupInfo();
 }
 
 QString DeviceCentre::getSizeString(long long bytes) const
@@ -227,6 +248,32 @@ void DeviceCentre::updateLocalData(const QmlSyncData& syncObj)
     emit deviceDataUpdated();
 }
 
+void DeviceCentre::requestBackupInfo()
+{
+    if (mBackupInfoInFlight)
+    {
+        mBackupInfoPending = true;
+        return;
+    }
+
+    mSizeInfoTimer.stop();
+    mBackupInfoInFlight = true;
+    mMegaApi->getBackupInfo();
+}
+
+void DeviceCentre::scheduleBackupInfo()
+{
+    // Trailing edge: the updates received until the timer expires are served by one request
+    if (mBackupInfoInFlight)
+    {
+        mBackupInfoPending = true;
+    }
+    else if (!mSizeInfoTimer.isActive())
+    {
+        mSizeInfoTimer.start();
+    }
+}
+
 void DeviceCentre::updateDeviceData()
 {
     mCachedDeviceData.folderCount = mSyncModel->rowCount();
@@ -237,7 +284,14 @@ void DeviceCentre::updateDeviceData()
 DeviceCentre::BackupList DeviceCentre::filterBackupList(const char* deviceId,
                                                         const mega::MegaBackupInfoList& backupList)
 {
-    auto activeSyncs = SyncInfo::instance()->getAllSyncSettings();
+    const auto activeSyncs = SyncInfo::instance()->getAllSyncSettings();
+    QSet<mega::MegaHandle> activeSyncIds;
+    activeSyncIds.reserve(activeSyncs.size());
+    for (const auto& sync: activeSyncs)
+    {
+        activeSyncIds.insert(sync->backupId());
+    }
+
     BackupList filteredList;
     const auto numBackups = backupList.size();
     for (uint backupIndex = 0; backupIndex < numBackups; backupIndex++)
@@ -245,14 +299,7 @@ DeviceCentre::BackupList DeviceCentre::filterBackupList(const char* deviceId,
         auto backupInfo = backupList.get(backupIndex);
         if (strcmp(backupInfo->deviceId(), deviceId) == 0)
         {
-            bool isSyncActive = std::find_if(std::begin(activeSyncs),
-                                             std::end(activeSyncs),
-                                             [&backupInfo](std::shared_ptr<SyncSettings> sync)
-                                             {
-                                                 return sync->backupId() == backupInfo->id();
-                                             }) != std::end(activeSyncs);
-
-            if (isSyncActive)
+            if (activeSyncIds.contains(backupInfo->id()))
             {
                 filteredList.push_back(backupInfo);
             }
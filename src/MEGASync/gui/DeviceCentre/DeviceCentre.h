@@ -68,6 +68,8 @@ private:
     void updateLocalData(const QmlSyncData& syncObj);
     void updateDeviceData();
     void requestDeviceNames(const mega::MegaBackupInfoList& backupList) const;
+    void requestBackupInfo();
+    void scheduleBackupInfo();
 
     void changeSyncStatus(int row, std::function<void(std::shared_ptr<SyncSettings>)> action) const;
 
@@ -78,6 +80,10 @@ private:
     std::unique_ptr<mega::QTMegaListener> mDelegateListener;
     QString mDeviceIdFromLastRequest;
     QTimer mSizeInfoTimer;
+    // Only one backup info request is sent at a time. Refreshes asked for while it is in flight
+    // are merged into a single one, sent once it finishes
+    bool mBackupInfoInFlight;
+    bool mBackupInfoPending;
 
     DeviceData mCachedDeviceData;
     DeviceModel* mDeviceModel;
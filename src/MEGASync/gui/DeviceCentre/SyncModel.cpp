@@ -10,7 +10,9 @@
 #include <memory>
 
 SyncModel::SyncModel(QObject* parent):
-    QAbstractListModel(parent)
+    QAbstractListModel(parent),
+    mTotalSize(0),
+    mStatusCount{}
 {
     connect(SyncInfo::instance(),
             &SyncInfo::syncRemoteRootChanged,
@@ -36,7 +38,9 @@ QHash<int, QByteArray> SyncModel::roleNames() const
 void SyncModel::add(const QmlSyncData& newSync)
 {
     beginInsertRows(QModelIndex(), rowCount(), rowCount());
+    mRowsByHandle.insert(newSync.syncID, rowCount());
     mSyncObjects.append(newSync);
+    addToAggregates(newSync);
     endInsertRows();
 }
 
@@ -49,7 +53,10 @@ void SyncModel::addOrUpdate(const QmlSyncData& newSync)
     }
     else
     {
-        mSyncObjects[row.value()].updateFields(newSync);
+        auto& sync = mSyncObjects[row.value()];
+        removeFromAggregates(sync);
+        sync.updateFields(newSync);
+        addToAggregates(sync);
         const QModelIndex modelIndex = QAbstractListModel::index(row.value());
         emit dataChanged(modelIndex, modelIndex);
     }
@@ -64,7 +71,15 @@ void SyncModel::remove(mega::MegaHandle handle)
     if (row.has_value())
     {
         beginRemoveRows(QModelIndex(), row.value(), row.value());
+        removeFromAggregates(mSyncObjects.at(row.value()));
         mSyncObjects.removeAt(row.value());
+
+        // Only the rows after the removed one move
+        mRowsByHandle.remove(handle);
+        for (int nextRow = row.value(); nextRow < mSyncObjects.size(); ++nextRow)
+        {
+            mRowsByHandle[mSyncObjects.at(nextRow).syncID] = nextRow;
+        }
         endRemoveRows();
     }
 }
@@ -72,51 +87,60 @@ void SyncModel::remove(mega::MegaHandle handle)
 void SyncModel::clear()
 {
     mSyncObjects.clear();
+    mRowsByHandle.clear();
+    mTotalSize = 0;
+    mStatusCount.fill(0);
 }
 
 std::optional<int> SyncModel::findRowByHandle(mega::MegaHandle handle) const
 {
-    auto finder = [handle](const QmlSyncData& obj)
-    {
-        return obj.syncID == handle;
-    };
-    auto itSyncObj = std::find_if(mSyncObjects.begin(), mSyncObjects.end(), finder);
-    if (itSyncObj != mSyncObjects.end())
+    auto rowIt = mRowsByHandle.constFind(handle);
+    if (rowIt != mRowsByHandle.constEnd())
     {
-        return std::distance(mSyncObjects.begin(), itSyncObj);
+        return rowIt.value();
     }
     return std::nullopt;
 }
 
+void SyncModel::addToAggregates(const QmlSyncData& sync)
+{
+    mTotalSize += sync.size;
+    ++mStatusCount[sync.status];
+}
+
+void SyncModel::removeFromAggregates(const QmlSyncData& sync)
+{
+    mTotalSize -= sync.size;
+    --mStatusCount[sync.status];
+}
+
 SyncStatus::Value SyncModel::computeDeviceStatus() const
 {
-    SyncStatus::Value deviceStatus = SyncStatus::UP_TO_DATE;
-    for (const auto& sync: mSyncObjects)
+    // The worst status of any sync
+    for (int status = SyncStatus::STOPPED; status > SyncStatus::UP_TO_DATE; --status)
     {
-        const SyncStatus::Value currentStatus = sync.status;
-        if (deviceStatus < currentStatus)
+        if (mStatusCount[status] > 0)
         {
-            deviceStatus = currentStatus;
+            return static_cast<SyncStatus::Value>(status);
         }
     }
-    return deviceStatus;
+    return SyncStatus::UP_TO_DATE;
 }
 
 qint64 SyncModel::computeTotalSize() const
 {
-    const qint64 startValue = 0;
-    auto accumulator = [](qint64 total, const auto& sync) {
-        return total + sync.size;
-    };
-    return std::accumulate(mSyncObjects.begin(), mSyncObjects.end(), startValue, accumulator);
+    return mTotalSize;
 }
 
 void SyncModel::setStatus(mega::MegaHandle handle, const SyncStatus::Value status)
 {
     auto row = findRowByHandle(handle);
-    if (!row.has_value())
+    if (row.has_value())
     {
-        mSyncObjects[row.value()].status = status;
+        auto& sync = mSyncObjects[row.value()];
+        removeFromAggregates(sync);
+        sync.status = status;
+        addToAggregates(sync);
 
         const QModelIndex modelIndex = index(row.value());
         emit dataChanged(modelIndex, modelIndex);
@@ -125,10 +149,7 @@ void SyncModel::setStatus(mega::MegaHandle handle, const SyncStatus::Value statu
 
 bool SyncModel::hasUpdatingStatus() const
 {
-    auto finder = [](const QmlSyncData& obj) {
-        return obj.status == SyncStatus::UPDATING;
-    };
-    return std::any_of(mSyncObjects.begin(), mSyncObjects.end(), finder);
+    return mStatusCount[SyncStatus::UPDATING] > 0;
 }
 
 int SyncModel::rowCount(const QModelIndex& parent) const
@@ -288,7 +309,7 @@ QString SyncModel::getRemoteFolder(int row) const
 void SyncModel::onSyncRootChanged(std::shared_ptr<SyncSettings> syncSettings)
 {
     auto row(findRowByHandle(syncSettings->backupId()));
-    if (row >= 0)
+    if (row.has_value())
     {
         const QModelIndex modelIndex = QAbstractListModel::index(row.value());
         emit dataChanged(modelIndex, modelIndex, QVector<int>() << SyncModelRole::REMOTE_PATH);
@@ -5,7 +5,9 @@
 #include "QmlSyncData.h"
 
 #include <QAbstractListModel>
+#include <QHash>
 
+#include <array>
 #include <memory>
 #include <optional>
 
@@ -60,8 +62,15 @@ private:
     SyncStatus::Value getStatus(int row) const;
     QString getErrorMessage(int row) const;
     std::optional<int> findRowByHandle(mega::MegaHandle handle) const;
+    void addToAggregates(const QmlSyncData& sync);
+    void removeFromAggregates(const QmlSyncData& sync);
 
     QList<QmlSyncData> mSyncObjects;
+    // Sync id -> row
+    QHash<mega::MegaHandle, int> mRowsByHandle;
+    // Kept up to date on every change, so the device data does not rescan the rows
+    qint64 mTotalSize;
+    std::array<int, SyncStatus::STOPPED + 1> mStatusCount;
 };
 
 #endif // SYNC_MODEL_H
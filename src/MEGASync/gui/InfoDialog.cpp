@@ -674,6 +674,13 @@ void InfoDialog::updateTransfersCount()
 {
     if (auto transferModel = app->getTransfersModel())
     {
+        const auto version(transferModel->getTransfersCountVersion());
+        if (mTransfersCountVersion == version)
+        {
+            return;
+        }
+        mTransfersCountVersion = version;
+
         auto transfersCountUpdated = transferModel->getLastTransfersCount();
         int ongoingTransfers =
             (transfersCountUpdated.totalDownloads != transfersCountUpdated.completedDownloads()) +
@@ -24,6 +24,7 @@
 #include <QTimer>
 
 #include <memory>
+#include <optional>
 #ifdef _WIN32
 #include <chrono>
 #endif
@@ -208,6 +209,8 @@ private:
     int loggedInMode = STATE_NONE;
     bool notificationsReady = false;
     bool isShown = false;
+    // Version of the transfers counters shown, empty until they are shown for the first time
+    std::optional<quint64> mTransfersCountVersion;
 
     QPointer<TransferManager> mTransferManager;
 
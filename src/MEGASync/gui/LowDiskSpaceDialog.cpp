@@ -7,6 +7,7 @@
 #include <QFileIconProvider>
 
 LowDiskSpaceDialog::LowDiskSpaceDialog(long long neededSize,
+                                       bool neededSizeIsLowerBound,
                                        long long freeSize,
                                        long long driveSize,
                                        const QString& driveName,
@@ -14,6 +15,7 @@ LowDiskSpaceDialog::LowDiskSpaceDialog(long long neededSize,
     QDialog(parent),
     mUi(new Ui::LowDiskSpaceDialog),
     mneededSize(neededSize),
+    mneededSizeIsLowerBound(neededSizeIsLowerBound),
     mfreeSize(freeSize),
     mdriveSize(driveSize),
     mdriveName(driveName)
@@ -42,8 +44,13 @@ QString LowDiskSpaceDialog::toString(long long bytes)
 
 void LowDiskSpaceDialog::updateStrings()
 {
+    // The size of some folders may not be known yet, as it would not change the outcome
     auto message =
-        tr("There is not enough space on %1. You need an additional %2 to download these files.");
+        mneededSizeIsLowerBound ?
+            tr("There is not enough space on %1. You need at least an additional %2 to download "
+               "these files.") :
+            tr("There is not enough space on %1. You need an additional %2 to download these "
+               "files.");
     mUi->lExplanation->setText(message.arg(mdriveName, toString(mneededSize - mfreeSize)));
 
     mUi->lDiskName->setText(mdriveName);
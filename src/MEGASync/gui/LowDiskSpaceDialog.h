@@ -16,6 +16,7 @@ class LowDiskSpaceDialog : public QDialog
 
 public:
     explicit LowDiskSpaceDialog(long long neededSize,
+                                bool neededSizeIsLowerBound,
                                 long long freeSize,
                                 long long driveSize,
                                 const QString& driveName,
@@ -31,6 +32,7 @@ private:
 
     Ui::LowDiskSpaceDialog* mUi;
     long long mneededSize;
+    bool mneededSizeIsLowerBound;
     long long mfreeSize;
     long long mdriveSize;
     QString mdriveName;
@@ -72,7 +72,13 @@ void ScanningWidget::onReceiveStatusUpdate(const FolderTransferUpdateEvent &even
             case mega::MegaTransfer::STAGE_CREATE_TREE:
             {
                 mUi->lStepTitle->setText(tr("Creating folders"));
-                mUi->lStepDescription->setText(tr("%1/%2").arg(event.createdfoldercount).arg(event.foldercount));
+                auto description(tr("%1/%2").arg(event.createdfoldercount).arg(event.foldercount));
+                if (event.remainingSeconds > 0)
+                {
+                    description = tr("%1, %2 left")
+                                      .arg(description, Utilities::getTimeString(event.remainingSeconds));
+                }
+                mUi->lStepDescription->setText(description);
                 break;
             }
         }
@@ -1,6 +1,7 @@
 #include "StreamingFromMegaDialog.h"
 
 #include "DialogOpener.h"
+#include "MegaApplication.h"
 #include "MegaInputDialog.h"
 #include "MegaNodeNames.h"
 #include "MessageDialogOpener.h"
@@ -26,16 +27,17 @@ const uint8_t StreamingFromMegaDialog::NODE_ID = 0;
 
 using namespace mega;
 
-StreamingFromMegaDialog::StreamingFromMegaDialog(mega::MegaApi *megaApi, mega::MegaApi* megaApiFolders, QWidget *parent)
+StreamingFromMegaDialog::StreamingFromMegaDialog(mega::MegaApi* megaApi,
+                                                 FolderLinkApiPool* folderApiPool,
+                                                 QWidget* parent)
     : QDialog(parent)
     , ui(std::make_unique<Ui::StreamingFromMegaDialog>())
-    , mLinkProcessor(std::make_unique<LinkProcessor>(megaApi, megaApiFolders)) // Use make_unique here
+    , mLinkProcessor(std::make_unique<LinkProcessor>(megaApi, folderApiPool))
     , lastStreamSelection{LastStreamingSelection::NOT_SELECTED}
 {
     ui->setupUi(this);
 
     this->megaApi = megaApi;
-    this->mMegaApiFolders = megaApiFolders;
     this->megaApi->httpServerSetMaxBufferSize(MAX_STREAMING_BUFFER_SIZE);
 
     int port = 4443;
@@ -1,12 +1,16 @@
 #include "ExclusionRulesModel.h"
 
+#include "Utilities.h"
+
 #include <QCoreApplication>
 
 #include <utility>
 
 ExclusionRulesModel::ExclusionRulesModel(QObject* parent, std::shared_ptr<MegaIgnoreManager> megaIgnoreManager)
-    : QAbstractListModel(parent)
+    : QAbstractListModel(parent),
+    mPreview(new MegaIgnorePreview(this))
 {
+    connect(mPreview, &MegaIgnorePreview::previewChanged, this, &ExclusionRulesModel::previewChanged);
 }
 
 ExclusionRulesModel::~ExclusionRulesModel()
@@ -48,6 +52,7 @@ bool ExclusionRulesModel::setData(const QModelIndex& index, const QVariant& valu
             rule->setCommented(value.toBool());
             checkEnableAllStatus();
             emit dataChanged(index, index, { role });
+            updatePreview();
         }
     }
     return result;
@@ -85,6 +90,10 @@ void ExclusionRulesModel::setEnabledRulesStatus(Qt::CheckState state, bool fromM
     }
     mEnableAllRulesState = state;
     emit enabledRulesStatusChanged();
+    if (!fromModel)
+    {
+        updatePreview();
+    }
 }
 
 void ExclusionRulesModel::checkEnableAllStatus()
@@ -278,6 +287,7 @@ bool ExclusionRulesModel::removeRow(int row)
     }
     checkEnableAllStatus();
     endRemoveRows();
+    updatePreview();
     return true;
 }
 
@@ -336,6 +346,7 @@ void ExclusionRulesModel::editRule(int targetType, int wildCard, QString ruleVal
     {
         addNewRule(targetType, wildCard, value);
     }
+    updatePreview();
 }
 
 void ExclusionRulesModel::addNewRule(int targetType, int wildCard, QString ruleVale)
@@ -394,6 +405,7 @@ void ExclusionRulesModel::addNewRule(int targetType, int wildCard, QString ruleV
     if (ruleAdded)
     {
         emit newRuleAdded(rowCount() - 1);
+        updatePreview();
     }
     else if( exisitingRuleIndex != -1)
     {
@@ -407,13 +419,16 @@ void ExclusionRulesModel::setFolder(const QString &folderName)
     if(!mMegaIgnoreManager)
     {
         mMegaIgnoreManager = std::make_shared<MegaIgnoreManager>(folderName, true);
-        checkEnableAllStatus();
-        endResetModel();
-        return;
     }
-    mMegaIgnoreManager->setInputDirPath(folderName);
+    else
+    {
+        mMegaIgnoreManager->setInputDirPath(folderName);
+    }
     checkEnableAllStatus();
     endResetModel();
+
+    mPreview->setFolder(folderName);
+    updatePreview();
 }
 
 void ExclusionRulesModel::applyChanges()
@@ -448,3 +463,22 @@ int ExclusionRulesModel::ruleExist(int targetType, int wildCard, QString ruleVal
     }
     return -1;
 }
+
+void ExclusionRulesModel::updatePreview()
+{
+    if (mMegaIgnoreManager)
+    {
+        mPreview->update(mMegaIgnoreManager->createMatcher());
+    }
+}
+
+QString ExclusionRulesModel::getPreviewText() const
+{
+    if (!mPreview->isReady() || mPreview->getExcludedFiles() == 0)
+    {
+        return QString();
+    }
+
+    return tr("%n file(s) excluded (%1)", "", mPreview->getExcludedFiles())
+        .arg(Utilities::getSizeString(mPreview->getExcludedBytes()));
+}
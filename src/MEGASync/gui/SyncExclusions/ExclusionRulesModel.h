@@ -2,6 +2,7 @@
 #define EXCLUSION_RULES_MODEL_H
 
 #include "MegaIgnoreManager.h"
+#include "MegaIgnorePreview.h"
 
 #include <QAbstractListModel>
 
@@ -10,6 +11,7 @@ class ExclusionRulesModel : public QAbstractListModel
     Q_OBJECT
 
     Q_PROPERTY(Qt::CheckState enabledRulesStatus READ getEnabledRulesStatus WRITE setEnabledRulesStatus NOTIFY enabledRulesStatusChanged)
+    Q_PROPERTY(QString previewText READ getPreviewText NOTIFY previewChanged)
 
 public:
 
@@ -54,13 +56,18 @@ public:
     Q_INVOKABLE void applyChanges();
     Qt::CheckState getEnabledRulesStatus() const;
     int ruleExist(int targetType, int wildCard, QString ruleVale);
+    // Evaluates the current rules against the folder, to show what they exclude before applying them
+    void updatePreview();
+    QString getPreviewText() const;
 
 signals:
     void enabledRulesStatusChanged();
     void newRuleAdded(int addedRuleIndex);
+    void previewChanged();
 
 private:
     std::shared_ptr<MegaIgnoreManager> mMegaIgnoreManager;
+    MegaIgnorePreview* mPreview;
     Qt::CheckState mEnableAllRulesState;
 };
 
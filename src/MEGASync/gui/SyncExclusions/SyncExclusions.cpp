@@ -65,6 +65,7 @@ void SyncExclusions::setMaximumAllowedSize(double maximumSize)
         highLimit->setUnit(value.second);
     }
     emit maximumAllowedSizeChanged(mMaximumAllowedSize);
+    mRulesModel->updatePreview();
 }
 
 void SyncExclusions::setMinimumAllowedSize(double minimumSize)
@@ -78,6 +79,7 @@ void SyncExclusions::setMinimumAllowedSize(double minimumSize)
     mMegaIgnoreManager->getLowLimitRule()->setValue(value.first);
     mMegaIgnoreManager->getLowLimitRule()->setUnit(value.second);
     emit minimumAllowedSizeChanged(mMinimumAllowedSize);
+    mRulesModel->updatePreview();
 }
 
 void SyncExclusions::setMaximumAllowedUnit(int maximumUnit)
@@ -95,6 +97,7 @@ void SyncExclusions::setMaximumAllowedUnit(int maximumUnit)
         highLimit->setUnit(value.second);
     }
     emit maximumAllowedUnitChanged(mMaximumAllowedUnit);
+    mRulesModel->updatePreview();
 }
 
 void SyncExclusions::setMinimumAllowedUnit(int minimumUnit)
@@ -112,6 +115,7 @@ void SyncExclusions::setMinimumAllowedUnit(int minimumUnit)
         lowLimit->setUnit(value.second);
     }
     emit minimumAllowedUnitChanged(mMinimumAllowedUnit);
+    mRulesModel->updatePreview();
 }
 
 void SyncExclusions::applyChanges()
@@ -203,6 +207,7 @@ void SyncExclusions::setSizeExclusionStatus(SyncExclusions::SizeExclusionStatus
     default:
         break;
     }
+    mRulesModel->updatePreview();
 }
 
 void SyncExclusions::setFolder(const QString& folderName)
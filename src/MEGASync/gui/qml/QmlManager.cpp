@@ -17,6 +17,7 @@
 #include "SyncInfo.h"
 
 #include <QDataStream>
+#include <QQmlComponent>
 #include <QQmlContext>
 #include <QQueue>
 
@@ -197,6 +198,30 @@ void QmlManager::retranslate()
     }
 }
 
+void QmlManager::preloadComponents(const QList<QUrl>& urls)
+{
+    for (const auto& url: urls)
+    {
+        auto component(new QQmlComponent(mEngine, url, QQmlComponent::Asynchronous));
+        auto deleteWhenLoaded = [component]()
+        {
+            if (!component->isLoading())
+            {
+                component->deleteLater();
+            }
+        };
+
+        if (component->isLoading())
+        {
+            QObject::connect(component, &QQmlComponent::statusChanged, deleteWhenLoaded);
+        }
+        else
+        {
+            deleteWhenLoaded();
+        }
+    }
+}
+
 QQmlEngine* QmlManager::getEngine()
 {
     return mEngine;
@@ -26,6 +26,10 @@ public:
 
     void retranslate();
 
+    // Compiles the components in the background, so they are in the engine type cache when a
+    // dialog using them is opened
+    void preloadComponents(const QList<QUrl>& urls);
+
     QQmlEngine* getEngine();
 
 private:
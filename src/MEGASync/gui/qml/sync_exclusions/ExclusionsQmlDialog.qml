@@ -485,6 +485,22 @@ QmlDialog {
             }
         }
 
+        Texts.Text {
+            id: previewText
+
+            anchors{
+                verticalCenter: doneButton.verticalCenter
+                left: restoreButton.right
+                right: doneButton.left
+                leftMargin: 16
+                rightMargin: 16
+            }
+            text: syncExclusionsAccess.rulesModel.previewText
+            horizontalAlignment: Text.AlignRight
+            elide: Text.ElideRight
+            font.pixelSize: Texts.Text.Size.NORMAL
+        }
+
         Buttons.OutlineButton {
             id: restoreButton
 
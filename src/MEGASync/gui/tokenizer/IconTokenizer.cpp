@@ -2,11 +2,16 @@
 
 #include "TokenizedIcon.h"
 
+#include <QApplication>
 #include <QBitmap>
 #include <QDebug>
+#include <QPixmapCache>
+#include <QThread>
 #include <QToolButton>
 #include <QWidget>
 
+#include <array>
+
 static const QString ButtonId = QString::fromUtf8("Button");
 static const QString CustomId = QString::fromUtf8("Custom");
 
@@ -129,7 +134,19 @@ std::optional<QPixmap> IconTokenizer::changePixmapColor(const QPixmap& pixmap, Q
         return std::nullopt;
     }
 
-    QImage image = pixmap.toImage();
+    // The cache key of a pixmap identifies its contents, so it already covers the icon source,
+    // its size and its device pixel ratio. QPixmapCache can only be used from the GUI thread
+    const bool useCache(QThread::currentThread() == qApp->thread());
+    const QString cacheKey(QString::fromLatin1("tinted_%1_%2")
+                               .arg(pixmap.cacheKey())
+                               .arg(toColor.rgb(), 0, 16));
+    QPixmap tintedPixmap;
+    if (useCache && QPixmapCache::find(cacheKey, &tintedPixmap))
+    {
+        return tintedPixmap;
+    }
+
+    QImage image = pixmap.toImage().convertToFormat(QImage::Format_ARGB32_Premultiplied);
     if (image.isNull())
     {
         qWarning() << __func__ << " Error image from pixmap is invalid";
@@ -140,16 +157,30 @@ std::optional<QPixmap> IconTokenizer::changePixmapColor(const QPixmap& pixmap, Q
     /*
      * we are using the requested color for every pixel on the image
      * only the alpha channel is preserved.
+     * As the output only depends on the alpha of each pixel, the 256 possible premultiplied
+     * results are computed once and every pixel becomes a table lookup.
     */
-    for(auto widthIndex = 0; widthIndex < image.width(); ++widthIndex)
+    std::array<QRgb, 256> tintByAlpha;
+    for (int alpha = 0; alpha < static_cast<int>(tintByAlpha.size()); ++alpha)
+    {
+        tintByAlpha[alpha] =
+            qPremultiply(qRgba(toColor.red(), toColor.green(), toColor.blue(), alpha));
+    }
+
+    for (auto heightIndex = 0; heightIndex < image.height(); ++heightIndex)
     {
-        for(auto heightIndex = 0; heightIndex < image.height(); ++heightIndex)
+        auto line = reinterpret_cast<QRgb*>(image.scanLine(heightIndex));
+        for (auto widthIndex = 0; widthIndex < image.width(); ++widthIndex)
         {
-            QColor color = image.pixelColor(widthIndex, heightIndex);
-            toColor.setAlpha(color.alpha());
-            image.setPixelColor(widthIndex, heightIndex, toColor);
+            line[widthIndex] = tintByAlpha[qAlpha(line[widthIndex])];
         }
     }
 
-    return QPixmap::fromImage(image);
+    tintedPixmap = QPixmap::fromImage(image);
+    if (useCache)
+    {
+        QPixmapCache::insert(cacheKey, tintedPixmap);
+    }
+
+    return tintedPixmap;
 }
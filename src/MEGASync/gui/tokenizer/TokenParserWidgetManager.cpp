@@ -289,10 +289,17 @@ void TokenParserWidgetManager::applyTheme(QWidget* widget, bool prependStandardC
         return;
     }
 
-    const auto& colorTokens = mColorThemedTokens.value(currentTheme);
-
-    replaceColorTokens(widgetStyleSheet, colorTokens);
-    replaceIconColorTokens(widget, widgetStyleSheet);
+    // Copied, as theming the children may add compiled stylesheets
+    const auto compiledStyleSheet = getCompiledStyleSheet(widgetStyleSheet, currentTheme);
+    for (const auto& iconColorToken: compiledStyleSheet.iconColorTokens)
+    {
+        IconTokenizer::process(widget,
+                               iconColorToken.mode,
+                               iconColorToken.state,
+                               iconColorToken.targetElementId,
+                               iconColorToken.targetElementProperty,
+                               iconColorToken.tokenId);
+    }
     tokenizeChildStyleSheets(widget);
     removeFrameOnDialogCombos(widget);
 
@@ -301,10 +308,43 @@ void TokenParserWidgetManager::applyTheme(QWidget* widget, bool prependStandardC
     // QGroupBox[type="mega"] { background-color: transparent; } directly onto the child,
     // overriding ID-specific overrides defined in the parent dialog's stylesheet.
     QString styleSheet = prependStandardComponents ?
-                             mThemedStandardComponentsStyleSheet[currentTheme] % widgetStyleSheet :
-                             widgetStyleSheet;
+                             mThemedStandardComponentsStyleSheet[currentTheme] % compiledStyleSheet.styleSheet :
+                             compiledStyleSheet.styleSheet;
 
-    widget->setStyleSheet(styleSheet);
+    // Setting the same stylesheet again would parse it again for nothing. The widgets are still
+    // repolished, as setStyleSheet did, since their dynamic properties ("type", "dimension"...)
+    // may have changed and the rules that match them with it
+    if (widget->styleSheet() != styleSheet)
+    {
+        widget->setStyleSheet(styleSheet);
+    }
+    else
+    {
+        polish(widget);
+        const auto children = widget->findChildren<QWidget*>();
+        for (auto child: children)
+        {
+            polish(child);
+        }
+    }
+}
+
+const TokenParserWidgetManager::CompiledStyleSheet&
+    TokenParserWidgetManager::getCompiledStyleSheet(const QString& sourceStyleSheet,
+                                                    const QString& theme)
+{
+    auto& themeStyleSheets = mCompiledStyleSheets[theme];
+    auto compiledIt = themeStyleSheets.find(sourceStyleSheet);
+    if (compiledIt == themeStyleSheets.end())
+    {
+        CompiledStyleSheet compiledStyleSheet;
+        compiledStyleSheet.styleSheet = sourceStyleSheet;
+        replaceColorTokens(compiledStyleSheet.styleSheet, mColorThemedTokens.value(theme));
+        compiledStyleSheet.iconColorTokens = parseIconColorTokens(compiledStyleSheet.styleSheet);
+        compiledIt = themeStyleSheets.insert(sourceStyleSheet, compiledStyleSheet);
+    }
+
+    return compiledIt.value();
 }
 
 void TokenParserWidgetManager::removeFrameOnDialogCombos(QWidget* widget)
@@ -354,8 +394,11 @@ void TokenParserWidgetManager::replaceColorTokens(QString& styleSheet,
     }
 }
 
-void TokenParserWidgetManager::replaceIconColorTokens(QWidget* widget, QString& styleSheet)
+QVector<TokenParserWidgetManager::IconColorToken>
+    TokenParserWidgetManager::parseIconColorTokens(const QString& styleSheet)
 {
+    QVector<IconColorToken> iconColorTokens;
+
     QRegularExpressionMatchIterator matchIterator =
         ICON_COLOR_TOKEN_REGULAR_EXPRESSION.globalMatch(styleSheet);
     while (matchIterator.hasNext())
@@ -364,24 +407,21 @@ void TokenParserWidgetManager::replaceIconColorTokens(QWidget* widget, QString&
 
         if (match.lastCapturedIndex() == ICON_TOKEN_CAPTURE_INDEX::ICON_TOKEN_DESIGN_TOKEN_NAME)
         {
-            const QString& targetElementProperty =
+            IconColorToken iconColorToken;
+            iconColorToken.targetElementProperty =
                 match.captured(ICON_TOKEN_CAPTURE_INDEX::ICON_TOKEN_TARGET_PROPERTY);
-            const QString& targetElementId =
+            iconColorToken.targetElementId =
                 match.captured(ICON_TOKEN_CAPTURE_INDEX::ICON_TOKEN_TARGET_ELEMENT_ID);
-            const QString& mode = match.captured(ICON_TOKEN_CAPTURE_INDEX::ICON_TOKEN_TARGET_MODE);
-            const QString& state =
+            iconColorToken.mode = match.captured(ICON_TOKEN_CAPTURE_INDEX::ICON_TOKEN_TARGET_MODE);
+            iconColorToken.state =
                 match.captured(ICON_TOKEN_CAPTURE_INDEX::ICON_TOKEN_TARGET_STATE);
-            const QString& tokenId =
+            iconColorToken.tokenId =
                 match.captured(ICON_TOKEN_CAPTURE_INDEX::ICON_TOKEN_DESIGN_TOKEN_NAME);
-
-            IconTokenizer::process(widget,
-                                   mode,
-                                   state,
-                                   targetElementId,
-                                   targetElementProperty,
-                                   tokenId);
+            iconColorTokens.append(iconColorToken);
         }
     }
+
+    return iconColorTokens;
 }
 
 std::shared_ptr<TokenParserWidgetManager> TokenParserWidgetManager::instance()
@@ -3,11 +3,13 @@
 
 #include <QColor>
 #include <QFileDialog>
+#include <QHash>
 #include <QMap>
 #include <QObject>
 #include <QPointer>
 #include <QSet>
 #include <QString>
+#include <QVector>
 #include <QWidget>
 
 #include <memory>
@@ -30,13 +32,32 @@ public:
 private:
     using ColorTokens = QMap<QString, QString>;
 
+    struct IconColorToken
+    {
+        QString targetElementProperty;
+        QString targetElementId;
+        QString mode;
+        QString state;
+        QString tokenId;
+    };
+
+    // A source stylesheet with the color tokens of one theme already replaced, and the icon
+    // tokens it contains, so the regular expressions run once per stylesheet and theme
+    struct CompiledStyleSheet
+    {
+        QString styleSheet;
+        QVector<IconColorToken> iconColorTokens;
+    };
+
     explicit TokenParserWidgetManager(QObject *parent = nullptr);
     void loadColorThemeJson();
     void loadStandardStyleSheetComponents();
     void onThemeChanged();
     void onUpdateRequested();
     void applyTheme(QWidget* widget, bool prependStandardComponents = true);
-    void replaceIconColorTokens(QWidget* widget, QString& styleSheet);
+    const CompiledStyleSheet& getCompiledStyleSheet(const QString& sourceStyleSheet,
+                                                    const QString& theme);
+    QVector<IconColorToken> parseIconColorTokens(const QString& styleSheet);
     void replaceColorTokens(QString& styleSheet, const ColorTokens& colorTokens);
     void removeFrameOnDialogCombos(QWidget* widget);
     void tokenizeChildStyleSheets(QWidget* widget);
@@ -44,6 +65,8 @@ private:
     QMap<QString, ColorTokens> mColorThemedTokens;
     QMap<QString, QString> mThemedStandardComponentsStyleSheet;
     QMap<QString, QString> mWidgetsStyleSheets;
+    // Theme -> source stylesheet -> compiled stylesheet
+    QHash<QString, QHash<QString, CompiledStyleSheet>> mCompiledStyleSheets;
     QSet<QWidget*> mRegisteredWidgets;
 };
 
@@ -8,6 +8,9 @@
 
 #include <QDateTime>
 
+#include <algorithm>
+#include <functional>
+
 UserMessageModel::~UserMessageModel()
 {
     qDeleteAll(mUserMessages);
@@ -70,39 +73,92 @@ auto UserMessageModel::findById(unsigned id, UserMessage::Type type)
     return it;
 }
 
+const QHash<unsigned, int>& UserMessageModel::getAlertRows()
+{
+    if (mAlertRowsDirty)
+    {
+        mAlertRows.clear();
+        mAlertRows.reserve(static_cast<int>(mUserMessages.size()));
+        for (int row = 0; row < static_cast<int>(mUserMessages.size()); ++row)
+        {
+            if (mUserMessages.at(row)->isOfType(UserMessage::Type::ALERT))
+            {
+                mAlertRows.insert(mUserMessages.at(row)->id(), row);
+            }
+        }
+        mAlertRowsDirty = false;
+    }
+
+    return mAlertRows;
+}
+
+void UserMessageModel::invalidateAlertRows()
+{
+    mAlertRowsDirty = true;
+}
+
 void UserMessageModel::processAlerts(mega::MegaUserAlertList* alerts)
 {
-    int numAlerts = alerts ? alerts->size() : 0;
-    if (numAlerts)
+    processAlerts(QList<mega::MegaUserAlertList*>{alerts});
+}
+
+void UserMessageModel::processAlerts(const QList<mega::MegaUserAlertList*>& alertLists)
+{
+    // Later lists may carry newer versions of the same alert, only the latest one is applied
+    QVector<mega::MegaUserAlert*> latestAlerts;
+    QHash<unsigned, int> latestAlertPositions;
+    for (auto alerts: alertLists)
     {
-        QList<mega::MegaUserAlert*> newAlerts;
-        QList<mega::MegaUserAlert*> updatedAlerts;
-        QList<mega::MegaUserAlert*> removedAlerts;
+        int numAlerts = alerts ? alerts->size() : 0;
         for (int i = 0; i < numAlerts; i++)
         {
             mega::MegaUserAlert* alert = alerts->get(i);
-            auto it = findById(alert->getId(), UserMessage::Type::ALERT);
-            if (it == mUserMessages.end())
+            auto positionIt = latestAlertPositions.find(alert->getId());
+            if (positionIt == latestAlertPositions.end())
             {
-                if (alert->isRemoved())
-                {
-                    removedAlerts.append(alert);
-                }
-                else
-                {
-                    newAlerts.append(alert->copy());
-                }
+                latestAlertPositions.insert(alert->getId(), latestAlerts.size());
+                latestAlerts.append(alert);
             }
-            else if (!alert->isRemoved())
+            else
             {
-                updatedAlerts.append(alert->copy());
+                latestAlerts[positionIt.value()] = alert;
             }
         }
+    }
+
+    if (latestAlerts.isEmpty())
+    {
+        return;
+    }
 
-        removeAlerts(removedAlerts);
-        insertAlerts(newAlerts);
-        updateAlerts(updatedAlerts);
+    QList<mega::MegaUserAlert*> newAlerts;
+    QList<mega::MegaUserAlert*> updatedAlerts;
+    QList<int> removedRows;
+    const auto& alertRows = getAlertRows();
+    for (auto alert: qAsConst(latestAlerts))
+    {
+        auto rowIt = alertRows.constFind(alert->getId());
+        if (rowIt == alertRows.constEnd())
+        {
+            if (!alert->isRemoved())
+            {
+                newAlerts.append(alert->copy());
+            }
+        }
+        else if (alert->isRemoved())
+        {
+            removedRows.append(rowIt.value());
+        }
+        else
+        {
+            updatedAlerts.append(alert->copy());
+        }
     }
+
+    removeAlertRows(removedRows);
+    insertAlerts(newAlerts);
+    updateAlerts(updatedAlerts);
+    removeExcessAlerts();
 }
 
 void UserMessageModel::insertAlerts(const QList<mega::MegaUserAlert*>& alerts)
@@ -124,6 +180,7 @@ void UserMessageModel::insertAlerts(const QList<mega::MegaUserAlert*>& alerts)
             mSeenStatusManager.markAsUnseen(alertItem->getMessageType());
         }
     }
+    invalidateAlertRows();
     endInsertRows();
 }
 
@@ -134,12 +191,14 @@ void UserMessageModel::updateAlerts(const QList<mega::MegaUserAlert*>& alerts)
         return;
     }
 
+    QList<int> updatedRows;
+    const auto& alertRows = getAlertRows();
     for (auto& alert: alerts)
     {
-        auto it = findById(alert->getId(), UserMessage::Type::ALERT);
-        if (it != mUserMessages.end())
+        auto rowIt = alertRows.constFind(alert->getId());
+        if (rowIt != alertRows.constEnd())
         {
-            int row = static_cast<int>(std::distance(mUserMessages.begin(), it));
+            int row = rowIt.value();
             auto alertItem = qobject_cast<UserAlert*>(mUserMessages[row]);
 
             if (alertItem->isSeen() && !alert->getSeen())
@@ -152,38 +211,69 @@ void UserMessageModel::updateAlerts(const QList<mega::MegaUserAlert*>& alerts)
             }
 
             alertItem->reset(alert);
-            emit dataChanged(index(row, 0, QModelIndex()), index(row, 0, QModelIndex()));
+            updatedRows.append(row);
+        }
+    }
+
+    // One dataChanged per contiguous range of updated rows
+    std::sort(updatedRows.begin(), updatedRows.end());
+    int rangeStart = 0;
+    while (rangeStart < updatedRows.size())
+    {
+        int rangeEnd = rangeStart;
+        while (rangeEnd + 1 < updatedRows.size() &&
+               updatedRows.at(rangeEnd + 1) == updatedRows.at(rangeEnd) + 1)
+        {
+            ++rangeEnd;
         }
+
+        emit dataChanged(index(updatedRows.at(rangeStart), 0, QModelIndex()),
+                         index(updatedRows.at(rangeEnd), 0, QModelIndex()));
+        rangeStart = rangeEnd + 1;
     }
 }
 
-void UserMessageModel::removeAlerts(const QList<mega::MegaUserAlert*>& alerts)
+void UserMessageModel::removeAlertRows(QList<int> rows)
 {
-    if (alerts.size() <= 0)
+    if (rows.isEmpty())
     {
         return;
     }
 
-    // Remove alerts that are not in the list of removed alerts
-    for (auto& alert: alerts)
+    // Remove contiguous ranges from the bottom up, so the pending rows keep their position
+    std::sort(rows.begin(), rows.end(), std::greater<int>());
+    int rangeStart = 0;
+    while (rangeStart < rows.size())
     {
-        auto it = findById(alert->getId(), UserMessage::Type::ALERT);
-        if (it != mUserMessages.end())
+        int rangeEnd = rangeStart;
+        while (rangeEnd + 1 < rows.size() && rows.at(rangeEnd + 1) == rows.at(rangeEnd) - 1)
         {
-            int row = static_cast<int>(std::distance(mUserMessages.begin(), it));
-            auto alertItem = qobject_cast<UserAlert*>(mUserMessages[row]);
+            ++rangeEnd;
+        }
+
+        const int firstRow = rows.at(rangeEnd);
+        const int lastRow = rows.at(rangeStart);
+        beginRemoveRows(QModelIndex(), firstRow, lastRow);
+        for (int row = firstRow; row <= lastRow; ++row)
+        {
+            auto alertItem = qobject_cast<UserAlert*>(mUserMessages.at(row));
             if (!alertItem->isSeen())
             {
                 mSeenStatusManager.markAsSeen(alertItem->getMessageType());
             }
-
-            beginRemoveRows(QModelIndex(), row, row);
-            delete mUserMessages[row];
-            mUserMessages.erase(it);
-            endRemoveRows();
+            delete alertItem;
         }
+        mUserMessages.erase(mUserMessages.begin() + firstRow, mUserMessages.begin() + lastRow + 1);
+        endRemoveRows();
+
+        rangeStart = rangeEnd + 1;
     }
 
+    invalidateAlertRows();
+}
+
+void UserMessageModel::removeExcessAlerts()
+{
     // Remove the oldest items if the list is too long
     if (static_cast<unsigned>(mUserMessages.size()) > Preferences::MAX_COMPLETED_ITEMS)
     {
@@ -200,6 +290,8 @@ void UserMessageModel::removeAlerts(const QList<mega::MegaUserAlert*>& alerts)
             }
             --row;
         }
+
+        invalidateAlertRows();
     }
 }
 
@@ -271,6 +363,7 @@ void UserMessageModel::insertNotifications(const QList<mega::MegaNotification*>&
         auto item = new UserNotification(notification);
         connect(item, &UserAlert::uiUpdated, this, &UserMessageModel::onUiUpdated);
         mUserMessages.push_back(item);
+        invalidateAlertRows();
 
         if (!mSeenStatusManager.markNotificationAsUnseen(item->id()))
         {
@@ -325,6 +418,7 @@ void UserMessageModel::removeNotifications(const mega::MegaNotificationList* not
             beginRemoveRows(QModelIndex(), row, row);
             delete mUserMessages[row];
             mUserMessages.removeAt(row);
+            invalidateAlertRows();
             endRemoveRows();
         }
     }
@@ -388,6 +482,7 @@ void UserMessageModel::onExpired(unsigned id)
         beginRemoveRows(QModelIndex(), row, row);
         delete mUserMessages[row];
         mUserMessages.erase(it);
+        invalidateAlertRows();
         endRemoveRows();
     }
 }
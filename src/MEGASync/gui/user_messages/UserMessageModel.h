@@ -5,6 +5,7 @@
 #include "UserMessage.h"
 
 #include <QAbstractItemModel>
+#include <QHash>
 
 namespace mega
 {
@@ -30,6 +31,8 @@ public:
     Qt::ItemFlags flags(const QModelIndex& index) const override;
 
     void processAlerts(mega::MegaUserAlertList* alerts);
+    // Applies several alert lists received in a row as a single update
+    void processAlerts(const QList<mega::MegaUserAlertList*>& alertLists);
     void processNotifications(const mega::MegaNotificationList* notifications);
     bool hasAlertsOfType(MessageType type);
     UnseenUserMessagesMap getUnseenNotifications() const;
@@ -67,10 +70,17 @@ private:
 
     QList<UserMessage*> mUserMessages;
     SeenStatusManager mSeenStatusManager;
+    // Alert id -> row, rebuilt at most once per batch of changes
+    QHash<unsigned, int> mAlertRows;
+    bool mAlertRowsDirty = true;
+
+    const QHash<unsigned, int>& getAlertRows();
+    void invalidateAlertRows();
 
     void insertAlerts(const QList<mega::MegaUserAlert*>& alerts);
     void updateAlerts(const QList<mega::MegaUserAlert*>& alerts);
-    void removeAlerts(const QList<mega::MegaUserAlert*>& alerts);
+    void removeAlertRows(QList<int> rows);
+    void removeExcessAlerts();
 
     void insertNotifications(const QList<mega::MegaNotification*>& notifications);
     void updateNotification(int row, const mega::MegaNotification* notification);
@@ -472,7 +472,7 @@ QString TransferNotificationBuilder::buildImportedLinkError(
     if (failedItem)
     {
         auto errorCode(failedItem->getErrorCode());
-        auto path(failedItem->id.path);
+        auto path(failedItem->id.path());
 
         if (errorCode == mega::MegaError::API_EWRITE)
         {
@@ -1,6 +1,7 @@
 #include "StalledIssueActionTitle.h"
 
 #include "MegaApplication.h"
+#include "StalledIssueBaseDelegateWidget.h"
 #include "StalledIssuesModel.h"
 #include "StalledIssuesUtilities.h"
 #include "ThemeManager.h"
@@ -264,6 +265,7 @@ void StalledIssueActionTitle::addExtraInfo(AttributeType type, const QString& ti
     rowLayout->insertItem(rowLayout->count()-1, new QSpacerItem(20,10,QSizePolicy::Fixed, QSizePolicy::Fixed));
 
     setStyleSheet(styleSheet());
+    onExtraInfoChanged();
 }
 
 void StalledIssueActionTitle::setFailed(bool state, const QString& errorTooltip)
@@ -557,6 +559,8 @@ void StalledIssueActionTitle::showAttribute(AttributeType type)
 
 void StalledIssueActionTitle::updateLabel(QLabel *label, const QString &text)
 {
+    const auto previousText(label->text());
+
     if(label->property(EXTRAINFO_SIZE).isValid())
     {
         auto elidedText = label->fontMetrics().elidedText(text, Qt::ElideMiddle, label->property(EXTRAINFO_SIZE).toInt());
@@ -568,6 +572,24 @@ void StalledIssueActionTitle::updateLabel(QLabel *label, const QString &text)
     }
 
     label->setProperty(MESSAGE_TEXT, text);
+
+    if(label->text() != previousText)
+    {
+        onExtraInfoChanged();
+    }
+}
+
+void StalledIssueActionTitle::onExtraInfoChanged()
+{
+    //Most attributes arrive after the row has been painted, which may be cached without them
+    for(auto parent = parentWidget(); parent; parent = parent->parentWidget())
+    {
+        if(auto delegateWidget = qobject_cast<StalledIssueBaseDelegateWidget*>(parent))
+        {
+            delegateWidget->invalidateRowPaint();
+            return;
+        }
+    }
 }
 
 void StalledIssueActionTitle::updateIcon()
@@ -102,6 +102,7 @@ private:
     bool isRawInfoVisible() const;
     void showAttribute(AttributeType type);
     void updateLabel(QLabel* label, const QString& text);
+    void onExtraInfoChanged();
     void updateIcon();
     QMap<AttributeType, QPointer<QLabel>> mUpdateLabels;
     QMap<AttributeType, QPointer<QLabel>> mTitleLabels;
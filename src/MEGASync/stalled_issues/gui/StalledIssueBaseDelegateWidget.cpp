@@ -134,6 +134,7 @@ void StalledIssueBaseDelegateWidget::checkForSizeHintChanges()
 
         if(auto stalledDelegate = dynamic_cast<StalledIssueDelegate*>(mDelegate))
         {
+            stalledDelegate->removeCachedSize(mData);
             stalledDelegate->updateSizeHint();
         }
     }
@@ -156,6 +157,14 @@ void StalledIssueBaseDelegateWidget::updateSizeHint()
     mResizeNeedTimer.start();
 }
 
+void StalledIssueBaseDelegateWidget::invalidateRowPaint()
+{
+    if(auto stalledDelegate = dynamic_cast<StalledIssueDelegate*>(mDelegate))
+    {
+        stalledDelegate->invalidateRowPaintCache(mData);
+    }
+}
+
 bool StalledIssueBaseDelegateWidget::checkForExternalChanges(bool isSingleSelection)
 {
     if (isSingleSelection &&
@@ -38,6 +38,8 @@ public:
     void setDelegate(QStyledItemDelegate *newDelegate);
 
     void updateSizeHint();
+    // Repaints the row from the widget, as its content changed after the row was painted
+    void invalidateRowPaint();
 
     bool checkForExternalChanges(bool isSingleSelection);
 
@@ -1,6 +1,7 @@
 #include "StalledIssueDelegate.h"
 
 #include "DialogOpener.h"
+#include "MegaApplication.h"
 #include "MegaDelegateHoverManager.h"
 #include "StalledIssue.h"
 #include "StalledIssueBaseDelegateWidget.h"
@@ -19,6 +20,8 @@
 const int PEN_WIDTH = 2;
 const int UPDATE_SIZE_TIMER = 50;
 const QSize DEFAULT_SIZE = QSize(100,60);
+const int MAX_CACHED_ROWS = 256;
+const int MAX_CACHED_SIZES = 50000;
 
 StalledIssueDelegate::StalledIssueDelegate(StalledIssuesProxyModel* proxyModel,  StalledIssuesView *view)
     :QStyledItemDelegate(view),
@@ -68,6 +71,25 @@ StalledIssueDelegate::StalledIssueDelegate(StalledIssuesProxyModel* proxyModel,
 
     mView->installEventFilter(this);
 
+    //The raw values change the attributes of every row, not only of those with a widget
+    connect(mSourceModel,
+            &StalledIssuesModel::showRawInfoChanged,
+            this,
+            [this]()
+            {
+                clearRowPaintCache();
+                updateView();
+            });
+
+    connect(MegaSyncApp,
+            &MegaApplication::languageChanged,
+            this,
+            [this]()
+            {
+                mSizeCache.clear();
+                clearRowPaintCache();
+            });
+
     updateColors();
 }
 
@@ -102,13 +124,14 @@ void StalledIssueDelegate::updateVisibleIndexesSizeHint(int updateDelay, bool fo
                     mVisibleIndexesRange.append(row);
 
                     StalledIssueVariant stalledIssueItem (qvariant_cast<StalledIssueVariant>(index.data(Qt::DisplayRole)));
-                    if(stalledIssueItem.isValid())
+                    //Rows already measured at this width do not need to be laid out again
+                    if(stalledIssueItem.isValid() &&
+                       !getCachedSize(stalledIssueItem.consultData(), StalledIssue::Header).isValid())
                     {
                         stalledIssueItem.removeDelegateSize(StalledIssue::Header);
                         stalledIssueItem.removeDelegateSize(StalledIssue::Body);
+                        sizeHintUpdateNeeded = true;
                     }
-
-                    sizeHintUpdateNeeded = true;
                 }
 
             }
@@ -149,6 +172,12 @@ QSize StalledIssueDelegate::sizeHint(const QStyleOptionViewItem& option, const Q
         QSize size;
 
         StalledIssue::Type sizeType = index.parent().isValid() ? StalledIssue::Body : StalledIssue::Header;
+        size = getCachedSize(stalledIssueItem.consultData(), sizeType);
+        if(size.isValid())
+        {
+            return size;
+        }
+
         size = stalledIssueItem.getDelegateSize(sizeType);
 
         if(!size.isValid() && mFreshStart)
@@ -196,6 +225,7 @@ QSize StalledIssueDelegate::sizeHint(const QStyleOptionViewItem& option, const Q
             if(w)
             {
                 size = w->sizeHint();
+                setCachedSize(stalledIssueItem.consultData(), sizeType, size);
                 if(mFreshStart)
                 {
                     if(mAverageHeaderHeight.contains(stalledIssueItem.consultData()->getReason()))
@@ -224,6 +254,114 @@ QSize StalledIssueDelegate::sizeHint(const QStyleOptionViewItem& option, const Q
 void StalledIssueDelegate::resetCache()
 {
     mCacheManager.reset();
+    clearRowPaintCache();
+}
+
+QSize StalledIssueDelegate::getCachedSize(const std::shared_ptr<const StalledIssue>& issue,
+                                          StalledIssue::Type type) const
+{
+    auto entryIt = mSizeCache.find(issue.get());
+    if(entryIt == mSizeCache.end())
+    {
+        return QSize();
+    }
+
+    //The address may belong to a new issue, or the content of this one may have changed
+    if(entryIt->issue.lock() != issue || issue->needsUIUpdate(type))
+    {
+        mSizeCache.erase(entryIt);
+        return QSize();
+    }
+
+    return entryIt->sizes.value(qMakePair(static_cast<int>(type), mView->viewport()->width()));
+}
+
+void StalledIssueDelegate::setCachedSize(const std::shared_ptr<const StalledIssue>& issue,
+                                         StalledIssue::Type type,
+                                         const QSize& size) const
+{
+    if(!size.isValid())
+    {
+        return;
+    }
+
+    if(mSizeCache.size() >= MAX_CACHED_SIZES)
+    {
+        //Forget the issues which do not exist anymore
+        for(auto entryIt = mSizeCache.begin(); entryIt != mSizeCache.end();)
+        {
+            entryIt = entryIt->issue.expired() ? mSizeCache.erase(entryIt) : std::next(entryIt);
+        }
+
+        if(mSizeCache.size() >= MAX_CACHED_SIZES)
+        {
+            mSizeCache.clear();
+        }
+    }
+
+    auto& entry = mSizeCache[issue.get()];
+    if(entry.issue.lock() != issue)
+    {
+        entry.issue = issue;
+        entry.sizes.clear();
+    }
+    entry.sizes.insert(qMakePair(static_cast<int>(type), mView->viewport()->width()), size);
+}
+
+void StalledIssueDelegate::removeCachedSize(const StalledIssueVariant& issue)
+{
+    if(issue.consultData())
+    {
+        mSizeCache.remove(issue.consultData().get());
+        mRowPaintCache.remove(qMakePair(issue.consultData().get(), static_cast<int>(StalledIssue::Header)));
+        mRowPaintCache.remove(qMakePair(issue.consultData().get(), static_cast<int>(StalledIssue::Body)));
+    }
+}
+
+void StalledIssueDelegate::invalidateRowPaintCache(const StalledIssueVariant& issue)
+{
+    if(!issue.consultData())
+    {
+        return;
+    }
+
+    auto headerRemoved(mRowPaintCache.remove(
+        qMakePair(issue.consultData().get(), static_cast<int>(StalledIssue::Header))));
+    auto bodyRemoved(mRowPaintCache.remove(
+        qMakePair(issue.consultData().get(), static_cast<int>(StalledIssue::Body))));
+    //Only the rows painted from the cache need it, the others are painted from the widget anyway
+    if(headerRemoved > 0 || bodyRemoved > 0)
+    {
+        updateView();
+    }
+}
+
+bool StalledIssueDelegate::drawCachedRow(QPainter* painter,
+                                         const std::shared_ptr<const StalledIssue>& issue,
+                                         StalledIssue::Type type,
+                                         const RowPaintCache& key) const
+{
+    auto cacheIt = mRowPaintCache.find(qMakePair(issue.get(), static_cast<int>(type)));
+    if(cacheIt == mRowPaintCache.end())
+    {
+        return false;
+    }
+
+    if(cacheIt->issue.lock() != issue || issue->needsUIUpdate(type) || cacheIt->size != key.size ||
+       cacheIt->expanded != key.expanded || cacheIt->selected != key.selected ||
+       !qFuzzyCompare(cacheIt->devicePixelRatio, key.devicePixelRatio))
+    {
+        mRowPaintCache.erase(cacheIt);
+        return false;
+    }
+
+    painter->drawPixmap(0, 0, key.size.width(), key.size.height(), cacheIt->pixmap);
+    return true;
+}
+
+void StalledIssueDelegate::clearRowPaintCache()
+{
+    mRowPaintCache.clear();
 }
 
 void StalledIssueDelegate::updateView()
@@ -355,22 +493,50 @@ void StalledIssueDelegate::paint(QPainter *painter, const QStyleOptionViewItem &
 
         if(renderDelegate)
         {
-            StalledIssueBaseDelegateWidget* w (getStalledIssueItemWidget(index, stalledIssueItem, geometry.size()));
-            if(!w)
+            auto issue(stalledIssueItem.consultData());
+            StalledIssue::Type type = index.parent().isValid() ? StalledIssue::Body : StalledIssue::Header;
+
+            RowPaintCache rowPaint;
+            rowPaint.size = geometry.size();
+            rowPaint.expanded = isExpanded;
+            rowPaint.selected = state.testFlag(QStyle::State_Selected);
+            rowPaint.devicePixelRatio = painter->device()->devicePixelRatioF();
+
+            if(!drawCachedRow(painter, issue, type, rowPaint))
             {
-                painter->restore();
-                return;
-            }
+                StalledIssueBaseDelegateWidget* w (getStalledIssueItemWidget(index, stalledIssueItem, geometry.size()));
+                if(!w)
+                {
+                    painter->restore();
+                    return;
+                }
+
+                painter->save();
 
-            painter->save();
+                w->expand(isExpanded);
+                w->setGeometry(geometry);
 
-            w->expand(isExpanded);
-            w->setGeometry(geometry);
+                auto pixmap = w->grab();
+                painter->drawPixmap(0, 0, w->width(), w->height(), pixmap);
 
-            auto pixmap = w->grab();
-            painter->drawPixmap(0, 0, w->width(), w->height(), pixmap);
+                painter->restore();
 
-            painter->restore();
+                //Rows being solved show an animation, they are always rendered from the widget
+                bool beingSolved(issue->isBeingSolved() ||
+                                 (issue->hasCustomMessage() &&
+                                  issue->getCustomMessage().customType == StalledIssue::ResolutionState::BEING_SOLVED));
+                if(!beingSolved && w->size() == rowPaint.size)
+                {
+                    if(mRowPaintCache.size() >= MAX_CACHED_ROWS)
+                    {
+                        mRowPaintCache.clear();
+                    }
+
+                    rowPaint.issue = issue;
+                    rowPaint.pixmap = pixmap;
+                    mRowPaintCache.insert(qMakePair(issue.get(), static_cast<int>(type)), rowPaint);
+                }
+            }
         }
         else if(mEditor)
         {
@@ -650,6 +816,7 @@ void StalledIssueDelegate::updateColorsCheckingTheme() const
     {
         theme = ThemeManager::instance()->currentColorScheme();
         updateColors();
+        mRowPaintCache.clear();
     }
 }
 
@@ -5,11 +5,14 @@
 #include "StalledIssuesModel.h"
 #include "StalledIssuesProxyModel.h"
 
+#include <QPixmap>
 #include <QPointer>
 #include <QSortFilterProxyModel>
 #include <QStyledItemDelegate>
 #include <QTreeView>
 
+#include <memory>
+
 class StalledIssueBaseDelegateWidget;
 class StalledIssuesView;
 
@@ -24,6 +27,10 @@ public:
     void resetCache();
 
     void updateSizeHint();
+    // Drops the measured size and the rendering of the issue, as its content has been relaid out
+    void removeCachedSize(const StalledIssueVariant& issue);
+    // Drops the rendering of the issue and repaints it, as its content has changed
+    void invalidateRowPaintCache(const StalledIssueVariant& issue);
 
     void expandIssue(const QModelIndex& sourceIndex);
 
@@ -50,6 +57,38 @@ protected slots:
     void updateVisibleIndexesSizeHint(int updateDelay, bool forceUpdate);
 
 private:
+    // Sizes measured with the delegate widgets, by issue type and viewport width. They survive
+    // scrolling, filtering and resizing back to a known width, so the widgets are only laid out
+    // for rows which were never measured at the current width
+    struct SizeCacheEntry
+    {
+        std::weak_ptr<const StalledIssue> issue;
+        QHash<QPair<int, int>, QSize> sizes;
+    };
+
+    // Last rendering of a row which is not being edited. While it is valid, the row is painted
+    // from it and the delegate widget is not updated nor grabbed again
+    struct RowPaintCache
+    {
+        std::weak_ptr<const StalledIssue> issue;
+        QSize size;
+        bool expanded = false;
+        bool selected = false;
+        qreal devicePixelRatio = 1.0;
+        QPixmap pixmap;
+    };
+
+    QSize getCachedSize(const std::shared_ptr<const StalledIssue>& issue,
+                        StalledIssue::Type type) const;
+    void setCachedSize(const std::shared_ptr<const StalledIssue>& issue,
+                       StalledIssue::Type type,
+                       const QSize& size) const;
+    bool drawCachedRow(QPainter* painter,
+                       const std::shared_ptr<const StalledIssue>& issue,
+                       StalledIssue::Type type,
+                       const RowPaintCache& key) const;
+    void clearRowPaintCache();
+
     QModelIndex getEditorCurrentIndex() const;
     QModelIndex getRelativeIndex(const QModelIndex &index) const;
     QModelIndex getHeaderIndex(const QModelIndex& index) const;
@@ -77,6 +116,8 @@ private:
     mutable int mSizeHintRequested = 0;
     mutable bool mFreshStart = true;
     mutable QMap<int, QPair<int, QSize>> mAverageHeaderHeight;
+    mutable QHash<const StalledIssue*, SizeCacheEntry> mSizeCache;
+    mutable QHash<QPair<const StalledIssue*, int>, RowPaintCache> mRowPaintCache;
 
     // Colors
     mutable QColor mActiveColor;
@@ -0,0 +1,64 @@
+#ifndef FAILED_ISSUES_BATCH_H
+#define FAILED_ISSUES_BATCH_H
+
+#include <QList>
+#include <QPair>
+#include <QSet>
+
+#include <algorithm>
+
+// Failed issues of a solving batch, taken out of the failed list with a single lock. Each issue is
+// released when it is handed to its solver, which puts it back in the list if it fails again. When
+// the batch ends, the issues which were not released (the run was stopped before them) and are
+// still failed must go back to the list
+template<typename Issue, typename Key>
+class FailedIssuesBatch
+{
+public:
+    // Takes the issues with the given keys out of the list, returns how many were taken
+    template<typename GetKey>
+    int take(QList<Issue>& failedIssues, const QSet<Key>& keys, GetKey getKey)
+    {
+        auto taken(std::stable_partition(failedIssues.begin(),
+                                         failedIssues.end(),
+                                         [&keys, &getKey](const Issue& issue)
+                                         {
+                                             return !keys.contains(getKey(issue));
+                                         }));
+        const auto takenCount(static_cast<int>(std::distance(taken, failedIssues.end())));
+        for (auto it = taken; it != failedIssues.end(); ++it)
+        {
+            mTakenIssues.append(qMakePair(getKey(*it), *it));
+        }
+        failedIssues.erase(taken, failedIssues.end());
+        return takenCount;
+    }
+
+    void release(const Key& key)
+    {
+        mReleasedKeys.insert(key);
+    }
+
+    // Issues to put back in the failed list, in the order they had. The batch is empty afterwards
+    template<typename IsFailed>
+    QList<Issue> takeUnreleased(IsFailed isFailed)
+    {
+        QList<Issue> issues;
+        for (const auto& takenIssue: qAsConst(mTakenIssues))
+        {
+            if (!mReleasedKeys.contains(takenIssue.first) && isFailed(takenIssue.second))
+            {
+                issues.append(takenIssue.second);
+            }
+        }
+        mTakenIssues.clear();
+        mReleasedKeys.clear();
+        return issues;
+    }
+
+private:
+    QList<QPair<Key, Issue>> mTakenIssues;
+    QSet<Key> mReleasedKeys;
+};
+
+#endif // FAILED_ISSUES_BATCH_H
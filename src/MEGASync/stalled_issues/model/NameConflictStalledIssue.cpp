@@ -7,6 +7,7 @@
 #include "StalledIssuesModel.h"
 #include "StatsEventHandler.h"
 #include "SyncController.h"
+#include "UniqueNameAllocator.h"
 #include "Utilities.h"
 
 NameConflictedStalledIssue::NameConflictedStalledIssue(const mega::MegaSyncStall* stallIssue):
@@ -468,7 +469,24 @@ bool NameConflictedStalledIssue::renameNodesAutomatically()
     auto localConflictedNames(mLocalConflictedNames);
     sortLogic(localConflictedNames);
 
-    QStringList itemsBeingRenamed;
+    // Both sides share the allocator, so a name given to a cloud node is not reused locally
+    UniqueNameAllocator itemsBeingRenamed;
+    if(!cloudConflictedNames.isEmpty())
+    {
+        std::unique_ptr<mega::MegaNode> conflictedNode(
+            MegaSyncApp->getMegaApi()->getNodeByHandle(cloudConflictedNames.first()->mHandle));
+        if(conflictedNode)
+        {
+            std::unique_ptr<mega::MegaNode> parentNode(
+                MegaSyncApp->getMegaApi()->getNodeByHandle(conflictedNode->getParentHandle()));
+            itemsBeingRenamed.addRemoteFolderNames(parentNode.get(), false);
+        }
+    }
+    if(!localConflictedNames.isEmpty())
+    {
+        QFileInfo fileInfo(localConflictedNames.first()->mConflictedPath);
+        itemsBeingRenamed.addLocalFolderNames(fileInfo.path(), true);
+    }
 
     if(localConflictedNames.isEmpty())
     {
@@ -510,7 +528,7 @@ bool NameConflictedStalledIssue::renameNodesAutomatically()
 bool NameConflictedStalledIssue::renameCloudNodesAutomatically(const QList<std::shared_ptr<ConflictedNameInfo>>& cloudConflictedNames,
                                                                const QList<std::shared_ptr<ConflictedNameInfo>>& localConflictedNames,
                                                                bool ignoreLastModifiedName,
-                                                               QStringList& cloudItemsBeingRenamed)
+                                                               UniqueNameAllocator& itemsBeingRenamed)
 {
     auto result(true);
     for (auto i = cloudConflictedNames.crbegin(), end = cloudConflictedNames.crend(); i != end; ++i)
@@ -537,8 +555,7 @@ bool NameConflictedStalledIssue::renameCloudNodesAutomatically(const QList<std::
                 {
                     std::shared_ptr<mega::MegaError> error(nullptr);
 
-                    std::unique_ptr<mega::MegaNode> parentNode(MegaSyncApp->getMegaApi()->getNodeByHandle(conflictedNode->getParentHandle()));
-                    auto newName = Utilities::getNonDuplicatedNodeName(conflictedNode.get(), parentNode.get(), cloudConflictedName->getConflictedName(), true, cloudItemsBeingRenamed);
+                    auto newName = Utilities::getNonDuplicatedNodeName(conflictedNode.get(), cloudConflictedName->getConflictedName(), true, itemsBeingRenamed);
                     MegaApiSynchronizedRequest::runRequestWithResult(
                         &mega::MegaApi::renameNode,
                         MegaSyncApp->getMegaApi(),
@@ -560,7 +577,6 @@ bool NameConflictedStalledIssue::renameCloudNodesAutomatically(const QList<std::
                     }
                     else
                     {
-                        cloudItemsBeingRenamed.append(newName);
                         cloudConflictedName->solveByRename(newName);
                     }
                 }
@@ -574,7 +590,7 @@ bool NameConflictedStalledIssue::renameCloudNodesAutomatically(const QList<std::
 bool NameConflictedStalledIssue::renameLocalItemsAutomatically(const QList<std::shared_ptr<ConflictedNameInfo>>& cloudConflictedNames,
                                                                const QList<std::shared_ptr<ConflictedNameInfo>>& localConflictedNames,
                                                                bool ignoreLastModifiedName,
-                                                               QStringList& cloudItemsBeingRenamed)
+                                                               UniqueNameAllocator& itemsBeingRenamed)
 {
     auto result(true);
     for (auto i = localConflictedNames.crbegin(), end = localConflictedNames.crend(); i != end; ++i)
@@ -603,7 +619,7 @@ bool NameConflictedStalledIssue::renameLocalItemsAutomatically(const QList<std::
                 if(file.exists())
                 {
                     bool isFile(fileInfo.isFile());
-                    auto newName = Utilities::getNonDuplicatedLocalName(fileInfo, true, cloudItemsBeingRenamed);
+                    auto newName = Utilities::getNonDuplicatedLocalName(fileInfo, true, itemsBeingRenamed);
 
                     fileInfo.setFile(fileInfo.path(), newName);
                     if(file.rename(QDir::toNativeSeparators(fileInfo.filePath())))
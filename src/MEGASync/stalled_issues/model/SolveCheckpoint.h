@@ -0,0 +1,117 @@
+#ifndef SOLVE_CHECKPOINT_H
+#define SOLVE_CHECKPOINT_H
+
+#include <QHash>
+#include <QList>
+#include <QSet>
+
+#include <memory>
+
+// Issues processed by a solving run stopped by the user. Running the same action on the same
+// issues again resumes it: the issues already processed are skipped and the progress goes on. Any
+// other action or selection starts from scratch, as the issues were processed for another action.
+// Issues are kept as weak pointers, so a new issue at the address of a removed one is not taken
+// for it
+template<typename Action, typename Issue, typename Progress>
+class SolveCheckpoint
+{
+public:
+    // Called when a run starts. Returns true if it resumes the stopped run, otherwise the
+    // checkpoint is started again for this run
+    bool begin(const Action& action, const QList<std::shared_ptr<const Issue>>& selection)
+    {
+        if (mStopped && canResume(action, selection))
+        {
+            mStopped = false;
+            return true;
+        }
+
+        clear();
+        mAction = action;
+        for (const auto& issue: selection)
+        {
+            if (issue)
+            {
+                mIssues.insert(issue.get(), issue);
+            }
+        }
+        return false;
+    }
+
+    void setProcessed(const Issue* issue)
+    {
+        mProcessedIssues.insert(issue);
+    }
+
+    bool isProcessed(const Issue* issue) const
+    {
+        return mProcessedIssues.contains(issue);
+    }
+
+    // Keeps the run, so the next one on the same issues resumes it
+    void stop(const Progress& progress)
+    {
+        mProgress = progress;
+        mStopped = true;
+    }
+
+    void clear()
+    {
+        mIssues.clear();
+        mProcessedIssues.clear();
+        mProgress = Progress();
+        mStopped = false;
+    }
+
+    const Progress& getProgress() const
+    {
+        return mProgress;
+    }
+
+    // Issues selected by the first run, as the resumed ones do not select those solved since then
+    int getIssuesCount() const
+    {
+        return static_cast<int>(mIssues.size());
+    }
+
+private:
+    bool canResume(const Action& action, const QList<std::shared_ptr<const Issue>>& selection)
+        const
+    {
+        if (!(action == mAction))
+        {
+            return false;
+        }
+
+        QSet<const Issue*> selectedIssues;
+        for (const auto& issue: selection)
+        {
+            if (!issue || mIssues.value(issue.get()).lock() != issue)
+            {
+                return false;
+            }
+            selectedIssues.insert(issue.get());
+        }
+
+        // The issues processed by the stopped run may be solved and not selectable anymore, the
+        // rest must be selected again
+        for (auto it = mIssues.cbegin(); it != mIssues.cend(); ++it)
+        {
+            if (!mProcessedIssues.contains(it.key()) && !it.value().expired() &&
+                !selectedIssues.contains(it.key()))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    Action mAction = Action();
+    QHash<const Issue*, std::weak_ptr<const Issue>> mIssues;
+    QSet<const Issue*> mProcessedIssues;
+    Progress mProgress = Progress();
+    bool mStopped = false;
+};
+
+#endif // SOLVE_CHECKPOINT_H
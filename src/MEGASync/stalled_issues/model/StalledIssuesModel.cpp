@@ -16,6 +16,10 @@
 #include "StatsEventHandler.h"
 #include "SyncController.h"
 
+#include <QElapsedTimer>
+
+#include <algorithm>
+
 StalledIssuesReceiver::StalledIssuesReceiver(QObject* parent) : QObject(parent), mega::MegaRequestListener()
 {
     connect(&mIssueCreator, &StalledIssuesCreator::solvingIssues, this, &StalledIssuesReceiver::solvingIssues);
@@ -1099,6 +1103,62 @@ void StalledIssuesModel::sendFixingIssuesMessage(int issue, int totalIssues)
     emit updateLoadingMessage(info);
 }
 
+QList<StalledIssuesModel::SolveListItem>
+    StalledIssuesModel::getIssuesToSolve(const QModelIndexList& indexes)
+{
+    QList<SolveListItem> items;
+    items.reserve(indexes.size());
+
+    QSet<int> rows;
+    {
+        // One lock for the whole list instead of one per issue
+        QReadLocker lock(&mModelMutex);
+        for (const auto& index: indexes)
+        {
+            auto row(getSolveIssueIndex(index).row());
+            if (row >= 0 && row < mStalledIssues.size() && !rows.contains(row))
+            {
+                rows.insert(row);
+                SolveListItem item;
+                item.row = row;
+                item.issue = mStalledIssues.at(row);
+                items.append(item);
+            }
+        }
+    }
+
+    // Issues of the same sync and folder are solved together, so the external changes checks
+    // and the SDK hit the same folders and nodes one after the other
+    for (auto& item: items)
+    {
+        if (auto issue = item.issue.consultData())
+        {
+            item.syncId = issue->firstSyncId();
+            if (issue->consultLocalData())
+            {
+                item.folderPath = issue->consultLocalData()->getNativePath();
+            }
+            else if (issue->consultCloudData())
+            {
+                item.folderPath = issue->consultCloudData()->getNativePath();
+            }
+        }
+    }
+
+    std::stable_sort(items.begin(),
+                     items.end(),
+                     [](const SolveListItem& item1, const SolveListItem& item2)
+                     {
+                         if (item1.syncId != item2.syncId)
+                         {
+                             return item1.syncId < item2.syncId;
+                         }
+                         return item1.folderPath < item2.folderPath;
+                     });
+
+    return items;
+}
+
 void StalledIssuesModel::solveListOfIssues(const SolveListInfo &info)
 {
     //Don´t block UI if the issue is being solved async
@@ -1113,72 +1173,147 @@ void StalledIssuesModel::solveListOfIssues(const SolveListInfo &info)
             info.startFunc();
         }
 
+        auto items(getIssuesToSolve(info.indexes));
+
         StalledIssuesCreator::IssuesCount count;
         int issuesExternallyChanged(0);
-        auto totalRows(info.indexes.size());
-        foreach(auto index, info.indexes)
+        auto totalRows(items.size());
+
+        // Only runs which block the UI can be stopped by the user, so only they are resumed
+        if (info.async)
+        {
+            mSolveCheckpoint.clear();
+        }
+        else
         {
-            if (checkIfUserStopSolving())
+            QList<std::shared_ptr<const StalledIssue>> selection;
+            for (const auto& item: items)
             {
-                break;
+                selection.append(item.issue.consultData());
             }
 
-            // Don´t block the UI if the issue is being solve asynchronously
-            if (!info.async)
+            if (mSolveCheckpoint.begin(qMakePair(info.action, info.actionOption), selection))
             {
-                sendFixingIssuesMessage(count.currentIssueBeingSolved, static_cast<int>(totalRows));
+                count = mSolveCheckpoint.getProgress().count;
+                issuesExternallyChanged = mSolveCheckpoint.getProgress().issuesExternallyChanged;
+                totalRows = mSolveCheckpoint.getIssuesCount();
             }
+        }
+
+        QElapsedTimer progressTimer;
+        bool stopped(false);
 
-            if (mThreadFinished)
+        for (int batchStart = 0; batchStart < items.size() && !stopped;
+             batchStart += SOLVE_BATCH_SIZE)
+        {
+            auto batchEnd(std::min(batchStart + SOLVE_BATCH_SIZE, items.size()));
+
+            // The failed issues of the batch leave the failed list with a single write lock. They
+            // go back to it if they fail again, or if the run stops before they are solved
+            FailedIssuesBatch<StalledIssueVariant, const StalledIssue*> failedBatch;
+            QSet<const StalledIssue*> failedIssues;
+            for (int pos = batchStart; pos < batchEnd; ++pos)
             {
-                return;
+                auto issue(items.at(pos).issue.consultData());
+                if (issue && issue->isFailed() && !mSolveCheckpoint.isProcessed(issue.get()))
+                {
+                    failedIssues.insert(issue.get());
+                }
             }
 
-            auto potentialIndex = getSolveIssueIndex(index);
-            mModelMutex.lockForRead();
-            auto issue(mStalledIssues.at(potentialIndex.row()));
-            mModelMutex.unlock();
+            if (!failedIssues.isEmpty())
+            {
+                QWriteLocker lock(&mModelMutex);
+                auto takenCount(failedBatch.take(mFailedStalledIssues,
+                                                 failedIssues,
+                                                 [](const StalledIssueVariant& failedIssue)
+                                                 {
+                                                     return failedIssue.consultData().get();
+                                                 }));
+                mCountByFilterCriterion[static_cast<int>(
+                    StalledIssueFilterCriterion::FAILED_CONFLICTS)] -= takenCount;
+            }
 
-            if (issue.getData())
+            for (int pos = batchStart; pos < batchEnd; ++pos)
             {
-                if (issue.getData()->isFailed())
+                if (checkIfUserStopSolving())
                 {
-                    QWriteLocker lock(&mModelMutex);
-                    mFailedStalledIssues.removeOne(issue);
-                    mCountByFilterCriterion[static_cast<int>(
-                        StalledIssueFilterCriterion::FAILED_CONFLICTS)]--;
+                    stopped = true;
+                    break;
                 }
 
-                if (issue.getData()->checkForExternalChanges(mStalledIssuesReceiver))
+                // Don´t block the UI if the issue is being solve asynchronously
+                // The progress is not sent for every issue, it would flood the UI thread
+                if (!info.async &&
+                    (!progressTimer.isValid() ||
+                     progressTimer.elapsed() >= SOLVE_PROGRESS_MESSAGE_INTERVAL_MS))
                 {
-                    issuesExternallyChanged++;
-                    count.issuesFailed++;
+                    sendFixingIssuesMessage(count.currentIssueBeingSolved, static_cast<int>(totalRows));
+                    progressTimer.start();
                 }
-                else
+
+                if (mThreadFinished)
+                {
+                    return;
+                }
+
+                const auto& item(items.at(pos));
+                auto issue(item.issue);
+
+                if (issue.getData() && !mSolveCheckpoint.isProcessed(issue.getData().get()))
                 {
-                    if (info.solveFunc)
+                    if (issue.getData()->checkForExternalChanges(mStalledIssuesReceiver))
                     {
-                        auto result(info.solveFunc(potentialIndex.row()));
-                        if (!info.async)
+                        issuesExternallyChanged++;
+                        count.issuesFailed++;
+                    }
+                    else
+                    {
+                        if (info.solveFunc)
                         {
-                            if (result)
+                            failedBatch.release(issue.getData().get());
+                            auto result(info.solveFunc(item.row));
+                            if (!info.async)
                             {
-                                count.issuesFixed++;
-                            }
-                            else
-                            {
-                                count.issuesFailed++;
+                                if (result)
+                                {
+                                    count.issuesFixed++;
+                                }
+                                else
+                                {
+                                    count.issuesFailed++;
+                                }
+                                issueSolvingFinished(issue.getData().get(), result);
                             }
-                            issueSolvingFinished(issue.getData().get(), result);
                         }
                     }
+
+                    if (!info.async)
+                    {
+                        mSolveCheckpoint.setProcessed(issue.getData().get());
+                    }
+                    count.currentIssueBeingSolved++;
                 }
             }
-            count.currentIssueBeingSolved++;
+
+            restoreFailedIssues(failedBatch);
         }
 
         if (!info.async)
         {
+            if (stopped)
+            {
+                // Keep what has been done, so solving the same issues again skips it
+                SolveProgress progress;
+                progress.count = count;
+                progress.issuesExternallyChanged = issuesExternallyChanged;
+                mSolveCheckpoint.stop(progress);
+            }
+            else
+            {
+                mSolveCheckpoint.clear();
+            }
+
             if (issuesExternallyChanged > 0)
             {
                 unBlockUi();
@@ -1324,6 +1459,24 @@ bool StalledIssuesModel::issueFailed(const StalledIssue* issue)
     return false;
 }
 
+void StalledIssuesModel::restoreFailedIssues(
+    FailedIssuesBatch<StalledIssueVariant, const StalledIssue*>& batch)
+{
+    // Issues which changed externally are potentially solved now, so they do not go back
+    auto issues(batch.takeUnreleased(
+        [](const StalledIssueVariant& issue)
+        {
+            return issue.consultData() && issue.consultData()->isFailed();
+        }));
+    if (!issues.isEmpty())
+    {
+        QWriteLocker lock(&mModelMutex);
+        mFailedStalledIssues.append(issues);
+        mCountByFilterCriterion[static_cast<int>(StalledIssueFilterCriterion::FAILED_CONFLICTS)] +=
+            issues.size();
+    }
+}
+
 void StalledIssuesModel::chooseSideManually(bool remote, const QModelIndexList& list)
 {
     auto resolveIssue = [this, remote](int row) -> bool
@@ -1346,7 +1499,9 @@ void StalledIssuesModel::chooseSideManually(bool remote, const QModelIndexList&
         return result;
     };
 
-    SolveListInfo info(list, resolveIssue);
+    SolveListInfo info(list,
+                       remote ? SolveAction::CHOOSE_REMOTE_SIDE : SolveAction::CHOOSE_LOCAL_SIDE,
+                       resolveIssue);
     solveListOfIssues(info);
 }
 
@@ -1373,7 +1528,7 @@ void StalledIssuesModel::chooseBothSides(const QModelIndexList& list)
         return result;
     };
 
-    SolveListInfo info(list, resolveIssue);
+    SolveListInfo info(list, SolveAction::CHOOSE_BOTH_SIDES, resolveIssue);
     solveListOfIssues(info);
 }
 
@@ -1411,7 +1566,7 @@ void StalledIssuesModel::chooseRemoteForBackups(const QModelIndexList& list)
         }
     };
 
-    SolveListInfo info(list, resolveIssue);
+    SolveListInfo info(list, SolveAction::CHOOSE_REMOTE_FOR_BACKUPS, resolveIssue);
     info.finishFunc = finishFunc;
     solveListOfIssues(info);
 }
@@ -1435,7 +1590,7 @@ void StalledIssuesModel::chooseLastModifiedLocalRemoteIssues(const QModelIndexLi
         return result;
     };
 
-    SolveListInfo info(list, resolveIssue);
+    SolveListInfo info(list, SolveAction::CHOOSE_LAST_MODIFIED_SIDE, resolveIssue);
     solveListOfIssues(info);
 }
 
@@ -1528,7 +1683,7 @@ void StalledIssuesModel::ignoreItems(const QModelIndexList& list)
     };
 
 
-    SolveListInfo info(list, resolveIssue);
+    SolveListInfo info(list, SolveAction::IGNORE_ITEMS, resolveIssue);
     info.finishFunc = finishFunc;
     solveListOfIssues(info);
 }
@@ -1643,7 +1798,7 @@ void StalledIssuesModel::ignoreSymLinks()
         }
     };
 
-    SolveListInfo info(list, resolveIssue);
+    SolveListInfo info(list, SolveAction::IGNORE_SYMLINKS, resolveIssue);
     info.startFunc = startIssue;
     info.finishFunc = finishIssue;
     solveListOfIssues(info);
@@ -1679,7 +1834,7 @@ void StalledIssuesModel::fixFingerprint(const QModelIndexList& list)
         return true;
     };
 
-    SolveListInfo info(list, joinFingerprintIssues);
+    SolveListInfo info(list, SolveAction::FIX_FINGERPRINT, joinFingerprintIssues);
     info.finishFunc = finishIssue;
     solveListOfIssues(info);
 }
@@ -1704,7 +1859,9 @@ void StalledIssuesModel::sendReportForUnknownDownloadIssue(const QModelIndex& in
         }
     };
 
-    SolveListInfo info(QModelIndexList() << index, resolveIssue);
+    SolveListInfo info(QModelIndexList() << index,
+                       SolveAction::SEND_UNKNOWN_DOWNLOAD_REPORT,
+                       resolveIssue);
     info.async = true;
     solveListOfIssues(info);
 }
@@ -1722,7 +1879,7 @@ void StalledIssuesModel::fixFolderMatchedAgainstFile(const QModelIndexList& list
         return false;
     };
 
-    SolveListInfo info(list, resolveIssue);
+    SolveListInfo info(list, SolveAction::FIX_FOLDER_MATCHED_AGAINST_FILE, resolveIssue);
     solveListOfIssues(info);
 }
 
@@ -1747,7 +1904,7 @@ void StalledIssuesModel::fixMoveOrRenameCannotOccur(const QModelIndexList& index
         return true;
     };
 
-    SolveListInfo info(indexes, resolveIssue);
+    SolveListInfo info(indexes, SolveAction::FIX_MOVE_OR_RENAME, resolveIssue);
     info.async = true;
     solveListOfIssues(info);
 }
@@ -1778,7 +1935,8 @@ void StalledIssuesModel::semiAutoSolveNameConflictIssues(const QModelIndexList&
         return result;
     };
 
-    SolveListInfo info(list, resolveIssue);
+    SolveListInfo info(list, SolveAction::SEMI_AUTO_SOLVE_NAME_CONFLICTS, resolveIssue);
+    info.actionOption = option;
     solveListOfIssues(info);
 }
 
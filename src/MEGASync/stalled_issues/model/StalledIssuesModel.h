@@ -1,8 +1,10 @@
 #ifndef STALLEDISSUESMODEL_H
 #define STALLEDISSUESMODEL_H
 
+#include "FailedIssuesBatch.h"
 #include "MessageDialogOpener.h"
 #include "MoveOrRenameCannotOccurIssue.h"
+#include "SolveCheckpoint.h"
 #include "QTMegaGlobalListener.h"
 #include "QTMegaRequestListener.h"
 #include "StalledIssue.h"
@@ -297,10 +299,31 @@ private:
 
     void sendFixingIssuesMessage(int issue, int totalIssues);
 
+    // What a solving run does, so a stopped run is only resumed by the same action
+    enum class SolveAction
+    {
+        NONE,
+        CHOOSE_LOCAL_SIDE,
+        CHOOSE_REMOTE_SIDE,
+        CHOOSE_BOTH_SIDES,
+        CHOOSE_REMOTE_FOR_BACKUPS,
+        CHOOSE_LAST_MODIFIED_SIDE,
+        IGNORE_ITEMS,
+        IGNORE_SYMLINKS,
+        FIX_FINGERPRINT,
+        SEND_UNKNOWN_DOWNLOAD_REPORT,
+        FIX_FOLDER_MATCHED_AGAINST_FILE,
+        FIX_MOVE_OR_RENAME,
+        SEMI_AUTO_SOLVE_NAME_CONFLICTS
+    };
+
     struct SolveListInfo
     {
-        SolveListInfo(const QModelIndexList& uIndexes, std::function<bool(int)> uSolveFunc)
+        SolveListInfo(const QModelIndexList& uIndexes,
+                      SolveAction uAction,
+                      std::function<bool(int)> uSolveFunc)
             : indexes(uIndexes),
+            action(uAction),
             solveFunc(uSolveFunc)
         {
             Q_ASSERT(solveFunc);
@@ -308,16 +331,38 @@ private:
 
         bool async = false;
         QModelIndexList indexes;
+        SolveAction action = SolveAction::NONE;
+        // Option of the action, when the same action can solve the issues in several ways
+        uint actionOption = 0;
         std::function<bool(int)> solveFunc = nullptr;
         std::function<void ()> startFunc = nullptr;
         std::function<void (int, bool)> finishFunc = nullptr;
     };
 
+    // Issues of a list to solve, by source row
+    struct SolveListItem
+    {
+        int row = -1;
+        StalledIssueVariant issue;
+        mega::MegaHandle syncId = mega::INVALID_HANDLE;
+        // Folder which contains the issue, as getNativePath() leaves the file name out
+        QString folderPath;
+    };
+
+    // Progress of a solving run, kept by the checkpoint when the user stops it
+    struct SolveProgress
+    {
+        StalledIssuesCreator::IssuesCount count;
+        int issuesExternallyChanged = 0;
+    };
+
+    QList<SolveListItem> getIssuesToSolve(const QModelIndexList& indexes);
     void solveListOfIssues(const SolveListInfo& info);
     bool issueSolvingFinished(const StalledIssue* issue);
     bool issueSolvingFinished(StalledIssue* issue, bool wasSuccessful);
     bool issueSolved(const StalledIssue* issue);
     bool issueFailed(const StalledIssue* issue);
+    void restoreFailedIssues(FailedIssuesBatch<StalledIssueVariant, const StalledIssue*>& batch);
     
     StalledIssuesModel(const StalledIssuesModel&) = delete;
     void operator=(const StalledIssuesModel&) = delete;
@@ -357,6 +402,10 @@ private:
     std::atomic_bool mSolvingIssues {false};
     std::atomic_bool mIssuesSolved {false};
     std::atomic_bool mSolvingIssuesStopped {false};
+    // Only used from the receiver thread
+    SolveCheckpoint<QPair<SolveAction, uint>, StalledIssue, SolveProgress> mSolveCheckpoint;
+    static constexpr int SOLVE_BATCH_SIZE = 100;
+    static constexpr qint64 SOLVE_PROGRESS_MESSAGE_INTERVAL_MS = 100;
 
     //SyncDisable for backups
     QList<std::shared_ptr<SyncSettings>> mSyncsToDisable;
@@ -27,6 +27,8 @@ set(DESKTOP_APP_STALLED_ISSUES_HEADERS
     ${CMAKE_CURRENT_LIST_DIR}/model/NameConflictStalledIssue.h
     ${CMAKE_CURRENT_LIST_DIR}/model/FolderMatchedAgainstFileIssue.h
     ${CMAKE_CURRENT_LIST_DIR}/model/StalledIssuesUtilities.h
+    ${CMAKE_CURRENT_LIST_DIR}/model/FailedIssuesBatch.h
+    ${CMAKE_CURRENT_LIST_DIR}/model/SolveCheckpoint.h
     ${CMAKE_CURRENT_LIST_DIR}/model/StalledIssuesModel.h
     ${CMAKE_CURRENT_LIST_DIR}/model/StalledIssue.h
     ${CMAKE_CURRENT_LIST_DIR}/model/StalledIssueHashDiscardTracker.h
@@ -244,6 +244,17 @@ QStringList MegaIgnoreManager::getExcludedExtensions() const
     return extensions;
 }
 
+std::shared_ptr<MegaIgnoreMatcher> MegaIgnoreManager::createMatcher() const
+{
+    auto rules(mRules);
+    if (mIgnoreSymLinkRule)
+    {
+        rules.append(mIgnoreSymLinkRule);
+    }
+
+    return std::make_shared<MegaIgnoreMatcher>(rules);
+}
+
 MegaIgnoreManager::ApplyChangesError MegaIgnoreManager::applyChanges(bool updateExtensionRules, const QStringList& updatedExtensions)
 {
     ApplyChangesError result(ApplyChangesError::NO_UPDATE_NEEDED);
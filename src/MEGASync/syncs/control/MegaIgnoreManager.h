@@ -1,6 +1,7 @@
 #ifndef MEGAIGNOREMANAGER_H
 #define MEGAIGNOREMANAGER_H
 
+#include "MegaIgnoreMatcher.h"
 #include "MegaIgnoreRules.h"
 
 #include <QFile>
@@ -41,6 +42,9 @@ public:
     static MegaIgnoreRule::RuleType getRuleType(const QString& line);
     QStringList getExcludedExtensions() const;
 
+    // Compiles the current (maybe not yet applied) rules, to evaluate them locally
+    std::shared_ptr<MegaIgnoreMatcher> createMatcher() const;
+
     void parseIgnoresFile();
 
     std::shared_ptr<MegaIgnoreNameRule> addIgnoreSymLinksRule();
@@ -0,0 +1,383 @@
+#include "MegaIgnoreMatcher.h"
+
+#include "megaapi.h"
+
+#include <algorithm>
+
+namespace
+{
+const QChar PATH_SEPARATOR(QLatin1Char('/'));
+const QChar ANY_CHARACTERS(QLatin1Char('*'));
+
+bool hasGlobElements(const QString& pattern)
+{
+    static const QRegularExpression globElements(QLatin1String("[*?\\[\\\\]"));
+    return pattern.contains(globElements);
+}
+}
+
+void MegaIgnoreMatcher::Trie::insert(const QString& key, int priority, bool reversed)
+{
+    int node(0);
+    for (int index = 0; index < key.size(); ++index)
+    {
+        const QChar chr(key.at(reversed ? key.size() - 1 - index : index));
+        auto child(mNodes.at(node).children.value(chr, -1));
+        if (child < 0)
+        {
+            child = mNodes.size();
+            mNodes[node].children.insert(chr, child);
+            mNodes.append(Node());
+        }
+        node = child;
+    }
+
+    mNodes[node].priority = std::max(mNodes.at(node).priority, priority);
+}
+
+int MegaIgnoreMatcher::Trie::match(const QString& text, bool reversed) const
+{
+    int node(0);
+    int priority(mNodes.at(node).priority);
+    for (int index = 0; index < text.size(); ++index)
+    {
+        const QChar chr(text.at(reversed ? text.size() - 1 - index : index));
+        const auto& children(mNodes.at(node).children);
+        auto childIt(children.constFind(chr));
+        if (childIt == children.constEnd())
+        {
+            break;
+        }
+
+        node = childIt.value();
+        priority = std::max(priority, mNodes.at(node).priority);
+    }
+
+    return priority;
+}
+
+int MegaIgnoreMatcher::LiteralSet::match(const QString& text) const
+{
+    return std::max({equal.value(text, -1), prefixes.match(text, false), suffixes.match(text, true)});
+}
+
+int MegaIgnoreMatcher::MatchSet::match(const QString& text, const QString& foldedText) const
+{
+    auto priority(std::max(caseSensitive.match(text), caseInsensitive.match(foldedText)));
+
+    // The alternatives are sorted by priority, so the expression is only run if it can win
+    if (!expressionPriorities.isEmpty() && expressionPriorities.first() > priority)
+    {
+        auto expressionMatch(expression.match(text));
+        if (expressionMatch.hasMatch())
+        {
+            for (int index = 0; index < expressionGroups.size(); ++index)
+            {
+                if (expressionMatch.capturedStart(expressionGroups.at(index)) >= 0)
+                {
+                    priority = std::max(priority, expressionPriorities.at(index));
+                    break;
+                }
+            }
+        }
+    }
+
+    return priority;
+}
+
+MegaIgnoreMatcher::MegaIgnoreMatcher(const QList<std::shared_ptr<MegaIgnoreRule>>& rules):
+    mLowLimit(-1),
+    mHighLimit(-1)
+{
+    for (const auto& rule: rules)
+    {
+        if (!rule || rule->isCommented() || rule->isDeleted() || !rule->isValid())
+        {
+            continue;
+        }
+
+        if (auto sizeRule = std::dynamic_pointer_cast<MegaIgnoreSizeRule>(rule))
+        {
+            addSizeRule(sizeRule);
+        }
+        else if (auto nameRule = std::dynamic_pointer_cast<MegaIgnoreNameRule>(rule))
+        {
+            addNameRule(nameRule, mExcludedByPriority.size());
+        }
+    }
+
+    for (auto& matchSets: mMatchSets)
+    {
+        for (auto& matchSet: matchSets)
+        {
+            if (matchSet.expressionParts.isEmpty())
+            {
+                continue;
+            }
+
+            // Highest priority first, the first alternative matching the whole text is the one
+            // captured
+            std::reverse(matchSet.expressionParts.begin(), matchSet.expressionParts.end());
+            std::reverse(matchSet.expressionPriorities.begin(), matchSet.expressionPriorities.end());
+
+            int group(1);
+            for (const auto& part: std::as_const(matchSet.expressionParts))
+            {
+                matchSet.expressionGroups.append(group);
+                group += 1 + QRegularExpression(part).captureCount();
+            }
+
+            QString expression;
+            for (const auto& part: std::as_const(matchSet.expressionParts))
+            {
+                expression.append(expression.isEmpty() ? QLatin1String("\\A(?:(") :
+                                                         QLatin1String(")|("));
+                expression.append(part);
+            }
+            expression.append(QLatin1String("))\\z"));
+
+            matchSet.expression.setPattern(expression);
+            matchSet.expression.optimize();
+        }
+    }
+}
+
+bool MegaIgnoreMatcher::isExcluded(const QString& relativePath, NodeType type, long long size) const
+{
+    auto separator(relativePath.lastIndexOf(PATH_SEPARATOR));
+    if (separator > 0 && isFolderExcluded(relativePath.left(separator)))
+    {
+        return true;
+    }
+
+    return isNodeExcluded(relativePath, type, size);
+}
+
+bool MegaIgnoreMatcher::isNodeExcluded(const QString& relativePath,
+                                       NodeType type,
+                                       long long size) const
+{
+    const auto& matchSets(mMatchSets.at(static_cast<size_t>(type)));
+
+    auto separator(relativePath.lastIndexOf(PATH_SEPARATOR));
+    const auto name(relativePath.mid(separator + 1));
+    const auto foldedName(name.toCaseFolded());
+
+    auto priority(matchSets.at(NAME).match(name, foldedName));
+    if (separator < 0)
+    {
+        priority = std::max(priority, matchSets.at(LOCAL_NAME).match(name, foldedName));
+    }
+    priority = std::max(priority,
+                        matchSets.at(PATH).match(relativePath, relativePath.toCaseFolded()));
+
+    if (priority >= 0)
+    {
+        return mExcludedByPriority.at(priority);
+    }
+
+    if (type == NodeType::FILE && size >= 0)
+    {
+        return (mLowLimit >= 0 && size < mLowLimit) || (mHighLimit >= 0 && size > mHighLimit);
+    }
+
+    return false;
+}
+
+bool MegaIgnoreMatcher::isEmpty() const
+{
+    return mExcludedByPriority.isEmpty() && mLowLimit < 0 && mHighLimit < 0;
+}
+
+void MegaIgnoreMatcher::addNameRule(const std::shared_ptr<MegaIgnoreNameRule>& rule, int priority)
+{
+    const auto ruleText(rule->getModifiedRule());
+    const auto separator(ruleText.indexOf(QLatin1Char(':')));
+    if (separator < 0)
+    {
+        return;
+    }
+    const auto pattern(ruleText.mid(separator + 1));
+
+    QList<NodeType> types;
+    switch (rule->getTarget())
+    {
+        case MegaIgnoreNameRule::Target::f:
+            types << NodeType::FILE;
+            break;
+        case MegaIgnoreNameRule::Target::d:
+            types << NodeType::FOLDER;
+            break;
+        case MegaIgnoreNameRule::Target::s:
+            types << NodeType::SYMLINK;
+            break;
+        default:
+            types << NodeType::FILE << NodeType::FOLDER << NodeType::SYMLINK;
+            break;
+    }
+
+    Subject subject(NAME);
+    if (rule->getType() == MegaIgnoreNameRule::Type::N)
+    {
+        subject = LOCAL_NAME;
+    }
+    else if (rule->getType() == MegaIgnoreNameRule::Type::p)
+    {
+        subject = PATH;
+    }
+
+    // Without strategy, the SDK matches globs case insensitively
+    const auto strategy(rule->getStrategy());
+    const bool isRegularExpression(strategy == MegaIgnoreNameRule::Strategy::r ||
+                                   strategy == MegaIgnoreNameRule::Strategy::R);
+    const bool isCaseSensitive(strategy == MegaIgnoreNameRule::Strategy::G ||
+                               strategy == MegaIgnoreNameRule::Strategy::R);
+
+    QString expressionPart;
+    if (isRegularExpression)
+    {
+        if (!QRegularExpression(pattern).isValid())
+        {
+            mega::MegaApi::log(mega::MegaApi::LOG_LEVEL_WARNING,
+                               QString::fromUtf8("Ignoring invalid .megaignore expression: %1")
+                                   .arg(pattern)
+                                   .toUtf8()
+                                   .constData());
+            return;
+        }
+        expressionPart = pattern;
+    }
+    else
+    {
+        const auto literal(QString(pattern).remove(ANY_CHARACTERS));
+        const auto wildcards(pattern.count(ANY_CHARACTERS));
+        const bool isLiteral(!hasGlobElements(literal));
+        const bool isEqual(isLiteral && wildcards == 0);
+        const bool isSuffix(isLiteral && wildcards == 1 && pattern.startsWith(ANY_CHARACTERS));
+        const bool isPrefix(isLiteral && wildcards == 1 && pattern.endsWith(ANY_CHARACTERS));
+
+        if (isEqual || isSuffix || isPrefix)
+        {
+            const auto key(isCaseSensitive ? literal : literal.toCaseFolded());
+            for (auto type: std::as_const(types))
+            {
+                auto& matchSet(mMatchSets[static_cast<size_t>(type)][subject]);
+                auto& literals(isCaseSensitive ? matchSet.caseSensitive : matchSet.caseInsensitive);
+                if (isEqual)
+                {
+                    literals.equal.insert(key, priority);
+                }
+                else if (isSuffix)
+                {
+                    literals.suffixes.insert(key, priority, true);
+                }
+                else
+                {
+                    literals.prefixes.insert(key, priority, false);
+                }
+            }
+        }
+        else
+        {
+            expressionPart = globToRegularExpression(pattern);
+        }
+    }
+
+    if (!expressionPart.isEmpty())
+    {
+        expressionPart.prepend(isCaseSensitive ? QLatin1String("(?-i:") : QLatin1String("(?i:"));
+        expressionPart.append(QLatin1Char(')'));
+
+        for (auto type: std::as_const(types))
+        {
+            auto& matchSet(mMatchSets[static_cast<size_t>(type)][subject]);
+            matchSet.expressionParts.append(expressionPart);
+            matchSet.expressionPriorities.append(priority);
+        }
+    }
+
+    mExcludedByPriority.append(rule->getClass() == MegaIgnoreNameRule::Class::EXCLUDE);
+}
+
+void MegaIgnoreMatcher::addSizeRule(const std::shared_ptr<MegaIgnoreSizeRule>& rule)
+{
+    const auto limit(static_cast<long long>(rule->valueInBytes()));
+    if (rule->getThreshold() == MegaIgnoreSizeRule::Threshold::LOW)
+    {
+        mLowLimit = limit;
+    }
+    else
+    {
+        mHighLimit = limit;
+    }
+}
+
+QString MegaIgnoreMatcher::globToRegularExpression(const QString& glob)
+{
+    QString expression;
+    expression.reserve(glob.size() * 2);
+
+    for (int index = 0; index < glob.size(); ++index)
+    {
+        const QChar chr(glob.at(index));
+        if (chr == ANY_CHARACTERS)
+        {
+            expression.append(QLatin1String(".*"));
+        }
+        else if (chr == QLatin1Char('?'))
+        {
+            expression.append(QLatin1Char('.'));
+        }
+        else if (chr == QLatin1Char('\\') && index + 1 < glob.size())
+        {
+            expression.append(QRegularExpression::escape(glob.mid(++index, 1)));
+        }
+        else if (chr == QLatin1Char('['))
+        {
+            // A "]" right after the opening bracket (or its negation) is part of the set
+            auto setStart(index + 1);
+            if (setStart < glob.size() &&
+                (glob.at(setStart) == QLatin1Char('!') || glob.at(setStart) == QLatin1Char('^')))
+            {
+                ++setStart;
+            }
+            auto setEnd(glob.indexOf(QLatin1Char(']'), setStart + 1));
+            if (setEnd < 0)
+            {
+                expression.append(QLatin1String("\\["));
+                continue;
+            }
+
+            auto set(glob.mid(index + 1, setEnd - index - 1));
+            if (set.startsWith(QLatin1Char('!')))
+            {
+                set.replace(0, 1, QLatin1Char('^'));
+            }
+            set.replace(QLatin1String("\\"), QLatin1String("\\\\"));
+            expression.append(QLatin1Char('[') + set + QLatin1Char(']'));
+            index = setEnd;
+        }
+        else
+        {
+            expression.append(QRegularExpression::escape(QString(chr)));
+        }
+    }
+
+    return expression;
+}
+
+bool MegaIgnoreMatcher::isFolderExcluded(const QString& relativePath) const
+{
+    auto cachedIt(mFolderCache.constFind(relativePath));
+    if (cachedIt != mFolderCache.constEnd())
+    {
+        return cachedIt.value();
+    }
+
+    auto separator(relativePath.lastIndexOf(PATH_SEPARATOR));
+    const bool excluded((separator > 0 && isFolderExcluded(relativePath.left(separator))) ||
+                        isNodeExcluded(relativePath, NodeType::FOLDER));
+    mFolderCache.insert(relativePath, excluded);
+
+    return excluded;
+}
@@ -0,0 +1,101 @@
+#ifndef MEGAIGNOREMATCHER_H
+#define MEGAIGNOREMATCHER_H
+
+#include "MegaIgnoreRules.h"
+
+#include <QHash>
+#include <QList>
+#include <QRegularExpression>
+#include <QString>
+#include <QVector>
+
+#include <array>
+#include <memory>
+
+// Compiled form of the rules of a .megaignore file, used to know which local nodes they exclude
+// without asking the SDK. As the SDK does, the last enabled name rule matching a node decides if it
+// is excluded or included, size limits only apply to files no name rule matches, and the contents
+// of an excluded folder are excluded too.
+// The literal patterns of all the rules are merged in hashes and tries, and the globs and regular
+// expressions in a single expression, so matching a node does not depend on the number of rules.
+// Not thread safe: the results of the folders are cached while matching.
+class MegaIgnoreMatcher
+{
+public:
+    enum class NodeType
+    {
+        FILE,
+        FOLDER,
+        SYMLINK
+    };
+
+    explicit MegaIgnoreMatcher(const QList<std::shared_ptr<MegaIgnoreRule>>& rules);
+
+    // Paths are relative to the folder of the .megaignore file, with "/" separators
+    bool isExcluded(const QString& relativePath, NodeType type, long long size = -1) const;
+    // Same as isExcluded, when the parent folder is already known not to be excluded
+    bool isNodeExcluded(const QString& relativePath, NodeType type, long long size = -1) const;
+
+    bool isEmpty() const;
+
+private:
+    enum Subject
+    {
+        NAME,
+        LOCAL_NAME,
+        PATH,
+        SUBJECT_COUNT
+    };
+
+    // Literal keys by character, walked from the start of the text (prefixes) or from the end
+    // (suffixes). Each node keeps the highest priority of the rules ending in it
+    class Trie
+    {
+    public:
+        void insert(const QString& key, int priority, bool reversed);
+        int match(const QString& text, bool reversed) const;
+
+    private:
+        struct Node
+        {
+            QHash<QChar, int> children;
+            int priority = -1;
+        };
+
+        QVector<Node> mNodes{Node()};
+    };
+
+    struct LiteralSet
+    {
+        QHash<QString, int> equal;
+        Trie prefixes;
+        Trie suffixes;
+
+        int match(const QString& text) const;
+    };
+
+    struct MatchSet
+    {
+        LiteralSet caseSensitive;
+        LiteralSet caseInsensitive;
+        QStringList expressionParts;
+        QVector<int> expressionPriorities;
+        QVector<int> expressionGroups;
+        QRegularExpression expression;
+
+        int match(const QString& text, const QString& foldedText) const;
+    };
+
+    void addNameRule(const std::shared_ptr<MegaIgnoreNameRule>& rule, int priority);
+    void addSizeRule(const std::shared_ptr<MegaIgnoreSizeRule>& rule);
+    static QString globToRegularExpression(const QString& glob);
+    bool isFolderExcluded(const QString& relativePath) const;
+
+    std::array<std::array<MatchSet, SUBJECT_COUNT>, 3> mMatchSets;
+    QVector<bool> mExcludedByPriority;
+    long long mLowLimit;
+    long long mHighLimit;
+    mutable QHash<QString, bool> mFolderCache;
+};
+
+#endif // MEGAIGNOREMATCHER_H
@@ -0,0 +1,213 @@
+#include "MegaIgnorePreview.h"
+
+#include "Utilities.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QPointer>
+
+MegaIgnorePreview::MegaIgnorePreview(QObject* parent):
+    QObject(parent),
+    mScanId(std::make_shared<std::atomic<int>>(0)),
+    mEvaluationId(0),
+    mIsReady(false)
+{
+    mUpdateTimer.setSingleShot(true);
+    mUpdateTimer.setInterval(UPDATE_DELAY_MS);
+    connect(&mUpdateTimer, &QTimer::timeout, this, &MegaIgnorePreview::evaluatePendingMatcher);
+}
+
+MegaIgnorePreview::~MegaIgnorePreview()
+{
+    // Stops the scan in progress, if any
+    ++(*mScanId);
+}
+
+void MegaIgnorePreview::setFolder(const QString& folderPath)
+{
+    if (folderPath == mFolderPath && mTree)
+    {
+        return;
+    }
+
+    mFolderPath = folderPath;
+    mTree.reset();
+    mResult = Result();
+    mTotal = Result();
+    mIsReady = false;
+    ++mEvaluationId;
+    emit previewChanged();
+
+    if (folderPath.isEmpty())
+    {
+        return;
+    }
+
+    const int currentScanId(++(*mScanId));
+    QPointer<MegaIgnorePreview> preview(this);
+    ThreadPoolSingleton::getInstance()->push(
+        [preview, folderPath, scanId = mScanId, currentScanId]()
+        {
+            auto tree(std::make_shared<Tree>());
+            auto total(scanFolder(folderPath, QString(), *tree, *scanId, currentScanId));
+            if (scanId->load() != currentScanId)
+            {
+                return;
+            }
+
+            Utilities::queueFunctionInAppThread(
+                [preview, tree, total, scanId, currentScanId]()
+                {
+                    if (preview && scanId->load() == currentScanId)
+                    {
+                        preview->mTree = tree;
+                        preview->mTotal = total;
+                        preview->evaluatePendingMatcher();
+                    }
+                });
+        });
+}
+
+void MegaIgnorePreview::update(std::shared_ptr<MegaIgnoreMatcher> matcher)
+{
+    mPendingMatcher = matcher;
+    mUpdateTimer.start();
+}
+
+bool MegaIgnorePreview::isReady() const
+{
+    return mIsReady;
+}
+
+int MegaIgnorePreview::getExcludedFiles() const
+{
+    return mResult.files;
+}
+
+long long MegaIgnorePreview::getExcludedBytes() const
+{
+    return mResult.bytes;
+}
+
+int MegaIgnorePreview::getTotalFiles() const
+{
+    return mTotal.files;
+}
+
+long long MegaIgnorePreview::getTotalBytes() const
+{
+    return mTotal.bytes;
+}
+
+MegaIgnorePreview::Result MegaIgnorePreview::scanFolder(const QString& folderPath,
+                                                        const QString& relativePath,
+                                                        Tree& tree,
+                                                        const std::atomic<int>& scanId,
+                                                        int currentScanId)
+{
+    Result total;
+
+    QDir folder(relativePath.isEmpty() ? folderPath :
+                                         folderPath + QLatin1Char('/') + relativePath);
+    const auto entries(folder.entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot |
+                                            QDir::Hidden | QDir::System));
+    for (const auto& entryInfo: entries)
+    {
+        if (scanId.load() != currentScanId || ThreadPool::isThreadInterrupted())
+        {
+            break;
+        }
+
+        Entry entry;
+        entry.relativePath = relativePath.isEmpty() ?
+                                 entryInfo.fileName() :
+                                 relativePath + QLatin1Char('/') + entryInfo.fileName();
+        if (entryInfo.isSymLink())
+        {
+            entry.type = MegaIgnoreMatcher::NodeType::SYMLINK;
+        }
+        else if (entryInfo.isDir())
+        {
+            entry.type = MegaIgnoreMatcher::NodeType::FOLDER;
+        }
+        else
+        {
+            entry.size = entryInfo.size();
+            entry.subtreeFiles = 1;
+            entry.subtreeBytes = entry.size;
+        }
+
+        const auto index(tree.size());
+        tree.append(entry);
+
+        // Symlinks are not followed, the SDK does not sync their targets
+        if (entry.type == MegaIgnoreMatcher::NodeType::FOLDER)
+        {
+            auto contents(scanFolder(folderPath, entry.relativePath, tree, scanId, currentScanId));
+            tree[index].subtreeFiles = contents.files;
+            tree[index].subtreeBytes = contents.bytes;
+        }
+        tree[index].subtreeEnd = tree.size();
+
+        total.files += tree.at(index).subtreeFiles;
+        total.bytes += tree.at(index).subtreeBytes;
+    }
+
+    return total;
+}
+
+MegaIgnorePreview::Result MegaIgnorePreview::evaluate(const Tree& tree,
+                                                      const MegaIgnoreMatcher& matcher)
+{
+    Result excluded;
+
+    int index(0);
+    while (index < tree.size())
+    {
+        const auto& entry(tree.at(index));
+        // The parents are evaluated first, the contents of excluded folders are not visited
+        if (matcher.isNodeExcluded(entry.relativePath, entry.type, entry.size))
+        {
+            excluded.files += entry.subtreeFiles;
+            excluded.bytes += entry.subtreeBytes;
+            index = entry.subtreeEnd;
+        }
+        else
+        {
+            ++index;
+        }
+    }
+
+    return excluded;
+}
+
+void MegaIgnorePreview::evaluatePendingMatcher()
+{
+    // The matcher is kept until the folder is scanned
+    if (!mTree || !mPendingMatcher)
+    {
+        return;
+    }
+
+    auto matcher(std::move(mPendingMatcher));
+    mPendingMatcher.reset();
+
+    const int currentEvaluationId(++mEvaluationId);
+    QPointer<MegaIgnorePreview> preview(this);
+    ThreadPoolSingleton::getInstance()->push(
+        [preview, matcher, tree = mTree, currentEvaluationId]()
+        {
+            auto excluded(evaluate(*tree, *matcher));
+
+            Utilities::queueFunctionInAppThread(
+                [preview, excluded, currentEvaluationId]()
+                {
+                    if (preview && preview->mEvaluationId == currentEvaluationId)
+                    {
+                        preview->mResult = excluded;
+                        preview->mIsReady = true;
+                        emit preview->previewChanged();
+                    }
+                });
+        });
+}
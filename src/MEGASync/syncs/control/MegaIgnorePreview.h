@@ -0,0 +1,79 @@
+#ifndef MEGAIGNOREPREVIEW_H
+#define MEGAIGNOREPREVIEW_H
+
+#include "MegaIgnoreMatcher.h"
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+
+#include <atomic>
+#include <memory>
+
+// Counts the files of a local folder (and their size) which the rules being edited would exclude.
+// The folder is scanned once in the background; every time the rules change they are compiled and
+// evaluated against the scanned tree, skipping the contents of the excluded folders.
+class MegaIgnorePreview : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MegaIgnorePreview(QObject* parent = nullptr);
+    ~MegaIgnorePreview();
+
+    void setFolder(const QString& folderPath);
+    // The matcher is evaluated in a worker thread, after a short delay to group quick edits
+    void update(std::shared_ptr<MegaIgnoreMatcher> matcher);
+
+    bool isReady() const;
+    int getExcludedFiles() const;
+    long long getExcludedBytes() const;
+    int getTotalFiles() const;
+    long long getTotalBytes() const;
+
+    static constexpr int UPDATE_DELAY_MS = 200;
+
+signals:
+    void previewChanged();
+
+private:
+    // Nodes of the folder in depth-first order, so the contents of a folder are the entries
+    // between it and subtreeEnd
+    struct Entry
+    {
+        QString relativePath;
+        MegaIgnoreMatcher::NodeType type = MegaIgnoreMatcher::NodeType::FILE;
+        long long size = 0;
+        int subtreeEnd = 0;
+        int subtreeFiles = 0;
+        long long subtreeBytes = 0;
+    };
+    using Tree = QVector<Entry>;
+
+    struct Result
+    {
+        int files = 0;
+        long long bytes = 0;
+    };
+
+    static Result scanFolder(const QString& folderPath,
+                             const QString& relativePath,
+                             Tree& tree,
+                             const std::atomic<int>& scanId,
+                             int currentScanId);
+    static Result evaluate(const Tree& tree, const MegaIgnoreMatcher& matcher);
+    void evaluatePendingMatcher();
+
+    QString mFolderPath;
+    std::shared_ptr<const Tree> mTree;
+    std::shared_ptr<MegaIgnoreMatcher> mPendingMatcher;
+    std::shared_ptr<std::atomic<int>> mScanId;
+    int mEvaluationId;
+    QTimer mUpdateTimer;
+    Result mResult;
+    Result mTotal;
+    bool mIsReady;
+};
+
+#endif // MEGAIGNOREPREVIEW_H
@@ -123,7 +123,9 @@ public:
     QString getModifiedRule() const override;
     QString getDisplayText() const override { return mPattern; }
     RuleType ruleType() const override { return RuleType::NAMERULE;}
-    Target getTarget() { return mTarget; }
+    Target getTarget() const { return mTarget; }
+    Class getClass() const { return mClass; }
+    Type getType() const { return mType; }
     void setTarget(Target target);
     WildCardType getWildCardType();
     void setWildCardType(WildCardType wildCard);
@@ -158,7 +160,7 @@ private:
         return false;
     }
 
-    Class mClass;
+    Class mClass = Class::EXCLUDE;
     Target mTarget = Target::NONE;
     Type mType = Type::NONE;
     Strategy mStrategy = Strategy::NONE;
@@ -210,6 +212,7 @@ public:
     QString getModifiedRule() const override;
 
     double valueInBytes();
+    Threshold getThreshold() const { return mThreshold; }
 
     unsigned long long value() const;
     UnitTypes unit() const;
@@ -16,6 +16,12 @@
 
 using namespace mega;
 
+namespace
+{
+constexpr int FLUSH_SYNC_SETTINGS_DELAY_MS = 1000;
+constexpr qint64 SYNC_SETTINGS_WRITES_WINDOW_MS = 60000;
+}
+
 #ifdef WIN32
 extern Q_CORE_EXPORT int qt_ntfs_permission_lookup;
 #endif
@@ -48,6 +54,10 @@ SyncInfo::SyncInfo():
     mShowErrorTimer.setSingleShot(true);
     mShowErrorTimer.setInterval(500);
     connect(&mShowErrorTimer, &QTimer::timeout, this, &SyncInfo::checkUnattendedDisabledSyncsForErrors);
+
+    mFlushSyncSettingsTimer.setSingleShot(true);
+    mFlushSyncSettingsTimer.setInterval(FLUSH_SYNC_SETTINGS_DELAY_MS);
+    connect(&mFlushSyncSettingsTimer, &QTimer::timeout, this, &SyncInfo::flushSyncSettings);
     qRegisterMetaType<SyncOrigin>("SyncOrigin");
 }
 
@@ -79,6 +89,7 @@ void SyncInfo::removeSyncedFolderByBackupId(MegaHandle backupId)
 
     assert(preferences->logged());
 
+    mDirtySyncSettings.remove(backupId);
     preferences->removeSyncSetting(cs);
     configuredSyncsMap.remove(backupId);
 
@@ -110,6 +121,7 @@ void SyncInfo::removeAllFolders()
     assert(preferences->logged());
 
     //remove all configured syncs
+    mDirtySyncSettings.clear();
     preferences->removeAllFolders();
 
     for (auto it = configuredSyncsMap.begin(); it != configuredSyncsMap.end(); it++)
@@ -212,10 +224,10 @@ std::shared_ptr<SyncSettings> SyncInfo::updateSyncSettings(MegaSync *sync)
     }
     else //new configuration (new or resumed)
     {
-        auto loaded = preferences->getLoadedSyncsMap();
-        if (loaded.contains(sync->getBackupId())) //existing configuration from previous executions (we get the data that the sdk might not be providing from our cache)
+        auto loaded = preferences->getLoadedSyncSetting(sync->getBackupId());
+        if (loaded) //existing configuration from previous executions (we get the data that the sdk might not be providing from our cache)
         {
-            cs = configuredSyncsMap[sync->getBackupId()] = std::make_shared<SyncSettings>(*loaded[sync->getBackupId()].get());
+            cs = configuredSyncsMap[sync->getBackupId()] = std::make_shared<SyncSettings>(*loaded.get());
             cs->setSync(sync);
         }
         else // new addition (no reference in the cache)
@@ -245,24 +257,87 @@ std::shared_ptr<SyncSettings> SyncInfo::updateSyncSettings(MegaSync *sync)
         deactivateSync(cs);
     }
 
-    preferences->writeSyncSetting(cs); // we store MEGAsync specific fields into cache
+    markSyncSettingsDirty(cs->backupId()); // we store MEGAsync specific fields into cache
     emit syncStateChanged(cs);
     return cs;
 }
 
+void SyncInfo::markSyncSettingsDirty(MegaHandle backupId)
+{
+    QMutexLocker qm(&syncMutex);
+    mDirtySyncSettings.insert(backupId);
+
+    // The timer is not restarted, so syncs flapping between states are still persisted
+    if (!mFlushSyncSettingsTimer.isActive())
+    {
+        QMetaObject::invokeMethod(&mFlushSyncSettingsTimer, "start", Qt::AutoConnection);
+    }
+}
+
+void SyncInfo::flushSyncSettings()
+{
+    QMutexLocker qm(&syncMutex);
+
+    QList<std::shared_ptr<SyncSettings>> settings;
+    settings.reserve(mDirtySyncSettings.size());
+    for (auto backupId : qAsConst(mDirtySyncSettings))
+    {
+        auto cs = configuredSyncsMap.value(backupId, nullptr);
+        if (cs)
+        {
+            settings.append(cs);
+        }
+    }
+    mDirtySyncSettings.clear();
+
+    writeSyncSettings(settings);
+}
+
+void SyncInfo::writeSyncSettings(const QList<std::shared_ptr<SyncSettings>>& syncSettings)
+{
+    if (syncSettings.isEmpty())
+    {
+        return;
+    }
+
+    preferences->writeSyncSettings(syncSettings);
+
+    mSyncSettingsWrites += static_cast<int>(syncSettings.size());
+    if (!mSyncSettingsWritesWindow.isValid())
+    {
+        mSyncSettingsWritesWindow.start();
+    }
+    else if (mSyncSettingsWritesWindow.elapsed() >= SYNC_SETTINGS_WRITES_WINDOW_MS)
+    {
+        MegaApi::log(MegaApi::LOG_LEVEL_DEBUG,
+                     QString::fromUtf8("Sync settings written in the last %1 seconds: %2")
+                         .arg(mSyncSettingsWritesWindow.elapsed() / 1000)
+                         .arg(mSyncSettingsWrites)
+                         .toUtf8()
+                         .constData());
+        mSyncSettingsWrites = 0;
+        mSyncSettingsWritesWindow.restart();
+    }
+}
+
 void SyncInfo::rewriteSyncSettings()
 {
     QMutexLocker qm(&syncMutex);
 
     // Get all settings
     const auto listAllSyncs (configuredSyncs.values());
-    const auto settings (std::accumulate(listAllSyncs.begin(),
-                                         listAllSyncs.end(),
-                                         QList<mega::MegaHandle>()));
-    for (auto cs : settings)
+    const auto backupIds (std::accumulate(listAllSyncs.begin(),
+                                          listAllSyncs.end(),
+                                          QList<mega::MegaHandle>()));
+    QList<std::shared_ptr<SyncSettings>> settings;
+    settings.reserve(backupIds.size());
+    for (auto backupId : backupIds)
     {
-        preferences->writeSyncSetting(configuredSyncsMap[cs]); // we store MEGAsync specific fields into cache
+        settings.append(configuredSyncsMap[backupId]);
     }
+
+    mDirtySyncSettings.clear();
+    writeSyncSettings(settings); // we store MEGAsync specific fields into cache
 }
 
 void SyncInfo::onboardingFinished(bool onboardingShown)
@@ -282,6 +357,8 @@ void SyncInfo::onboardingFinished(bool onboardingShown)
 void SyncInfo::reset()
 {
     QMutexLocker qm(&syncMutex);
+    flushSyncSettings();
+    mFlushSyncSettingsTimer.stop();
     configuredSyncs.clear();
     configuredSyncsMap.clear();
     unattendedDisabledSyncs.clear();
@@ -5,6 +5,7 @@
 #include "QTMegaListener.h"
 #include "SyncSettings.h"
 
+#include <QElapsedTimer>
 #include <QList>
 #include <QMap>
 #include <QMutex>
@@ -55,6 +56,16 @@ private:
     QTimer mShowErrorTimer;
     int mLastError = mega::MegaSync::NO_SYNC_ERROR;
 
+    // Syncs whose settings changed since they were last persisted. They are written together
+    // when the flush timer expires, instead of once per state change
+    QSet<mega::MegaHandle> mDirtySyncSettings;
+    QTimer mFlushSyncSettingsTimer;
+    int mSyncSettingsWrites = 0;
+    QElapsedTimer mSyncSettingsWritesWindow;
+
+    void markSyncSettingsDirty(mega::MegaHandle backupId);
+    void writeSyncSettings(const QList<std::shared_ptr<SyncSettings>>& syncSettings);
+
 public:
     using SyncType = mega::MegaSync::SyncType;
 
@@ -105,6 +116,8 @@ public:
 
     // store all megasync specific info of syncsettings into megasync cache
     void rewriteSyncSettings();
+    // store the syncsettings changed since the last flush
+    void flushSyncSettings();
 
     // OnboardingFinished
     void onboardingFinished(bool onboardingShown);
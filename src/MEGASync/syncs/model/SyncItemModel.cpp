@@ -466,19 +466,19 @@ std::shared_ptr<SyncSettings> SyncItemModel::getSyncSettings(const QModelIndex&
     return mList.at(index.row());
 }
 
+int SyncItemModel::findRow(mega::MegaHandle backupId) const
+{
+    return mRowsByBackupId.value(backupId, -1);
+}
+
 void SyncItemModel::insertSync(std::shared_ptr<SyncSettings> sync)
 {
-    if (mList.contains(sync))
+    const auto pos = findRow(sync->backupId());
+    if (pos >= 0)
     {
-        for (auto it = mList.cbegin(); it != mList.cend(); ++it)
-        {
-            if ((*it) == sync)
-            {
-                const auto pos = static_cast<int>(it - mList.cbegin());
-                sendDataChanged(pos);
-                break;
-            }
-        }
+        // The settings may have been recreated for the same backup id
+        mList[pos] = sync;
+        sendDataChanged(pos);
     }
     else
     {
@@ -487,6 +487,7 @@ void SyncItemModel::insertSync(std::shared_ptr<SyncSettings> sync)
             beginInsertRows(QModelIndex(),
                             static_cast<int>(mList.size()),
                             static_cast<int>(mList.size()));
+            mRowsByBackupId.insert(sync->backupId(), static_cast<int>(mList.size()));
             mList.append(sync);
             endInsertRows();
         }
@@ -496,35 +497,28 @@ void SyncItemModel::insertSync(std::shared_ptr<SyncSettings> sync)
 
 void SyncItemModel::updateSyncStats(std::shared_ptr<::mega::MegaSyncStats> stats)
 {
-    for (auto it = mList.cbegin(); it != mList.cend(); ++it)
+    const auto pos = findRow(stats->getBackupId());
+    if (pos >= 0)
     {
-        if ((*it)->backupId() == stats->getBackupId())
-        {
-            const auto pos = static_cast<int>(it - mList.cbegin());
-            sendDataChanged(pos);
-            break;
-        }
+        sendDataChanged(pos);
     }
 }
 
 void SyncItemModel::removeSync(std::shared_ptr<SyncSettings> sync)
 {
-    if (mList.contains(sync))
+    const auto pos = findRow(sync->backupId());
+    if (pos >= 0 && mList.at(pos) == sync)
     {
-        for (auto it = mList.cbegin(); it != mList.cend(); ++it)
+        beginRemoveRows(QModelIndex(), pos, pos);
+        mList.removeAt(pos);
+
+        // Only the rows after the removed one move
+        mRowsByBackupId.remove(sync->backupId());
+        for (int row = pos; row < mList.size(); ++row)
         {
-            if ((*it) == sync)
-            {
-                int pos = static_cast<int>(std::distance(mList.cbegin(), it));
-                if (pos >= 0)
-                {
-                    beginRemoveRows(QModelIndex(), pos, pos);
-                    mList.removeOne((*it));
-                    endRemoveRows();
-                }
-                break;
-            }
+            mRowsByBackupId[mList.at(row)->backupId()] = row;
         }
+        endRemoveRows();
     }
     emit syncUpdateFinished(sync);
 }
@@ -544,6 +538,13 @@ QList<std::shared_ptr<SyncSettings>> SyncItemModel::getList() const
 void SyncItemModel::setList(QList<std::shared_ptr<SyncSettings>> list)
 {
     mList = list;
+
+    mRowsByBackupId.clear();
+    mRowsByBackupId.reserve(static_cast<int>(mList.size()));
+    for (int row = 0; row < mList.size(); ++row)
+    {
+        mRowsByBackupId.insert(mList.at(row)->backupId(), row);
+    }
 }
 
 void SyncItemModel::setMode(mega::MegaSync::SyncType syncType)
@@ -5,6 +5,7 @@
 
 #include <QAbstractItemModel>
 #include <QCollator>
+#include <QHash>
 #include <QSortFilterProxyModel>
 
 #include <memory>
@@ -80,8 +81,12 @@ private slots:
 
 private:
     QList<std::shared_ptr<SyncSettings>> mList;
+    // Backup id -> row
+    QHash<mega::MegaHandle, int> mRowsByBackupId;
     mega::MegaSync::SyncType mSyncType;
 
+    int findRow(mega::MegaHandle backupId) const;
+
     virtual void sendDataChanged(int row);
     QVariant getColumnStats(int role,
                             mega::MegaHandle backupId,
@@ -14,6 +14,8 @@ set(DESKTOP_APP_SYNCS_HEADERS
     ${CMAKE_CURRENT_LIST_DIR}/model/BackupItemModel.h
     ${CMAKE_CURRENT_LIST_DIR}/model/SyncItemModel.h
     ${CMAKE_CURRENT_LIST_DIR}/control/MegaIgnoreManager.h
+    ${CMAKE_CURRENT_LIST_DIR}/control/MegaIgnoreMatcher.h
+    ${CMAKE_CURRENT_LIST_DIR}/control/MegaIgnorePreview.h
     ${CMAKE_CURRENT_LIST_DIR}/control/MegaIgnoreRules.h
     ${CMAKE_CURRENT_LIST_DIR}/control/SyncController.h
     ${CMAKE_CURRENT_LIST_DIR}/control/SyncInfo.h
@@ -42,6 +44,8 @@ set(DESKTOP_APP_SYNCS_SOURCES
     ${CMAKE_CURRENT_LIST_DIR}/model/BackupItemModel.cpp
     ${CMAKE_CURRENT_LIST_DIR}/model/SyncItemModel.cpp
     ${CMAKE_CURRENT_LIST_DIR}/control/MegaIgnoreManager.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/control/MegaIgnoreMatcher.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/control/MegaIgnorePreview.cpp
     ${CMAKE_CURRENT_LIST_DIR}/control/MegaIgnoreRules.cpp
     ${CMAKE_CURRENT_LIST_DIR}/control/SyncInfo.cpp
     ${CMAKE_CURRENT_LIST_DIR}/control/SyncController.cpp
@@ -445,7 +445,6 @@ bool InfoDialogTransferDelegateWidget::eventFilter(QObject *watched, QEvent *eve
 void InfoDialogTransferDelegateWidget::reset()
 {
     mIsHover = false;
-    mTransferRemainingTime.reset();
     TransferBaseDelegateWidget::reset();
 }
 
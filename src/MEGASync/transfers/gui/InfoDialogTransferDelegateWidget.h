@@ -3,7 +3,6 @@
 
 #include "megaapi.h"
 #include "TransferBaseDelegateWidget.h"
-#include "TransferRemainingTime.h"
 
 #include <QDateTime>
 #include <QFileInfo>
@@ -61,7 +60,6 @@ private:
     Ui::InfoDialogTransferDelegateWidget *mUi;
     mega::MegaApi *mMegaApi;
     bool mIsHover;
-    TransferRemainingTime mTransferRemainingTime;
 
     void updateFinishedIco(TransferData::TransferTypes transferType, bool error);
     void updateTransferActive(const QExplicitlySharedDataPointer<TransferData> data);
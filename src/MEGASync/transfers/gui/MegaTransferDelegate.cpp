@@ -2,6 +2,7 @@
 
 #include "MegaApplication.h"
 #include "MegaDelegateHoverManager.h"
+#include "ThemeManager.h"
 #include "TokenParserWidgetManager.h"
 #include "TransferBaseDelegateWidget.h"
 #include "TransfersModel.h"
@@ -15,6 +16,12 @@
 
 using namespace mega;
 
+namespace
+{
+// Enough for the visible rows of the biggest transfers view
+constexpr int MAX_CACHED_ROWS = 256;
+}
+
 MegaTransferDelegate::MegaTransferDelegate(TransfersSortFilterProxyBaseModel* model,  QAbstractItemView* view)
     : QStyledItemDelegate(view),
       mProxyModel (model),
@@ -22,6 +29,11 @@ MegaTransferDelegate::MegaTransferDelegate(TransfersSortFilterProxyBaseModel* mo
                         mProxyModel->sourceModel())),
       mView (view)
 {
+    // Queued, so widgets are restyled before rows are rendered again
+    connect(MegaSyncApp, &MegaApplication::languageChanged,
+            this, &MegaTransferDelegate::clearRowPaintCache, Qt::QueuedConnection);
+    connect(ThemeManager::instance(), &ThemeManager::themeChanged,
+            this, &MegaTransferDelegate::clearRowPaintCache, Qt::QueuedConnection);
 }
 
 MegaTransferDelegate::~MegaTransferDelegate()
@@ -70,16 +82,52 @@ void MegaTransferDelegate::paint(QPainter *painter, const QStyleOptionViewItem &
             w->resize(width, height);
         }
 
-        if(data)
+        // Drag pixmaps and other devices are painted directly
+        if (!data || painter->device() != mView->viewport())
         {
-            w->updateUi(data, row);
+            if(data)
+            {
+                w->updateUi(data, row);
+            }
+
+            painter->save();
+            painter->translate(pos);
+            w->render(option, painter, QRegion(0, 0, width, height));
+            painter->restore();
+            return;
         }
 
-        painter->save();
-        painter->translate(pos);
-        w->render(option, painter, QRegion(0, 0, width, height));
+        auto devicePixelRatio(painter->device()->devicePixelRatioF());
+        auto key(getRowPaintKey(data,
+                                option,
+                                QSize(width, height),
+                                devicePixelRatio,
+                                w->getViewState()));
+        auto cacheIt(mRowPaintCache.find(data->mTag));
+        if (cacheIt == mRowPaintCache.end() || !(cacheIt->key == key))
+        {
+            w->updateUi(data, row);
+
+            QPixmap rowPixmap(QSize(width, height) * devicePixelRatio);
+            rowPixmap.setDevicePixelRatio(devicePixelRatio);
+            rowPixmap.fill(Qt::transparent);
+            QPainter rowPainter(&rowPixmap);
+            w->render(option, &rowPainter, QRegion(0, 0, width, height));
+            rowPainter.end();
 
-        painter->restore();
+            if (cacheIt == mRowPaintCache.end() && mRowPaintCache.size() >= MAX_CACHED_ROWS)
+            {
+                mRowPaintCache.clear();
+            }
+            cacheIt = mRowPaintCache.insert(data->mTag, RowPaintCache{key, rowPixmap});
+        }
+        else if (w->getData() != data)
+        {
+            // The widget is still used for clicks, hover and tooltips, so it must show this row
+            w->updateUi(data, row);
+        }
+
+        painter->drawPixmap(pos, cacheIt->pixmap);
     }
     else
     {
@@ -87,6 +135,59 @@ void MegaTransferDelegate::paint(QPainter *painter, const QStyleOptionViewItem &
     }
 }
 
+bool MegaTransferDelegate::RowPaintKey::operator==(const RowPaintKey& other) const
+{
+    return notificationNumber == other.notificationNumber && state == other.state &&
+           errorCode == other.errorCode && errorValue == other.errorValue &&
+           transferredBytes == other.transferredBytes && speed == other.speed &&
+           remainingTime == other.remainingTime && finishedMinutes == other.finishedMinutes &&
+           size == other.size && optionState == other.optionState &&
+           qFuzzyCompare(devicePixelRatio, other.devicePixelRatio) &&
+           viewState == other.viewState;
+}
+
+MegaTransferDelegate::RowPaintKey
+    MegaTransferDelegate::getRowPaintKey(const QExplicitlySharedDataPointer<TransferData>& data,
+                                         const QStyleOptionViewItem& option,
+                                         const QSize& size,
+                                         qreal devicePixelRatio,
+                                         int viewState)
+{
+    RowPaintKey key;
+    key.notificationNumber = data->mNotificationNumber;
+    key.state = data->getState();
+    key.errorCode = data->mErrorCode;
+    key.errorValue = data->mErrorValue;
+    key.transferredBytes = data->mTransferredBytes;
+    key.speed = data->mSpeed;
+    key.remainingTime = data->mRemainingTime;
+    // Finished rows show the time elapsed since they finished
+    auto secondsSinceFinished(data->getSecondsSinceFinished());
+    key.finishedMinutes = secondsSinceFinished < 0 ? -1 : secondsSinceFinished / 60;
+    key.size = size;
+    key.optionState =
+        static_cast<int>(option.state & (QStyle::State_Selected | QStyle::State_MouseOver));
+    key.devicePixelRatio = devicePixelRatio;
+    key.viewState = viewState;
+    return key;
+}
+
+void MegaTransferDelegate::invalidateRowPaintCache(const QModelIndex& index)
+{
+    auto transferItem (qvariant_cast<TransferItem>(index.data(Qt::DisplayRole)));
+    auto data(transferItem.getTransferData());
+    if (data)
+    {
+        mRowPaintCache.remove(data->mTag);
+    }
+}
+
+void MegaTransferDelegate::clearRowPaintCache()
+{
+    mRowPaintCache.clear();
+    mView->viewport()->update();
+}
+
 bool MegaTransferDelegate::event(QEvent *event)
 {
     if(auto hoverEvent = dynamic_cast<MegaDelegateHoverEvent*>(event))
@@ -244,6 +345,7 @@ void MegaTransferDelegate::onHoverLeave(const QModelIndex& index, const QRect& r
     if(currentRow)
     {
         currentRow->mouseHoverTransfer(false, QPoint());
+        invalidateRowPaintCache(index);
     }
 }
 
@@ -253,6 +355,7 @@ void MegaTransferDelegate::onHoverEnter(const QModelIndex& index, const QRect& r
     if(currentRow)
     {
         currentRow->mouseHoverTransfer(true, QPoint());
+        invalidateRowPaintCache(index);
     }
 }
 
@@ -265,6 +368,9 @@ void MegaTransferDelegate::onHoverMove(const QModelIndex &index, const QRect &re
 
         if(hoverType != TransferBaseDelegateWidget::ActionHoverType::NONE)
         {
+            // The hovered action changed its icon
+            invalidateRowPaintCache(index);
+
             if(hoverType == TransferBaseDelegateWidget::ActionHoverType::HOVER_ENTER)
             {
                 if (isButton(currentRow, pos))
@@ -5,6 +5,7 @@
 
 #include <QAbstractButton>
 #include <QAbstractItemView>
+#include <QPixmap>
 #include <QStyledItemDelegate>
 
 class TransfersSortFilterProxyBaseModel;
@@ -32,6 +33,41 @@ protected slots:
     void onHoverMove(const QModelIndex& index, const QRect& rect, const QPoint& point);
 
 private:
+    // Everything the rendered row depends on. While it does not change, the row is drawn from
+    // its cached pixmap instead of updating and rendering the delegate widget again
+    struct RowPaintKey
+    {
+        long long notificationNumber = -1;
+        TransferData::TransferState state = TransferData::TRANSFER_NONE;
+        // The over quota rows show a different text depending on the error
+        int errorCode = 0;
+        long long errorValue = 0;
+        long long transferredBytes = 0;
+        long long speed = 0;
+        int64_t remainingTime = 0;
+        qint64 finishedMinutes = -1;
+        QSize size;
+        int optionState = 0;
+        qreal devicePixelRatio = 1.0;
+        int viewState = 0;
+
+        bool operator==(const RowPaintKey& other) const;
+    };
+
+    struct RowPaintCache
+    {
+        RowPaintKey key;
+        QPixmap pixmap;
+    };
+
+    static RowPaintKey getRowPaintKey(const QExplicitlySharedDataPointer<TransferData>& data,
+                                      const QStyleOptionViewItem& option,
+                                      const QSize& size,
+                                      qreal devicePixelRatio,
+                                      int viewState);
+    void invalidateRowPaintCache(const QModelIndex& index);
+    void clearRowPaintCache();
+
     TransferBaseDelegateWidget* getTransferItemWidget(const QModelIndex& index,
                                                       const QSize& size) const;
     QAbstractButton* isButton(TransferBaseDelegateWidget* row, const QPoint& pos);
@@ -39,6 +75,7 @@ private:
     TransfersSortFilterProxyBaseModel* mProxyModel;
     TransfersModel* mSourceModel;
     mutable QVector<TransferBaseDelegateWidget*> mTransferItems;
+    mutable QHash<TransferTag, RowPaintCache> mRowPaintCache;
     QAbstractItemView* mView;
 };
 
@@ -54,6 +54,8 @@ public:
     void setCurrentIndex(const QModelIndex &currentIndex);
 
     virtual void render(const QStyleOptionViewItem &, QPainter *painter, const QRegion &sourceRegion);
+    // State of the view, besides the transfer data, which changes what the row shows
+    virtual int getViewState() const {return 0;}
 
 signals:
     void retryTransfer();
@@ -1,9 +1,10 @@
 #include "TransferItem.h"
 
 #include "MegaApplication.h"
-#include "TransferRemainingTime.h"
 #include "Utilities.h"
 
+#include <chrono>
+
 using namespace mega;
 
 const unsigned long long ACTIVE_PRIORITY_OFFSET = 90000000000000;
@@ -110,16 +111,8 @@ void TransferData::update(mega::MegaTransfer* transfer)
             mMeanSpeed = 0;
         }
 
-        if(mTotalSize > mTransferredBytes)
-        {
-            long long remBytes = mTotalSize - mTransferredBytes;
-            TransferRemainingTime rem(mSpeed, remBytes);
-            mRemainingTime = rem.calculateRemainingTimeSeconds(mSpeed, remBytes).count();
-        }
-        else
-        {
-            mRemainingTime = 0;
-        }
+        // Unknown until the TransferThread estimates it from the speeds of the previous updates
+        mRemainingTime = mTotalSize > mTransferredBytes ? std::chrono::seconds::max().count() : 0;
 
         auto megaError (transfer->getLastErrorExtended());
         if (megaError)
@@ -624,7 +624,12 @@ void TransferManager::refreshFileTypesStats()
 
 void TransferManager::onTransfersDataUpdated()
 {
-    mTransfersCount = mModel->getTransfersCount();
+    const auto version(mModel->getTransfersCountVersion());
+    if (mTransfersCountVersion != version)
+    {
+        mTransfersCount = mModel->getTransfersCount();
+        mTransfersCountVersion = version;
+    }
 
     // Refresh stats
     refreshTypeStats();
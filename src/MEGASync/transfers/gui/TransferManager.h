@@ -17,6 +17,8 @@
 #include <QMenu>
 #include <QTimer>
 
+#include <optional>
+
 namespace Ui {
 class TransferManager;
 }
@@ -84,6 +86,8 @@ private:
 
     TransfersModel* mModel;
     TransfersCount mTransfersCount;
+    // Version of mTransfersCount, empty until it is read for the first time
+    std::optional<quint64> mTransfersCountVersion;
 
     QSet<Utilities::FileType> mFileTypesFilter;
     QTimer* mSpeedRefreshTimer;
@@ -484,6 +484,11 @@ TransferBaseDelegateWidget::ActionHoverType TransferManagerDelegateWidget::mouse
     return hoverType;
 }
 
+int TransferManagerDelegateWidget::getViewState() const
+{
+    return mColumnManager ? mColumnManager->getCurrentTab() : TransfersWidget::NO_TAB;
+}
+
 void TransferManagerDelegateWidget::render(const QStyleOptionViewItem& option,
                                            QPainter* painter,
                                            const QRegion& sourceRegion)
@@ -24,6 +24,8 @@ public:
     ActionHoverType mouseHoverTransfer(bool isHover, const QPoint &pos) override;
 
     void render(const QStyleOptionViewItem &option, QPainter *painter, const QRegion &sourceRegion) override;
+    // The failed transfers tab shows the error details instead of the speed and time
+    int getViewState() const override;
 
     void setColumnManager(QPointer<TransferWidgetColumnsManager> columnManager);
 
@@ -0,0 +1,72 @@
+#include "FileTypeCounters.h"
+
+#include <QtAlgorithms>
+
+FileTypeCounters::FileTypeCounters()
+{
+    clear();
+}
+
+void FileTypeCounters::addTransfer(Utilities::FileType fileType)
+{
+    mTransfers[index(fileType)]++;
+}
+
+void FileTypeCounters::removeTransfer(Utilities::FileType fileType)
+{
+    decrement(mTransfers[index(fileType)]);
+}
+
+void FileTypeCounters::addFinishedTransfer(Utilities::FileType fileType)
+{
+    mFinishedTransfers[index(fileType)]++;
+}
+
+void FileTypeCounters::removeFinishedTransfer(Utilities::FileType fileType)
+{
+    decrement(mTransfers[index(fileType)]);
+    decrement(mFinishedTransfers[index(fileType)]);
+}
+
+uint FileTypeCounters::getTransfers(Utilities::FileType fileType) const
+{
+    return mTransfers[index(fileType)];
+}
+
+uint FileTypeCounters::getFinishedTransfers(Utilities::FileType fileType) const
+{
+    return mFinishedTransfers[index(fileType)];
+}
+
+void FileTypeCounters::clear()
+{
+    mTransfers.fill(0);
+    mFinishedTransfers.fill(0);
+}
+
+bool FileTypeCounters::operator==(const FileTypeCounters& other) const
+{
+    return mTransfers == other.mTransfers && mFinishedTransfers == other.mFinishedTransfers;
+}
+
+bool FileTypeCounters::operator!=(const FileTypeCounters& other) const
+{
+    return !(*this == other);
+}
+
+int FileTypeCounters::index(Utilities::FileType fileType)
+{
+    // The file types are single bit flags, from TYPE_OTHER (0x01) to TYPE_IMAGE (0x20)
+    const auto bit(static_cast<int>(qCountTrailingZeroBits(static_cast<uint>(fileType))));
+    Q_ASSERT(bit < FILE_TYPE_COUNT);
+    return qMin(bit, FILE_TYPE_COUNT - 1);
+}
+
+void FileTypeCounters::decrement(uint& counter)
+{
+    // Late events of a transfer removed in a clear must not wrap the counter around
+    if (counter > 0)
+    {
+        counter--;
+    }
+}
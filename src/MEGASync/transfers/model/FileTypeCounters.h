@@ -0,0 +1,40 @@
+#ifndef FILE_TYPE_COUNTERS_H
+#define FILE_TYPE_COUNTERS_H
+
+#include "Utilities.h"
+
+#include <array>
+
+// Number of transfers, and of finished transfers, of each file type. The counters live in a fixed
+// size array indexed by file type, so updating and copying them does not allocate memory.
+// Not thread safe: the owner guards them together with the rest of the transfer counters.
+class FileTypeCounters
+{
+public:
+    FileTypeCounters();
+
+    void addTransfer(Utilities::FileType fileType);
+    void removeTransfer(Utilities::FileType fileType);
+    void addFinishedTransfer(Utilities::FileType fileType);
+    // The transfer is removed from the list: it does not count as started nor as finished
+    void removeFinishedTransfer(Utilities::FileType fileType);
+
+    uint getTransfers(Utilities::FileType fileType) const;
+    uint getFinishedTransfers(Utilities::FileType fileType) const;
+
+    void clear();
+
+    bool operator==(const FileTypeCounters& other) const;
+    bool operator!=(const FileTypeCounters& other) const;
+
+    static constexpr int FILE_TYPE_COUNT = 6;
+
+private:
+    static int index(Utilities::FileType fileType);
+    static void decrement(uint& counter);
+
+    std::array<uint, FILE_TYPE_COUNT> mTransfers;
+    std::array<uint, FILE_TYPE_COUNT> mFinishedTransfers;
+};
+
+#endif // FILE_TYPE_COUNTERS_H
@@ -8,6 +8,8 @@
 
 #include <QDir>
 
+#include <algorithm>
+
 // CLASS TRANSFERMETADATAITEMID
 bool TransferMetaDataItemId::operator==(const TransferMetaDataItemId& item) const
 {
@@ -26,6 +28,35 @@ bool TransferMetaDataItemId::operator<(const TransferMetaDataItemId &item) const
     return tag < item.tag;
 }
 
+void TransferMetaDataItemId::setPath(const QString& upath)
+{
+    auto separatorIndex(std::max(upath.lastIndexOf(QLatin1Char('/')),
+                                 upath.lastIndexOf(QLatin1Char('\\'))));
+    mPathPrefix = upath.left(separatorIndex + 1);
+    mPathLeaf = upath.mid(separatorIndex + 1);
+
+    // Most of the times the last path component is the name, share it
+    if(mPathLeaf == name)
+    {
+        mPathLeaf = name;
+    }
+}
+
+void TransferMetaDataItemId::internPathPrefix(QSet<QString>& pathPrefixes)
+{
+    if(mPathPrefix.isEmpty())
+    {
+        return;
+    }
+
+    auto it = pathPrefixes.constFind(mPathPrefix);
+    if(it == pathPrefixes.constEnd())
+    {
+        it = pathPrefixes.insert(mPathPrefix);
+    }
+    mPathPrefix = *it;
+}
+
 /////////////////////////////////
 TransferMetaData::TransferMetaData(int direction, unsigned long long id)
     : mInitialTopLevelTransfers(-1), mInitialPendingFolderTransfersFromOtherSession(0), mFinishedTopLevelTransfers(0), mStartedTopLevelTransfers(0), mTransferDirection(direction), mCreateRootFolder(false),
@@ -48,13 +79,15 @@ bool TransferMetaData::isRetriedFolder(mega::MegaTransfer* transfer)
     }
     else
     {
+        const QString transferPath(QString::fromUtf8(transfer->getPath()));
         foreach(auto folder, mFolders)
         {
-            if(folder->id.path == QString::fromUtf8(transfer->getPath()))
+            if(folder->id.path() == transferPath)
             {
                 mFolders.remove(folder->id);
                 //Update id with new tag (retried tag)
-                TransferMetaDataItemId id(transfer->getTag(), folder->id.handle, folder->id.name, folder->id.path);
+                TransferMetaDataItemId id(folder->id);
+                id.tag = transfer->getTag();
                 mFolders.insert(id, folder);
                 return true;
             }
@@ -102,6 +135,7 @@ bool TransferMetaData::finish(mega::MegaTransfer *transfer, mega::MegaError* e)
     if(transfer->isFolderTransfer())
     {
         TransferMetaDataItemId id(transfer->getTag(), transfer->getNodeHandle(), QString::fromUtf8(transfer->getFileName()), QString::fromUtf8(transfer->getPath()));
+        internPathPrefix(id);
 
         auto value = mFolders.value(id);
         if(value)
@@ -122,7 +156,7 @@ bool TransferMetaData::finish(mega::MegaTransfer *transfer, mega::MegaError* e)
                 state = TransferData::TRANSFER_COMPLETED;
             }
 
-            auto isEmptyFolder(value->files.size() == 0);
+            auto isEmptyFolder(value->filesCount == 0);
 
             if(!nonExistError(transfer, e))
             {
@@ -145,7 +179,7 @@ bool TransferMetaData::finish(mega::MegaTransfer *transfer, mega::MegaError* e)
                     if(isEmptyFolder)
                     {
                         value->state = TransferData::TRANSFER_FAILED;
-                        nonExistData->mEmptyFolders.nonExistFailedTransfers.insert(id, value);
+                        nonExistData->mEmptyFolders.nonExistFailedTransfers.insert(id.tag, value);
                     }
                     else
                     {
@@ -166,8 +200,9 @@ bool TransferMetaData::finish(mega::MegaTransfer *transfer, mega::MegaError* e)
     else
     {
         TransferMetaDataItemId id(transfer->getTag(), transfer->getNodeHandle(), QString::fromUtf8(transfer->getFileName()), QString::fromUtf8(transfer->getPath()));
+        internPathPrefix(id);
 
-        auto item = mFiles.pendingTransfers.value(id);
+        auto item = mFiles.pendingTransfers.value(id.tag);
         if(item)
         {
             item->id = id;
@@ -201,7 +236,7 @@ bool TransferMetaData::finish(mega::MegaTransfer *transfer, mega::MegaError* e)
                 if(nonExistData)
                 {
                     item->state = TransferData::TRANSFER_FAILED;
-                    mFiles.nonExistFailedTransfers.insert(item->id, item);
+                    mFiles.nonExistFailedTransfers.insert(item->id.tag, item);
                 }
             }
         }
@@ -304,7 +339,7 @@ QList<TransferMetaDataItemId> TransferMetaData::getFileFailedTagsFromFolderTag(c
 
 qsizetype TransferMetaData::getFileTransfersOK() const
 {
-    return mFiles.completedTransfers.size();
+    return mFiles.countByState(TransferData::TRANSFER_COMPLETED);
 }
 
 qsizetype TransferMetaData::getFileTransfersFailed() const
@@ -345,7 +380,7 @@ void TransferMetaData::getFileTransferFailedTags(QList<std::shared_ptr<TransferM
 
 qsizetype TransferMetaData::getFileTransfersCancelled() const
 {
-    return mFiles.cancelledTransfers.size();
+    return mFiles.countByState(TransferData::TRANSFER_CANCELLED);
 }
 
 qsizetype TransferMetaData::getTotaTransfersCancelled() const
@@ -399,18 +434,23 @@ qsizetype TransferMetaData::getEmptyFolderTransfersFailed() const
 }
 
 qsizetype TransferMetaData::getEmptyFolders(
-    const QMap<TransferMetaDataItemId, std::shared_ptr<TransferMetaDataFolderItem>>& folders) const
+    const TransferMetaDataItemsByState<TransferMetaDataFolderItem>::Items& folders) const
 {
     qsizetype counter(0);
 
     foreach(auto& folder, folders)
     {
-       folder->files.size() == 0 ? counter++ : counter;
+       folder->filesCount == 0 ? counter++ : counter;
     }
 
     return counter;
 }
 
+void TransferMetaData::internPathPrefix(TransferMetaDataItemId& id)
+{
+    id.internPathPrefix(mPathPrefixes);
+}
+
 void TransferMetaData::setCreatedFromOtherSession()
 {
     mCreatedFromOtherSession = true;
@@ -420,7 +460,7 @@ void TransferMetaData::addFile(int tag)
 {
     TransferMetaDataItemId id(tag, mega::INVALID_HANDLE);
     auto fileItem = std::make_shared<TransferMetaDataItem>(id);
-    mFiles.pendingTransfers.insert(id, fileItem);
+    mFiles.pendingTransfers.insert(id.tag, fileItem);
     mTotalFileCount++;
 
     if(mStartedTopLevelTransfers <= mInitialTopLevelTransfers)
@@ -438,7 +478,7 @@ void TransferMetaData::addFileFromFolder(int folderTag, int fileTag)
     TransferMetaDataItemId fileId(fileTag, mega::INVALID_HANDLE);
     auto fileItem = std::make_shared<TransferMetaDataItem>(fileId);
     fileItem->topLevelFolderId.tag = folderTag;
-    mFiles.pendingTransfers.insert(fileId, fileItem);
+    mFiles.pendingTransfers.insert(fileId.tag, fileItem);
 
     TransferMetaDataItemId folderId(folderTag, mega::INVALID_HANDLE);
     auto folderItem = mFolders.value(folderId, nullptr);
@@ -450,7 +490,7 @@ void TransferMetaData::addFileFromFolder(int folderTag, int fileTag)
         addInitialPendingTopLevelTransferFromOtherSession(true);
     }
 
-    folderItem->files.pendingTransfers.insert(fileId, fileItem);
+    folderItem->filesCount++;
 }
 
 void TransferMetaData::topLevelFolderScanningFinished(unsigned int filecount)
@@ -660,8 +700,8 @@ void TransferMetaData::retryFileFromFolderFailingItem(int fileTag, int folderTag
 {
     TransferMetaDataItemId fileId(fileTag, nodeHandle);
 
-    auto removed = mFiles.failedTransfers.remove(fileId);
-    removed += mFiles.nonExistFailedTransfers.remove(fileId);
+    auto removed = mFiles.failedTransfers.remove(fileId.tag);
+    removed += mFiles.nonExistFailedTransfers.remove(fileId.tag);
 
     if(removed != 0)
     {
@@ -682,8 +722,8 @@ void TransferMetaData::retryFailingFile(int tag, mega::MegaHandle nodeHandle)
     //Don´t use isSingleTransfer as this one takes into account empty folders
     auto isSingle(getTotalFiles() == 1);
 
-    auto removed = mFiles.failedTransfers.remove(fileId);
-    removed += mFiles.nonExistFailedTransfers.remove(fileId);
+    auto removed = mFiles.failedTransfers.remove(fileId.tag);
+    removed += mFiles.nonExistFailedTransfers.remove(fileId.tag);
 
     if(removed != 0)
     {
@@ -766,7 +806,7 @@ QStringList DownloadTransferMetaData::getLocalPaths() const
     auto ids = getTransferIdsByState(TransferData::TRANSFER_COMPLETED);
     foreach(auto& id, ids)
     {
-        QFileInfo fileInfo(id.path);
+        QFileInfo fileInfo(id.path());
         QString localPath(fileInfo.path());
 
         char *escapedName = MegaSyncApp->getMegaApi()->escapeFsIncompatible(id.name.toUtf8().constData(),
@@ -798,7 +838,7 @@ bool DownloadTransferMetaData::hasBeenPreviouslyCompleted(mega::MegaTransfer *tr
     //If the file has been previously completed, the node is already on the CD.
     //If not, the file should be uploaded again
     TransferMetaDataItemId fileId(-1, transfer->getNodeHandle());
-    return mFiles.completedTransfers.contains(fileId);
+    return mFiles.completedTransfers.contains(fileId.tag);
 }
 
 std::shared_ptr<TransferMetaData> DownloadTransferMetaData::createNonExistData()
@@ -4,9 +4,13 @@
 #include "Preferences.h"
 #include "TransferItem.h"
 
+#include <QHash>
+#include <QMap>
+#include <QMultiHash>
 #include <QMutex>
 #include <QPair>
 #include <QPointer>
+#include <QSet>
 #include <QVariant>
 
 #include <memory>
@@ -24,13 +28,15 @@ class TransferItem;
 struct TransferMetaDataItemId
 {
     TransferMetaDataItemId(int utag, mega::MegaHandle uhandle):tag(utag), handle(uhandle){}
-    TransferMetaDataItemId(int utag, mega::MegaHandle uhandle, const QString& uname, const QString& upath):tag(utag), handle(uhandle), name(uname), path(upath){}
+    TransferMetaDataItemId(int utag, mega::MegaHandle uhandle, const QString& uname, const QString& upath):tag(utag), handle(uhandle), name(uname)
+    {
+        setPath(upath);
+    }
     TransferMetaDataItemId():tag(0), handle(mega::INVALID_HANDLE){}
 
     int tag;
     mega::MegaHandle handle;
     QString name;
-    QString path;
 
     bool operator==(const TransferMetaDataItemId &data) const;
     bool operator<(const TransferMetaDataItemId &data) const;
@@ -38,6 +44,18 @@ struct TransferMetaDataItemId
     {
         return tag > 0 || handle != mega::INVALID_HANDLE;
     }
+
+    QString path() const
+    {
+        return mPathPrefix + mPathLeaf;
+    }
+    void setPath(const QString& upath);
+    // All the files of a folder share the same prefix, so only one copy of it is kept
+    void internPathPrefix(QSet<QString>& pathPrefixes);
+
+private:
+    QString mPathPrefix;
+    QString mPathLeaf;
 };
 
 struct TransferMetaDataItem
@@ -69,21 +87,26 @@ struct TransferMetaDataItem
     }
 };
 
+// Items are indexed by tag (the only field used to order the former id keys), so the ids are not
+// copied into the container keys. The map keeps them in the order they were started, so the first
+// item and the sorted ids come straight from it
 template <class Type>
 struct TransferMetaDataItemsByState
 {
+    using Items = QMap<int, std::shared_ptr<Type>>;
+
     qsizetype size() const
     {
         return pendingTransfers.size() + completedTransfers.size() + failedTransfers.size() +
                cancelledTransfers.size() + nonExistFailedTransfers.size();
     }
 
-    QMap<TransferMetaDataItemId, std::shared_ptr<Type>> pendingTransfers;
-    QMap<TransferMetaDataItemId, std::shared_ptr<Type>> completedTransfers;
-    QMultiMap<mega::MegaHandle, std::shared_ptr<Type>> completedTransfersByFolderHandle;
-    QMap<TransferMetaDataItemId, std::shared_ptr<Type>> failedTransfers;
-    QMap<TransferMetaDataItemId, std::shared_ptr<Type>> nonExistFailedTransfers;
-    QMap<TransferMetaDataItemId, std::shared_ptr<Type>> cancelledTransfers;
+    Items pendingTransfers;
+    Items completedTransfers;
+    QMultiHash<mega::MegaHandle, std::shared_ptr<Type>> completedTransfersByFolderHandle;
+    Items failedTransfers;
+    Items nonExistFailedTransfers;
+    Items cancelledTransfers;
 
     TransferMetaDataItemId getFirstTransferIdByState(TransferData::TransferState state) const
     {
@@ -94,99 +117,35 @@ struct TransferMetaDataItemsByState
     std::shared_ptr<TransferMetaDataItem>
         getFirstTransferByState(TransferData::TransferState state) const
     {
-        switch(state)
+        const auto& items(getItemsByState(state));
+        if(!items.isEmpty())
         {
-            case TransferData::TRANSFER_COMPLETED:
-            {
-                if(!completedTransfers.isEmpty())
-                {
-                    return completedTransfers.first();
-                }
-                break;
-            }
-            case TransferData::TRANSFER_CANCELLED:
-            {
-                if(!cancelledTransfers.isEmpty())
-                {
-                    return cancelledTransfers.first();
-                }
-                break;
-            }
-            case TransferData::TRANSFER_FAILED:
-            {
-                if(!failedTransfers.isEmpty())
-                {
-                    return failedTransfers.first();
-                }
-                if(!nonExistFailedTransfers.isEmpty())
-                {
-                    return nonExistFailedTransfers.first();
-                }
-                break;
-            }
-            default:
-            {
-                if(!pendingTransfers.isEmpty())
-                {
-                    return pendingTransfers.first();
-                }
-                break;
-            }
+            return getFirstItem(items);
+        }
+
+        if(state == TransferData::TRANSFER_FAILED && !nonExistFailedTransfers.isEmpty())
+        {
+            return getFirstItem(nonExistFailedTransfers);
         }
 
         return nullptr;
     }
 
+    qsizetype countByState(TransferData::TransferState state) const
+    {
+        return getItemsByState(state).size();
+    }
+
     QList<TransferMetaDataItemId> getTransferIdsByState(TransferData::TransferState state) const
     {
         QList<TransferMetaDataItemId> ids;
 
-        switch(state)
+        // In the order they were started, as the notifications list them
+        const auto& items(getItemsByState(state));
+        ids.reserve(static_cast<int>(items.size()));
+        for(const auto& item : items)
         {
-            case TransferData::TRANSFER_COMPLETED:
-            {
-                if(!completedTransfers.isEmpty())
-                {
-                    foreach(auto& item, completedTransfers.keys())
-                    {
-                        ids.append(item);
-                    }
-                }
-                break;
-            }
-            case TransferData::TRANSFER_CANCELLED:
-            {
-                if(!cancelledTransfers.isEmpty())
-                {
-                    foreach(auto& item, cancelledTransfers.keys())
-                    {
-                        ids.append(item);
-                    }
-                }
-                break;
-            }
-            case TransferData::TRANSFER_FAILED:
-            {
-                if(!failedTransfers.isEmpty())
-                {
-                    foreach(auto& item, failedTransfers.keys())
-                    {
-                        ids.append(item);
-                    }
-                }
-                break;
-            }
-            default:
-            {
-                if(!pendingTransfers.isEmpty())
-                {
-                    foreach(auto& item, pendingTransfers.keys())
-                    {
-                        ids.append(item);
-                    }
-                }
-                break;
-            }
+            ids.append(item->id);
         }
 
         return ids;
@@ -206,64 +165,62 @@ private:
     bool mHasChanged = false;
 
     friend class TransferMetaData;
-    void insertItem(TransferData::TransferState state, const std::shared_ptr<Type>& item)
+
+    // The one with the lowest tag
+    static std::shared_ptr<Type> getFirstItem(const Items& items)
     {
-        removeItem(item);
+        return items.isEmpty() ? nullptr : items.first();
+    }
 
-        item->state = state;
+    const Items& getItemsByState(TransferData::TransferState state) const
+    {
         switch(state)
         {
             case TransferData::TRANSFER_COMPLETED:
             {
-                completedTransfers.insert(item->id, item);
-                completedTransfersByFolderHandle.insert(item->folderId.handle, item);
-                break;
+                return completedTransfers;
             }
             case TransferData::TRANSFER_CANCELLED:
             {
-                cancelledTransfers.insert(item->id, item);
-                break;
+                return cancelledTransfers;
             }
             case TransferData::TRANSFER_FAILED:
             {
-                failedTransfers.insert(item->id, item);
-                break;
+                return failedTransfers;
             }
             default:
             {
-                pendingTransfers.insert(item->id, item);
-                break;
+                return pendingTransfers;
             }
         }
+    }
+
+    Items& getItemsByState(TransferData::TransferState state)
+    {
+        return const_cast<Items&>(
+            static_cast<const TransferMetaDataItemsByState*>(this)->getItemsByState(state));
+    }
+
+    void insertItem(TransferData::TransferState state, const std::shared_ptr<Type>& item)
+    {
+        removeItem(item);
+
+        item->state = state;
+        getItemsByState(state).insert(item->id.tag, item);
+        if(state == TransferData::TRANSFER_COMPLETED)
+        {
+            completedTransfersByFolderHandle.insert(item->folderId.handle, item);
+        }
 
         setHasChanged(true);
     }
 
     void removeItem(const std::shared_ptr<Type>& item)
     {
-        switch(item->state)
+        getItemsByState(item->state).remove(item->id.tag);
+        if(item->state == TransferData::TRANSFER_COMPLETED)
         {
-            case TransferData::TRANSFER_COMPLETED:
-            {
-                completedTransfers.remove(item->id);
-                completedTransfersByFolderHandle.remove(item->folderId.handle, item);
-                break;
-            }
-            case TransferData::TRANSFER_CANCELLED:
-            {
-                cancelledTransfers.remove(item->id);
-                break;
-            }
-            case TransferData::TRANSFER_FAILED:
-            {
-                failedTransfers.remove(item->id);
-                break;
-            }
-            default:
-            {
-                pendingTransfers.remove(item->id);
-                break;
-            }
+            completedTransfersByFolderHandle.remove(item->folderId.handle, item);
         }
     }
 };
@@ -271,9 +228,10 @@ private:
 struct TransferMetaDataFolderItem : public TransferMetaDataItem
 {
     TransferMetaDataFolderItem(const TransferMetaDataItemId& id)
-        : TransferMetaDataItem(id){}
+        : TransferMetaDataItem(id), filesCount(0){}
 
-    TransferMetaDataItemsByState<TransferMetaDataItem> files;
+    // The files are already tracked in TransferMetaData::mFiles, only the amount is needed here
+    qsizetype filesCount;
 };
 
 class TransferMetaData
@@ -357,8 +315,8 @@ protected:
     QMap<TransferMetaDataItemId, std::shared_ptr<TransferMetaDataFolderItem>> mFolders;
     TransferMetaDataItemsByState<TransferMetaDataFolderItem> mEmptyFolders;
     qsizetype getEmptyFolders(
-        const QMap<TransferMetaDataItemId, std::shared_ptr<TransferMetaDataFolderItem>>& folders)
-        const;
+        const TransferMetaDataItemsByState<TransferMetaDataFolderItem>::Items& folders) const;
+    void internPathPrefix(TransferMetaDataItemId& id);
 
     int mTransferDirection;
     bool mCreateRootFolder;
@@ -379,6 +337,7 @@ private:
     QPointer<DesktopAppNotification> mNotification;
     QMetaObject::Connection mNotificationDestroyedConnection;
     unsigned long long mNonExistsFailAppId;
+    QSet<QString> mPathPrefixes;
 };
 
 Q_DECLARE_METATYPE(std::shared_ptr<TransferMetaData>)
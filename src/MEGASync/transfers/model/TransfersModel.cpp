@@ -19,6 +19,7 @@
 #include <QSharedData>
 
 #include <algorithm>
+#include <chrono>
 #include <functional>
 #include <utility>
 
@@ -37,7 +38,9 @@ const int PAUSE_RESUME_THRESHOLD_THREAD = 300;
 const int CLEAR_THRESHOLD_THREAD = 300;
 
 //LISTENER THREAD
-TransferThread::TransferThread() : mMaxTransfersToProcess(MAX_TRANSFERS)
+TransferThread::TransferThread():
+    mTransfersCountVersion(0),
+    mMaxTransfersToProcess(MAX_TRANSFERS)
 {
     mDelegateListener = std::make_unique<QTMegaTransferListener>(MegaSyncApp->getMegaApi(), this);
     MegaSyncApp->getMegaApi()->addTransferListener(mDelegateListener.get());
@@ -76,10 +79,13 @@ TransferThread::TransfersToProcess TransferThread::processTransfers()
 void TransferThread::clear()
 {
     QMutexLocker lock(&mCacheMutex);
+    QMutexLocker counterLock(&mCountersMutex);
 
     mTransfersToProcess.clear();
     mTransfersCount.clear();
     mLastTransfersCount.clear();
+    mTransfersCountVersion++;
+    mThroughputByTag.clear();
 }
 
 QList<QExplicitlySharedDataPointer<TransferData>>
@@ -120,10 +126,37 @@ QExplicitlySharedDataPointer<TransferData> TransferThread::createData(MegaTransf
 {
     QExplicitlySharedDataPointer<TransferData> d (new TransferData(transfer));
     updateFailedTransfer(d, transfer, e);
+    updateRemainingTime(d);
 
     return d;
 }
 
+void TransferThread::updateRemainingTime(QExplicitlySharedDataPointer<TransferData> data)
+{
+    if (data->isFinished())
+    {
+        mThroughputByTag.remove(data->mTag);
+        return;
+    }
+
+    if (data->mRemainingTime == 0)
+    {
+        return;
+    }
+
+    const auto now(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()));
+    auto& estimator(mThroughputByTag[data->mTag]);
+    estimator.addRateSample(now, static_cast<double>(data->mSpeed));
+
+    auto estimate(estimator.getEstimate(
+        static_cast<unsigned long long>(data->mTotalSize - data->mTransferredBytes)));
+    if (estimate.has_value())
+    {
+        data->mRemainingTime = estimate->remaining.count();
+    }
+}
+
 QExplicitlySharedDataPointer<TransferData> TransferThread::checkIfRepeatedAndSubstituteInStartTransfers(QMap<int, QExplicitlySharedDataPointer<TransferData>>& dataMap, MegaTransfer* transfer)
 {
     if(dataMap.contains(transfer->getTag()))
@@ -254,7 +287,7 @@ void TransferThread::onTransferStart(MegaApi *, MegaTransfer *transfer)
                 QMutexLocker counterLock(&mCountersMutex);
                 auto fileType = Utilities::getFileType(QString::fromUtf8(transfer->getFileName()),
                                                        Utilities::AttributeType::NONE);
-                mTransfersCount.transfersByType[fileType]++;
+                mTransfersCount.byFileType.addTransfer(fileType);
 
                 if(transfer->getType() == MegaTransfer::TYPE_UPLOAD)
                 {
@@ -280,6 +313,8 @@ void TransferThread::onTransferStart(MegaApi *, MegaTransfer *transfer)
                     mLastTransfersCount.totalDownloadBytes += transfer->getTotalBytes();
                     mLastTransfersCount.completedDownloadBytes += transfer->getTransferredBytes();
                 }
+
+                mTransfersCountVersion++;
             }
 
             {
@@ -332,6 +367,8 @@ void TransferThread::onTransferUpdate(MegaApi *, MegaTransfer *transfer)
                 mTransfersCount.completedDownloadBytes += transfer->getDeltaSize();
                 mLastTransfersCount.completedDownloadBytes += transfer->getDeltaSize();
             }
+
+            mTransfersCountVersion++;
         }
 
         {
@@ -394,7 +431,7 @@ void TransferThread::onTransferFinish(MegaApi* megaApi, MegaTransfer *transfer,
                         (transfer->getState() == MegaTransfer::STATE_FAILED &&
                          transfer->isSyncTransfer()))
                     {
-                        mTransfersCount.transfersByType[fileType]--;
+                        mTransfersCount.byFileType.removeTransfer(fileType);
 
                         if(transfer->getType() == MegaTransfer::TYPE_UPLOAD)
                         {
@@ -428,7 +465,7 @@ void TransferThread::onTransferFinish(MegaApi* megaApi, MegaTransfer *transfer,
                     }
                     else
                     {
-                        mTransfersCount.transfersFinishedByType[fileType]++;
+                        mTransfersCount.byFileType.addFinishedTransfer(fileType);
                         if(transfer->getType() == MegaTransfer::TYPE_UPLOAD)
                         {
                             mTransfersCount.removePendingUpload(transfer);
@@ -473,6 +510,8 @@ void TransferThread::onTransferFinish(MegaApi* megaApi, MegaTransfer *transfer,
                             mLastTransfersCount.clear();
                         }
                     }
+
+                    mTransfersCountVersion++;
                 }
 
             }
@@ -551,6 +590,8 @@ void TransferThread::onTransferTemporaryError(MegaApi*, MegaTransfer *transfer,
                 mTransfersCount.completedDownloadBytes += transfer->getDeltaSize();
                 mLastTransfersCount.completedDownloadBytes += transfer->getDeltaSize();
             }
+
+            mTransfersCountVersion++;
         }
 
         {
@@ -696,6 +737,27 @@ LastTransfersCount TransferThread::getLastTransfersCount()
     return mLastTransfersCount;
 }
 
+quint64 TransferThread::getTransfersCountVersion() const
+{
+    return mTransfersCountVersion;
+}
+
+bool TransferThread::getTransfersCountIfChanged(quint64& version,
+                                                TransfersCount& transfersCount,
+                                                LastTransfersCount& lastTransfersCount)
+{
+    if (mTransfersCountVersion == version)
+    {
+        return false;
+    }
+
+    QMutexLocker lock(&mCountersMutex);
+    transfersCount = mTransfersCount;
+    lastTransfersCount = mLastTransfersCount;
+    version = mTransfersCountVersion;
+    return true;
+}
+
 int TransfersModel::hasActiveTransfers() const
 {
     return static_cast<int>(mActiveTransfers.size());
@@ -734,6 +796,7 @@ void TransferThread::resetUploads(
     QList<QExplicitlySharedDataPointer<TransferData>> transfersToReset)
 {
     QMutexLocker lock(&mCountersMutex);
+    mTransfersCountVersion++;
 
     foreach(auto& transfer, transfersToReset)
     {
@@ -741,8 +804,7 @@ void TransferThread::resetUploads(
         {
             mTransfersCount.totalUploads--;
             mTransfersCount.totalUploadBytes -= transfer->mTotalSize;
-            mTransfersCount.transfersByType[transfer->mFileType]--;
-            mTransfersCount.transfersFinishedByType[transfer->mFileType]--;
+            mTransfersCount.byFileType.removeFinishedTransfer(transfer->mFileType);
 
             if(transfer->isFailed() && !transfer->isSyncTransfer())
             {
@@ -765,8 +827,7 @@ void TransferThread::resetUploads(
             mLastTransfersCount.totalUploads--;
             mLastTransfersCount.completedUploadBytes -= transfer->mTotalSize;
             mLastTransfersCount.totalUploadBytes -= transfer->mTotalSize;
-            mLastTransfersCount.transfersByType[transfer->mFileType]--;
-            mLastTransfersCount.transfersFinishedByType[transfer->mFileType]--;
+            mLastTransfersCount.byFileType.removeFinishedTransfer(transfer->mFileType);
 
             if(transfer->isFailed() && !transfer->isSyncTransfer())
             {
@@ -789,6 +850,7 @@ void TransferThread::resetDownloads(
     QList<QExplicitlySharedDataPointer<TransferData>> transfersToReset)
 {
     QMutexLocker lock(&mCountersMutex);
+    mTransfersCountVersion++;
 
     foreach(auto& transfer, transfersToReset)
     {
@@ -796,8 +858,7 @@ void TransferThread::resetDownloads(
         {
             mTransfersCount.totalDownloads--;
             mTransfersCount.totalDownloadBytes -= transfer->mTotalSize;
-            mTransfersCount.transfersByType[transfer->mFileType]--;
-            mTransfersCount.transfersFinishedByType[transfer->mFileType]--;
+            mTransfersCount.byFileType.removeFinishedTransfer(transfer->mFileType);
 
             if (transfer->isFailed() && !transfer->isSyncTransfer())
             {
@@ -814,8 +875,7 @@ void TransferThread::resetDownloads(
             mLastTransfersCount.completedDownloadsByTag.remove(transfer->mTag);
             mLastTransfersCount.totalDownloads--;
             mLastTransfersCount.totalDownloadBytes -= transfer->mTotalSize;
-            mLastTransfersCount.transfersByType[transfer->mFileType]--;
-            mLastTransfersCount.transfersFinishedByType[transfer->mFileType]--;
+            mLastTransfersCount.byFileType.removeFinishedTransfer(transfer->mFileType);
 
             if (transfer->isFailed() && !transfer->isSyncTransfer())
             {
@@ -892,6 +952,7 @@ TransfersModel::TransfersModel():
     QAbstractItemModel(),
     mMegaApi(MegaSyncApp->getMegaApi()),
     mPreferences(Preferences::instance()),
+    mTransfersCountVersion(0),
     mTransfersProcessChanged(0),
     mUpdateMostPriorityTransfer(0),
     mUiBlockedCounter(0),
@@ -966,6 +1027,11 @@ void TransfersModel::pauseModelProcessing(bool value)
     }
 }
 
+TransferThread* TransfersModel::getTransferEventWorker() const
+{
+    return mTransferEventWorker;
+}
+
 bool TransfersModel::areAllPaused() const
 {
     return mAreAllPaused;
@@ -2449,12 +2515,12 @@ void TransfersModel::lockModelMutex(bool lock)
 
 uint TransfersModel::getNumberOfTransfersForFileType(Utilities::FileType fileType) const
 {
-    return mTransfersCount.transfersByType.value(fileType);
+    return mTransfersCount.byFileType.getTransfers(fileType);
 }
 
 uint TransfersModel::getNumberOfFinishedForFileType(Utilities::FileType fileType) const
 {
-    return mTransfersCount.transfersFinishedByType.value(fileType);
+    return mTransfersCount.byFileType.getFinishedTransfers(fileType);
 }
 
 TransfersCount TransfersModel::getTransfersCount()
@@ -2467,10 +2533,17 @@ TransfersCount TransfersModel::getLastTransfersCount()
     return mLastTransfersCount;
 }
 
+quint64 TransfersModel::getTransfersCountVersion() const
+{
+    return mTransfersCountVersion;
+}
+
 void TransfersModel::updateTransfersCount()
-{    
-    mTransfersCount = mTransferEventWorker->getTransfersCount();
-    mLastTransfersCount = mTransferEventWorker->getLastTransfersCount();
+{
+    // The counters are only copied when they have changed since the last update
+    mTransferEventWorker->getTransfersCountIfChanged(mTransfersCountVersion,
+                                                     mTransfersCount,
+                                                     mLastTransfersCount);
 
     emit transfersCountUpdated();
 }
@@ -2968,9 +3041,13 @@ void TransfersModel::resetModel()
 
     beginResetModel();
 
-    mTransfersCount.clear();
     mActiveTransfers.clear();
     mTransferEventWorker->clear();
+    // The worker bumps its version when it clears the counters, so copying them also gives the
+    // model a new version and the views do not keep showing the old counts
+    mTransferEventWorker->getTransfersCountIfChanged(mTransfersCountVersion,
+                                                     mTransfersCount,
+                                                     mLastTransfersCount);
     mTransfersToProcess.clear();
     mTransfersProcessChanged = 0;
     mUpdateMostPriorityTransfer = 0;
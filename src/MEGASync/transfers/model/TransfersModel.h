@@ -1,9 +1,11 @@
 #ifndef TRANSFERSMODEL_H
 #define TRANSFERSMODEL_H
 
+#include "FileTypeCounters.h"
 #include "megaapi.h"
 #include "Preferences.h"
 #include "QTMegaTransferListener.h"
+#include "ThroughputEstimator.h"
 #include "TransferItem.h"
 #include "TransferMetaData.h"
 #include "TransferTrack.h"
@@ -35,8 +37,7 @@ struct TransfersCount
     long long totalUploadBytes;
     long long totalDownloadBytes;
 
-    QMap<Utilities::FileType, uint> transfersByType;
-    QMap<Utilities::FileType, uint> transfersFinishedByType;
+    FileTypeCounters byFileType;
 
     TransfersCount():
         totalUploads(0),
@@ -111,8 +112,7 @@ struct TransfersCount
         completedDownloadBytes = 0;
         totalUploadBytes = 0;
         totalDownloadBytes = 0;
-        transfersByType.clear();
-        transfersFinishedByType.clear();
+        byFileType.clear();
     }
 };
 
@@ -166,6 +166,14 @@ public:
     TransfersCount getTransfersCount();
     LastTransfersCount getLastTransfersCount();
 
+    // Increased on every change of the counters. Cheap to read from any thread, so the counters
+    // are only copied when they have changed
+    quint64 getTransfersCountVersion() const;
+    // Copies the counters if their version is not the given one, and updates it
+    bool getTransfersCountIfChanged(quint64& version,
+                                    TransfersCount& transfersCount,
+                                    LastTransfersCount& lastTransfersCount);
+
     void resetUploads(QList<QExplicitlySharedDataPointer<TransferData>> transfersToReset);
     void resetDownloads(QList<QExplicitlySharedDataPointer<TransferData>> transfersToReset);
     void resetCompletedTransfers();
@@ -199,6 +207,7 @@ private:
     void removeFinishedTracks(const QString& id);
 
     QExplicitlySharedDataPointer<TransferData> createData(mega::MegaTransfer* transfer, mega::MegaError *e);
+    void updateRemainingTime(QExplicitlySharedDataPointer<TransferData> data);
     QExplicitlySharedDataPointer<TransferData> onTransferEvent(mega::MegaTransfer* transfer, mega::MegaError *e);
     QList<QExplicitlySharedDataPointer<TransferData>>
         extractFromCache(QMap<int, QExplicitlySharedDataPointer<TransferData>>& dataMap,
@@ -233,6 +242,8 @@ private:
     QMutex mTrackTransferMutex;
     TransfersCount mTransfersCount;
     LastTransfersCount mLastTransfersCount;
+    // Written under mCountersMutex
+    std::atomic<quint64> mTransfersCountVersion;
     std::atomic<qsizetype> mMaxTransfersToProcess;
 
     QList<int> mRetriedFolder;
@@ -241,6 +252,9 @@ private:
     std::unique_ptr<mega::QTMegaTransferListener> mDelegateListener;
 
     QHash<QString, std::shared_ptr<TransferTrack>> mTrackToTransfers;
+
+    // Guarded by mCacheMutex, as the data is created under it
+    QHash<TransferTag, ThroughputEstimator> mThroughputByTag;
 };
 
 struct DownloadTransferInfo
@@ -333,12 +347,16 @@ public:
     uint  getNumberOfFinishedForFileType(Utilities::FileType fileType) const;
     TransfersCount getTransfersCount();
     TransfersCount getLastTransfersCount();
+    // Views keep the version of the counters they used, and only read them again when it changes
+    quint64 getTransfersCountVersion() const;
     uint failedTransfers();
 
     void startTransfer(QExplicitlySharedDataPointer<TransferData> transfer);
     void updateTransfer(QExplicitlySharedDataPointer<TransferData> transfer, int row);
 
     void pauseModelProcessing(bool value);
+    // Listener of the SDK transfer events, which feeds the model
+    TransferThread* getTransferEventWorker() const;
 
     bool areAllPaused() const;
 
@@ -460,6 +478,7 @@ private:
     QTimer mProcessTransfersTimer;
     TransfersCount mTransfersCount;
     LastTransfersCount mLastTransfersCount;
+    quint64 mTransfersCountVersion;
 
     QList<QExplicitlySharedDataPointer<TransferData>> mTransfers;
     QHash<int, QExplicitlySharedDataPointer<TransferData>> mFailedFoldersByTag;
@@ -1,5 +1,6 @@
 
 set(DESKTOP_APP_TRANSFERS_HEADERS
+    ${CMAKE_CURRENT_LIST_DIR}/model/FileTypeCounters.h
     ${CMAKE_CURRENT_LIST_DIR}/model/InfoDialogTransfersProxyModel.h
     ${CMAKE_CURRENT_LIST_DIR}/gui/DuplicatedNodeDialogs/DuplicatedNodeConflictAutoResolution.h
     ${CMAKE_CURRENT_LIST_DIR}/gui/DuplicatedNodeDialogs/DuplicatedNodeDialog.h
@@ -39,6 +40,7 @@ set(DESKTOP_APP_TRANSFERS_SOURCES
     ${CMAKE_CURRENT_LIST_DIR}/gui/DuplicatedNodeDialogs/DuplicatedUploadChecker.cpp
     ${CMAKE_CURRENT_LIST_DIR}/gui/InfoDialogTransferLoadingItem.cpp
     ${CMAKE_CURRENT_LIST_DIR}/gui/TransferWidgetColumnsManager.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/model/FileTypeCounters.cpp
     ${CMAKE_CURRENT_LIST_DIR}/model/InfoDialogTransfersProxyModel.cpp
     ${CMAKE_CURRENT_LIST_DIR}/model/TransfersManagerSortFilterProxyModel.cpp
     ${CMAKE_CURRENT_LIST_DIR}/model/TransferMetaData.cpp